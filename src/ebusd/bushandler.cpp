@@ -21,7 +21,9 @@
 #endif
 
 #include "ebusd/bushandler.h"
+#include <algorithm>
 #include <iomanip>
+#include "lib/utils/clock.h"
 #include "lib/utils/log.h"
 
 namespace ebusd {
@@ -62,6 +64,49 @@ bool PollRequest::notify(result_t result, const SlaveSymbolString& slave) {
 }
 
 
+result_t AsyncBusRequest::prepare(symbol_t ownMasterAddress) {
+  m_sendRetries = m_failedSendRetries;
+  if (m_message == nullptr) {
+    return RESULT_OK;  // single master part prepared during construction
+  }
+  istringstream input(m_inputStr);
+  result_t result = m_message->prepareMaster(m_index, m_srcAddress == SYN ? ownMasterAddress : m_srcAddress,
+      m_dstAddress, UI_FIELD_SEPARATOR, &input, &m_master);
+  if (result != RESULT_OK) {
+    logError(lf_bus, "prepare message part %d: %s", m_index, getResultCode(result));
+  }
+  return result;
+}
+
+bool AsyncBusRequest::notify(result_t result, const SlaveSymbolString& slave) {
+  if (result == RESULT_OK) {
+    if (m_message != nullptr) {
+      result = m_message->storeLastData(m_index, slave);
+      if (result < RESULT_OK) {
+        logError(lf_bus, "store message part %d: %s", m_index, getResultCode(result));
+      } else if (m_index+1 < m_message->getCount()) {
+        m_index++;
+        result = prepare(m_master[0]);
+        if (result == RESULT_OK) {
+          logInfo(lf_bus, "send message: %s", m_master.getStr().c_str());
+          return true;
+        }
+      }
+    }
+  } else if (m_sendRetries > 0 && result != RESULT_ERR_NO_SIGNAL && result != RESULT_ERR_SEND
+      && result != RESULT_ERR_DEVICE) {
+    m_sendRetries--;
+    logError(lf_bus, "send to %2.2x: %s, retry", m_master[1], getResultCode(result));
+    resetBusLostRetries();
+    return true;
+  } else {
+    logError(lf_bus, "send to %2.2x: %s, give up", m_master[1], getResultCode(result));
+  }
+  completed(result, slave);
+  return false;
+}
+
+
 result_t ScanRequest::prepare(symbol_t ownMasterAddress) {
   if (m_slaves.empty()) {
     return RESULT_ERR_EOF;
@@ -313,7 +358,6 @@ bool GrabbedMessage::dump(bool unknown, MessageMap* messages, bool first, Output
   return true;
 }
 
-
 void BusHandler::clear() {
   m_protocol->clear();
   m_scanResults.clear();
@@ -321,7 +365,8 @@ void BusHandler::clear() {
 }
 
 result_t BusHandler::readFromBus(Message* message, const string& inputStr, symbol_t dstAddress,
-    symbol_t srcAddress) {
+    symbol_t srcAddress, bool background) {
+  RequestClass requestClass = background ? rc_background : message->isWrite() ? rc_write : rc_read;
   symbol_t masterAddress = srcAddress == SYN ? m_protocol->getOwnMasterAddress() : srcAddress;
   result_t ret = RESULT_EMPTY;
   MasterSymbolString master;
@@ -334,7 +379,7 @@ result_t BusHandler::readFromBus(Message* message, const string& inputStr, symbo
       break;
     }
     // send message
-    ret = m_protocol->sendAndWait(master, &slave);
+    ret = m_protocol->sendAndWait(master, &slave, requestClass);
     if (ret != RESULT_OK) {
       logError(lf_bus, "send message part %d: %s", index, getResultCode(ret));
       break;
@@ -348,34 +393,61 @@ result_t BusHandler::readFromBus(Message* message, const string& inputStr, symbo
   return ret;
 }
 
+result_t BusHandler::readFromBusAsync(AsyncBusRequest* request) {
+  if (!m_protocol->hasSignal()) {
+    return RESULT_ERR_NO_SIGNAL;  // don't queue when there is no signal
+  }
+  request->m_failedSendRetries = m_protocol->getFailedSendRetries();
+  result_t ret = request->prepare(m_protocol->getOwnMasterAddress());
+  if (ret != RESULT_OK) {
+    return ret;
+  }
+  logInfo(lf_bus, "send message: %s", request->m_master.getStr().c_str());
+  return m_protocol->addRequest(request, false);
+}
+
 void BusHandler::notifyProtocolStatus(ProtocolState state, result_t result) {
   if (state == ps_empty && m_pollInterval > 0) {  // check for poll/scan
     time_t now;
     time(&now);
-    if (m_lastPoll == 0 || difftime(now, m_lastPoll) > m_pollInterval) {
-      Message* message = m_messages->getNextPoll();
-      if (message != nullptr) {
-        m_lastPoll = now;
-        if (difftime(now, message->getLastUpdateTime()) > m_pollInterval) {
-          // only poll this message if it was not updated already by other means within the interval
-          auto request = new PollRequest(message);
-          result_t ret = request->prepare(m_protocol->getOwnMasterAddress());
-          if (ret != RESULT_OK) {
-            logError(lf_bus, "prepare poll message: %s", getResultCode(ret));
-            delete request;
-          } else {
-            ret = m_protocol->addRequest(request, false);
-            if (ret != RESULT_OK) {
-              logError(lf_bus, "push poll message: %s", getResultCode(ret));
-              delete request;
-            }
-          }
+    Message* message = m_messages->getNextPoll(now, m_pollInterval, !updatePollBudget());
+    if (message != nullptr) {
+      auto request = new PollRequest(message);
+      result_t ret = request->prepare(m_protocol->getOwnMasterAddress());
+      if (ret != RESULT_OK) {
+        logError(lf_bus, "prepare poll message: %s", getResultCode(ret));
+        delete request;
+      } else {
+        ret = m_protocol->addRequest(request, false);
+        if (ret != RESULT_OK) {
+          logError(lf_bus, "push poll message: %s", getResultCode(ret));
+          delete request;
         }
       }
     }
   }
 }
 
+bool BusHandler::updatePollBudget() {
+  if (m_pollBudget == POLL_BUDGET_CYCLE) {
+    return true;
+  }
+  uint64_t now = clockGetMillis();
+  m_airtimeMutex.lock();
+  if (m_pollCreditTime == 0) {
+    m_pollCredit = POLL_BUDGET_MAX_SYMBOLS;
+  } else if (now > m_pollCreditTime) {
+    m_pollCredit += static_cast<double>(now - m_pollCreditTime) * 1000.0 / AIRTIME_SYMBOL_MICROS * m_pollBudget / 100;
+    if (m_pollCredit > POLL_BUDGET_MAX_SYMBOLS) {
+      m_pollCredit = POLL_BUDGET_MAX_SYMBOLS;
+    }
+  }
+  m_pollCreditTime = now;
+  bool available = m_pollCredit > 0;
+  m_airtimeMutex.unlock();
+  return available;
+}
+
 void BusHandler::notifyProtocolSeenAddress(symbol_t address) {
   m_seenAddresses[address] |= SEEN;
 }
@@ -432,6 +504,10 @@ void BusHandler::notifyProtocolMessage(MessageDirection direction, const MasterS
     }
   }
   Message* message = m_messages->find(command);
+  m_airtimeMutex.lock();
+  m_transferMessage = message;  // reused for accounting the airtime of this telegram
+  m_transferMessageKnown = true;
+  m_airtimeMutex.unlock();
   if (m_grabMessages) {
     uint64_t key;
     if (message) {
@@ -475,14 +551,21 @@ void BusHandler::notifyProtocolMessage(MessageDirection direction, const MasterS
       : message->getPollPriority() > 0 ? message->isWrite() ? "poll-write" : "poll-read"
       : message->isWrite() ? "write" : "read";
     result_t result = message->storeLastData(command, response);
-    ostringstream output;
+    if (result == RESULT_OK && direction != md_send) {
+      time_t now;
+      time(&now);
+      message->setLastPassiveTime(now);  // lets the poll scheduler postpone polling this message
+    }
     if (result == RESULT_OK) {
-      result = message->decodeLastData(pt_any, false, nullptr, -1, OF_NONE, &output);
+      // validate the data with the compiled decoder regardless of the log level
+      result = message->decodeLastValues(&m_updateValues);
     }
     if (result < RESULT_OK) {
       logError(lf_update, "unable to parse %s %s %s from %s / %s: %s", mode, circuit.c_str(), name.c_str(),
           command.getStr().c_str(), response.getStr().c_str(), getResultCode(result));
-    } else {
+    } else if (needsLog(lf_update, ll_notice)) {
+      ostringstream output;
+      message->decodeLastData(pt_any, false, nullptr, -1, OF_NONE, &output);
       string data = output.str();
       if (m_protocol->isOwnAddress(dstAddress)) {
         logNotice(lf_update, "%s %s self-update %s %s QQ=%2.2x: %s", prefix, mode, circuit.c_str(), name.c_str(),
@@ -505,6 +588,51 @@ void BusHandler::notifyProtocolMessage(MessageDirection direction, const MasterS
   }
 }
 
+void BusHandler::notifyProtocolTransfer(const MasterSymbolString& master, unsigned int symbols, result_t result) {
+  bool complete = master.size() >= 5 && master.size() >= 5 + master.getDataSize();
+  m_airtimeMutex.lock();
+  const Message* message = nullptr;
+  if (complete) {
+    // a completed telegram was resolved already by notifyProtocolMessage(), so only failed ones need the lookup
+    message = result == RESULT_OK && m_transferMessageKnown ? m_transferMessage : m_messages->find(master);
+  }
+  m_transferMessageKnown = false;
+  m_pollCredit -= symbols;  // any traffic reduces the bus airtime left for polling
+  if (m_pollCredit < -POLL_BUDGET_MAX_SYMBOLS) {
+    m_pollCredit = -POLL_BUDGET_MAX_SYMBOLS;  // resume polling soon after a long burst of traffic
+  }
+  m_airtimeTotal.add(symbols, result);
+  if (master.size() >= 1) {
+    m_airtimeBySource[master[0]].add(symbols, result);
+  }
+  if (master.size() >= 2) {
+    m_airtimeByDestination[master[1]].add(symbols, result);
+  }
+  if (complete) {
+    size_t idLen = master[1] == BROADCAST ? 1 : 4;  // up to 4 DD bytes (1 for broadcast)
+    uint64_t key = message ? message->getKey() : Message::createKey(master, idLen);
+    auto it = m_airtimeByMessage.find(key);
+    if (it == m_airtimeByMessage.end() && m_airtimeByMessage.size() < AIRTIME_MAX_MESSAGES) {
+      string name;
+      if (message) {
+        name = message->getCircuit();
+        if (!message->getName().empty()) {
+          name += " " + message->getName();
+        }
+      } else {
+        name = master.getStr(0, 4 + idLen, false);
+      }
+      it = m_airtimeByMessage.emplace(key, std::make_pair(name, AirtimeCounter())).first;
+    }
+    if (it == m_airtimeByMessage.end()) {
+      m_airtimeOtherMessages.add(symbols, result);
+    } else {
+      it->second.second.add(symbols, result);
+    }
+  }
+  m_airtimeMutex.unlock();
+}
+
 result_t BusHandler::prepareScan(symbol_t slave, bool full, const string& levels, bool* reload,
     ScanRequest** request) {
   Message* scanMessage = m_messages->getScanMessage();
@@ -897,6 +1025,98 @@ void BusHandler::formatGrabResult(bool unknown, OutputFormat outputFormat, ostri
   }
 }
 
+void BusHandler::formatAirtime(bool json, bool reset, ostringstream* output) {
+  m_airtimeMutex.lock();
+  uint64_t total = m_airtimeTotal.getSymbols();
+  vector<const std::pair<string, AirtimeCounter>*> messages;
+  messages.reserve(m_airtimeByMessage.size());
+  for (const auto& it : m_airtimeByMessage) {
+    messages.push_back(&it.second);
+  }
+  std::stable_sort(messages.begin(), messages.end(),
+    [](const std::pair<string, AirtimeCounter>* a, const std::pair<string, AirtimeCounter>* b) {
+      return a->second.getSymbols() > b->second.getSymbols();
+    });
+  if (json) {
+    *output << "{\"since\":" << m_airtimeSince << ",\"total\":";
+    m_airtimeTotal.dump(total, true, output);
+    for (int dst = 0; dst < 2; dst++) {
+      const AirtimeCounter* counters = dst ? m_airtimeByDestination : m_airtimeBySource;
+      *output << (dst ? ",\"destination\":{" : ",\"source\":{");
+      bool first = true;
+      for (unsigned int address = 0; address < 256; address++) {
+        if (counters[address].isEmpty()) {
+          continue;
+        }
+        if (!first) {
+          *output << ",";
+        }
+        first = false;
+        *output << "\"" << setfill('0') << setw(2) << hex << address << dec << setw(0) << "\":";
+        counters[address].dump(total, true, output);
+      }
+      *output << "}";
+    }
+    *output << ",\"messages\":[";
+    bool first = true;
+    for (const auto entry : messages) {
+      if (!first) {
+        *output << ",";
+      }
+      first = false;
+      *output << "{\"name\":\"";
+      for (const auto ch : entry->first) {
+        if (ch == '"' || ch == '\\') {
+          *output << '\\';  // escape
+        }
+        *output << ch;
+      }
+      *output << "\",\"airtime\":";
+      entry->second.dump(total, true, output);
+      *output << "}";
+    }
+    *output << "]";
+    if (!m_airtimeOtherMessages.isEmpty()) {
+      *output << ",\"other\":";
+      m_airtimeOtherMessages.dump(total, true, output);
+    }
+    *output << "}";
+  } else {
+    *output << "since: " << (time(nullptr) - m_airtimeSince) << " s\ntotal: ";
+    m_airtimeTotal.dump(total, false, output);
+    for (int dst = 0; dst < 2; dst++) {
+      const AirtimeCounter* counters = dst ? m_airtimeByDestination : m_airtimeBySource;
+      for (unsigned int address = 0; address < 256; address++) {
+        if (counters[address].isEmpty()) {
+          continue;
+        }
+        *output << (dst ? "\ndestination " : "\nsource ") << setfill('0') << setw(2) << hex << address << dec
+                << setw(0) << ": ";
+        counters[address].dump(total, false, output);
+      }
+    }
+    for (const auto entry : messages) {
+      *output << "\nmessage " << entry->first << ": ";
+      entry->second.dump(total, false, output);
+    }
+    if (!m_airtimeOtherMessages.isEmpty()) {
+      *output << "\nother messages: ";
+      m_airtimeOtherMessages.dump(total, false, output);
+    }
+  }
+  if (reset) {
+    time(&m_airtimeSince);
+    m_airtimeTotal.reset();
+    for (unsigned int address = 0; address < 256; address++) {
+      m_airtimeBySource[address].reset();
+      m_airtimeByDestination[address].reset();
+    }
+    m_airtimeByMessage.clear();
+    m_airtimeOtherMessages.reset();
+  }
+  m_airtimeMutex.unlock();
+}
+
 symbol_t BusHandler::getNextScanAddress(symbol_t lastAddress, bool withUnfinished) const {
   if (lastAddress == SYN) {
     return SYN;
@@ -69,7 +69,7 @@ class PollRequest : public BusRequest {
    * @param message the associated @a Message.
    */
   explicit PollRequest(Message* message)
-    : BusRequest(m_master, true), m_message(message), m_index(0) {}
+    : BusRequest(m_master, true, rc_poll), m_message(message), m_index(0) {}
 
   /**
    * Destructor.
@@ -117,7 +117,7 @@ class ScanRequest : public BusRequest {
    */
   ScanRequest(bool deleteOnFinish, MessageMap* messageMap, const deque<Message*>& messages,
       const deque<symbol_t>& slaves, BusHandler* busHandler, size_t notifyIndex = 0)
-    : BusRequest(m_master, deleteOnFinish), m_messageMap(messageMap), m_index(0), m_allMessages(messages),
+    : BusRequest(m_master, deleteOnFinish, rc_scan), m_messageMap(messageMap), m_index(0), m_allMessages(messages),
       m_messages(messages), m_slaves(slaves), m_busHandler(busHandler), m_notifyIndex(notifyIndex),
       m_result(RESULT_ERR_NO_SIGNAL) {
     m_message = m_messages.front();
@@ -173,6 +173,90 @@ class ScanRequest : public BusRequest {
 };
 
 
+/**
+ * An abstract @a BusRequest for sending a @a Message (or a single prepared master part) without waiting for the
+ * answer. Failed sends are repeated the same way as in @a ProtocolHandler::sendAndWait() and the final result is
+ * passed to @a completed() from within the @a ProtocolHandler thread.
+ */
+class AsyncBusRequest : public BusRequest {
+  friend class BusHandler;
+
+ public:
+  /**
+   * Constructor for sending all parts of a @a Message.
+   * @param message the associated @a Message.
+   * @param inputStr the input @a string from which to read master values (if any).
+   * @param dstAddress the destination address to set, or @a SYN to keep the address defined during construction.
+   * @param srcAddress the source address to set, or @a SYN for the own master address.
+   */
+  AsyncBusRequest(Message* message, const string& inputStr, symbol_t dstAddress, symbol_t srcAddress)
+    : BusRequest(m_master, true, message->isWrite() ? rc_write : rc_read), m_message(message), m_inputStr(inputStr),
+      m_dstAddress(dstAddress), m_srcAddress(srcAddress), m_index(0), m_failedSendRetries(0), m_sendRetries(0) {}
+
+  /**
+   * Constructor for sending a single prepared master part.
+   * @param master the master data @a MasterSymbolString to send.
+   * @param requestClass the @a RequestClass for scheduling.
+   */
+  AsyncBusRequest(const MasterSymbolString& master, RequestClass requestClass)
+    : BusRequest(m_master, true, requestClass), m_master(master), m_message(nullptr), m_dstAddress(SYN),
+      m_srcAddress(SYN), m_index(0), m_failedSendRetries(0), m_sendRetries(0) {}
+
+  /**
+   * Destructor.
+   */
+  virtual ~AsyncBusRequest() {}
+
+  /**
+   * Prepare the master data of the current part.
+   * @param ownMasterAddress the own master bus address.
+   * @return the result code.
+   */
+  result_t prepare(symbol_t ownMasterAddress);
+
+  // @copydoc
+  bool notify(result_t result, const SlaveSymbolString& slave) override;
+
+  /**
+   * Called once when the request was finished (either successfully with all parts or with an error).
+   * @param result the result code.
+   * @param slave the @a SlaveSymbolString received for the last part.
+   */
+  virtual void completed(result_t result, const SlaveSymbolString& slave) = 0;  // abstract
+
+  /**
+   * @return the associated @a Message, or nullptr when sending a single prepared master part.
+   */
+  Message* getMessage() const { return m_message; }
+
+
+ protected:
+  /** the master data @a MasterSymbolString. */
+  MasterSymbolString m_master;
+
+  /** the associated @a Message, or nullptr. */
+  Message* m_message;
+
+  /** the input @a string from which to read master values. */
+  const string m_inputStr;
+
+  /** the destination address to set, or @a SYN. */
+  const symbol_t m_dstAddress;
+
+  /** the source address to set, or @a SYN. */
+  const symbol_t m_srcAddress;
+
+  /** the current part index in @a m_message. */
+  size_t m_index;
+
+  /** the number of times a failed send of each part is repeated. */
+  unsigned int m_failedSendRetries;
+
+  /** the remaining number of repetitions of a failed send of the current part. */
+  unsigned int m_sendRetries;
+};
+
+
 /**
  * Helper class for keeping track of grabbed messages.
  */
@@ -246,6 +330,15 @@ class GrabbedMessage {
 };
 
 
+/** the maximum number of messages to account the bus airtime for separately (the rest is summed up as other). */
+#define AIRTIME_MAX_MESSAGES 256
+
+/** the maximum number of symbols the poll budget may accumulate while the bus is idle (and lose while busy). */
+#define POLL_BUDGET_MAX_SYMBOLS 64
+
+/** the poll budget for cycling through the poll messages at one poll per poll interval (the default). */
+#define POLL_BUDGET_CYCLE 0
+
 /**
  * Handles input from and output to the bus with respect to the eBUS protocol.
  */
@@ -255,14 +348,18 @@ class BusHandler : public ProtocolListener {
    * Construct a new instance.
    * @param messages the @a MessageMap instance with all known @a Message instances.
    * @param scanHelper the @a ScanHelper instance.
-   * @param pollInterval the interval in seconds in which poll messages are cycled, or 0 if disabled.
+   * @param pollInterval the poll interval (or period for poll priority 1) in seconds, or 0 if polling is disabled.
+   * @param pollBudget the maximum percentage of the bus airtime to fill with polls, or @a POLL_BUDGET_CYCLE for not
+   * limiting the polls by the bus airtime.
    */
   BusHandler(MessageMap* messages, ScanHelper* scanHelper,
-      unsigned int pollInterval)
+      unsigned int pollInterval, unsigned int pollBudget = POLL_BUDGET_CYCLE)
     : m_protocol(nullptr), m_messages(messages), m_scanHelper(scanHelper),
-      m_pollInterval(pollInterval), m_lastPoll(0), m_runningScans(0),
-      m_grabMessages(true) {
+      m_pollInterval(pollInterval), m_pollBudget(pollBudget), m_pollCredit(0), m_pollCreditTime(0),
+      m_runningScans(0),
+      m_grabMessages(true), m_transferMessage(nullptr), m_transferMessageKnown(false) {
     memset(m_seenAddresses, 0, sizeof(m_seenAddresses));
+    time(&m_airtimeSince);
   }
 
   /**
@@ -293,10 +390,20 @@ class BusHandler : public ProtocolListener {
    * @param inputStr the input @a string from which to read master values (if any).
    * @param dstAddress the destination address to set, or @a SYN to keep the address defined during construction.
    * @param srcAddress the source address to set, or @a SYN for the own master address.
+   * @param background true for a request not initiated by a user or client (scheduled with lowest priority).
    * @return the result code.
    */
   result_t readFromBus(Message* message, const string& inputStr, symbol_t dstAddress = SYN,
-      symbol_t srcAddress = SYN);
+      symbol_t srcAddress = SYN, bool background = false);
+
+  /**
+   * Prepare the first master part of the @a AsyncBusRequest and hand it over to the bus without waiting for the
+   * answer.
+   * @param request the @a AsyncBusRequest to send (owned by the protocol when successful, otherwise still owned by
+   * the caller).
+   * @return the result code.
+   */
+  result_t readFromBusAsync(AsyncBusRequest* request);
 
   /**
    * Initiate a scan of the slave addresses.
@@ -386,6 +493,14 @@ class BusHandler : public ProtocolListener {
   void formatGrabResult(bool unknown, OutputFormat outputFormat, ostringstream* output, bool isDirectMode = false,
       time_t since = 0, time_t until = 0) const;
 
+  /**
+   * Format the bus airtime accounted by source address, destination address, and message to the @a ostringstream.
+   * @param json true for JSON format, false for text.
+   * @param reset whether to reset all counters afterwards.
+   * @param output the @a ostringstream to format the airtime to.
+   */
+  void formatAirtime(bool json, bool reset, ostringstream* output);
+
   /**
    * Get the next slave address that still needs to be scanned or loaded.
    * @param lastAddress the last returned slave address, or 0 for returning the first one.
@@ -411,6 +526,9 @@ class BusHandler : public ProtocolListener {
   void notifyProtocolMessage(MessageDirection direction, const MasterSymbolString& master,
       const SlaveSymbolString& slave) override;
 
+  // @copydoc
+  void notifyProtocolTransfer(const MasterSymbolString& master, unsigned int symbols, result_t result) override;
+
  private:
   /**
    * Prepare a @a ScanRequest.
@@ -423,6 +541,12 @@ class BusHandler : public ProtocolListener {
    */
   result_t prepareScan(symbol_t slave, bool full, const string& levels, bool* reload, ScanRequest** request);
 
+  /**
+   * Update the poll budget by the time passed since the last call.
+   * @return whether the poll budget is available.
+   */
+  bool updatePollBudget();
+
   /** the @a ProtocolHandler instance for accessing the bus (loosely coupled but set quickly after construction). */
   ProtocolHandler* m_protocol;
 
@@ -432,11 +556,17 @@ class BusHandler : public ProtocolListener {
   /** the @a ScanHelper instance. */
   ScanHelper* m_scanHelper;
 
-  /** the interval in seconds in which poll messages are cycled, or 0 if disabled. */
+  /** the poll interval (or period for poll priority 1) in seconds, or 0 if polling is disabled. */
   const unsigned int m_pollInterval;
 
-  /** the time of the last poll, or 0 for never. */
-  time_t m_lastPoll;
+  /** the maximum percentage of the bus airtime to fill with polls, or @a POLL_BUDGET_CYCLE for unlimited. */
+  const unsigned int m_pollBudget;
+
+  /** the number of symbols left for polling (reduced by all bus traffic, guarded by @a m_airtimeMutex). */
+  double m_pollCredit;
+
+  /** the system time in milliseconds of the last update of @a m_pollCredit, or 0 for never. */
+  uint64_t m_pollCreditTime;
 
   /** the number of scan requests currently running. */
   unsigned int m_runningScans;
@@ -452,6 +582,36 @@ class BusHandler : public ProtocolListener {
 
   /** the grabbed messages by key.*/
   map<uint64_t, GrabbedMessage> m_grabbedMessages;
+
+  /** the reusable typed values for validating updated messages (only used by the protocol thread). */
+  DataValueList m_updateValues;
+
+  /** the @a Mutex for the airtime members. */
+  Mutex m_airtimeMutex;
+
+  /** the time the airtime accounting was started or reset. */
+  time_t m_airtimeSince;
+
+  /** the total bus airtime. */
+  AirtimeCounter m_airtimeTotal;
+
+  /** the bus airtime by source address. */
+  AirtimeCounter m_airtimeBySource[256];
+
+  /** the bus airtime by destination address. */
+  AirtimeCounter m_airtimeByDestination[256];
+
+  /** the bus airtime and name by message key (limited to @a AIRTIME_MAX_MESSAGES entries). */
+  map<uint64_t, std::pair<string, AirtimeCounter>> m_airtimeByMessage;
+
+  /** the bus airtime of messages not fitting into @a m_airtimeByMessage. */
+  AirtimeCounter m_airtimeOtherMessages;
+
+  /** the @a Message found for the last completed telegram (or nullptr if unknown). */
+  const Message* m_transferMessage;
+
+  /** whether @a m_transferMessage was set for the next transfer to account. */
+  bool m_transferMessageKnown;
 };
 
 }  // namespace ebusd
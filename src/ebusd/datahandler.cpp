@@ -84,4 +84,11 @@ void DataSink::notifyUpdate(Message* message, bool changed) {
   }
 }
 
+void DataSink::notifyAvailability(Message* message) {
+  // publish the last data of a newly available message as it might have been suppressed before
+  if (message && message->isAvailable() && message->getLastUpdateTime() > 0 && message->hasLevel(m_levels)) {
+    m_updatedMessages[message->getKey()]++;
+  }
+}
+
 }  // namespace ebusd
@@ -164,6 +164,12 @@ class DataSink : virtual public DataHandler {
    */
   virtual void notifyUpdate(Message* message, bool changed);
 
+  /**
+   * Notify the sink of a conditional @a Message that became available or unavailable.
+   * @param message the @a Message (check @a Message::isAvailable() for the current state).
+   */
+  virtual void notifyAvailability(Message* message);
+
   /**
    * Notify the sink of the latest update check result.
    * @param checkResult a string describing available updates, or empty if no update is available.
@@ -165,7 +165,8 @@ bool knxhandler_register(UserInfo* userInfo, BusHandler* busHandler, MessageMap*
 KnxHandler::KnxHandler(UserInfo* userInfo, BusHandler* busHandler, MessageMap* messages)
   : DataSink(userInfo, "knx", true), DataSource(busHandler), WaitThread(), m_messages(messages),
     m_start(0), m_lastUpdateCheckResult("."),
-    m_lastScanStatus(SCAN_STATUS_NONE), m_scanFinishReceived(false), m_lastErrorLogTime(0) {
+    m_lastScanStatus(SCAN_STATUS_NONE), m_scanFinishReceived(false), m_availabilityChanged(false),
+    m_lastErrorLogTime(0) {
   m_con = KnxConnection::create(g_url);
   if (g_integrationFile != nullptr) {
     if (!m_replacers.parseFile(g_integrationFile)) {
@@ -279,6 +280,11 @@ void KnxHandler::notifyScanStatus(scanStatus_t scanStatus) {
   }
 }
 
+void KnxHandler::notifyAvailability(Message* message) {
+  m_availabilityChanged = true;  // subscribe newly available messages soon
+  DataSink::notifyAvailability(message);
+}
+
 result_t getFieldLength(const SingleDataField *field, dtlf_t *length) {
   const auto dt = field->getDataType();
   if (field->isIgnored() || !dt->isNumeric() || dt->isAdjustableLength()) {
@@ -322,10 +328,6 @@ const SingleDataField *field) const {
   if (!m_con || !m_con->isConnected() || !m_con->getAddress()) {
     return RESULT_EMPTY;
   }
-  uint8_t data[] = {0, 0, 0, 0, 0, 0};
-  data[0] = static_cast<uint8_t>(apci>>8);
-  data[1] = static_cast<uint8_t>(apci&0xff);
-  int len = 2;
   // convert value to dpt
   if (lengthFlag.isFloat || lengthFlag.hasDivisor) {
     if (!field) {
@@ -355,6 +357,73 @@ const SingleDataField *field) const {
     }
   }
   // else signed values: fine as long as length is identical
+  return sendGroupData(dest, apci, lengthFlag, value);
+}
+
+result_t KnxHandler::sendGroupValue(knx_addr_t dest, apci_t apci, dtlf_t& lengthFlag,
+const field_value_t& value) const {
+  if (!m_con || !m_con->isConnected() || !m_con->getAddress()) {
+    return RESULT_EMPTY;
+  }
+  const data_value_t& val = value.value;
+  unsigned int dptValue;
+  // convert value to dpt
+  if (lengthFlag.isFloat || lengthFlag.hasDivisor) {
+    if (val.type == dvt_null) {
+      // replacement value:
+      if (lengthFlag.length != 2) {
+        return RESULT_ERR_INVALID_NUM;  // not encodable
+      }
+      // shall have 0x7fff for DPT 9
+      dptValue = 0x7fff;
+    } else if (val.type != dvt_integer && val.type != dvt_number) {
+      return RESULT_ERR_INVALID_NUM;
+    } else if (lengthFlag.length == 2) {
+      // convert to (0.01*m)(2^e) format with sign, 12 bits mantissa (incl. sign), 4 bits exponent
+      dptValue = floatToUint16(static_cast<float>(val.number));
+    } else if (lengthFlag.length == 4) {
+      // convert to IEEE 754
+      dptValue = floatToUint(static_cast<float>(val.number));
+    } else {
+      return RESULT_ERR_INVALID_NUM;  // not encodable
+    }
+  } else if (val.type == dvt_integer || val.type == dvt_list) {
+    // signed values: fine as long as length is identical
+    dptValue = static_cast<unsigned int>(val.integer);
+  } else if (val.type == dvt_null && value.field) {
+    auto nt = dynamic_cast<const NumberDataType*>(value.field->getDataType());
+    if (!nt) {
+      return RESULT_ERR_INVALID_NUM;
+    }
+    dptValue = nt->getReplacement();
+  } else {
+    return RESULT_ERR_INVALID_NUM;
+  }
+  return sendGroupData(dest, apci, lengthFlag, dptValue);
+}
+
+const field_value_t* KnxHandler::getDecodedValue(const Message* message, const SingleDataField* field,
+bool* decoded) {
+  if (!*decoded) {
+    *decoded = true;
+    if (message->decodeLastValues(&m_decodedValues) != RESULT_OK) {
+      m_decodedValues.clear();
+      return nullptr;
+    }
+  }
+  for (size_t i = 0; i < m_decodedValues.size(); i++) {
+    if (m_decodedValues[i].field == field) {
+      return &m_decodedValues[i];
+    }
+  }
+  return nullptr;
+}
+
+result_t KnxHandler::sendGroupData(knx_addr_t dest, apci_t apci, dtlf_t& lengthFlag, unsigned int value) const {
+  uint8_t data[] = {0, 0, 0, 0, 0, 0};
+  data[0] = static_cast<uint8_t>(apci>>8);
+  data[1] = static_cast<uint8_t>(apci&0xff);
+  int len = 2;
   if (apci == APCI_GROUPVALUE_WRITE && lengthFlag.lastValueSent && lengthFlag.lastValue == value) {
     return RESULT_EMPTY;  // no need to send the same group value again
   }
@@ -695,11 +764,12 @@ void KnxHandler::handleGroupTelegram(knx_addr_t src, knx_addr_t dest, int len, c
       return;
     }
   }
-  unsigned int value = 0;
-  res = msg->decodeLastDataNumField(nullptr, fieldIndex, &value);
-  if (res == RESULT_OK) {
+  bool decoded = false;
+  const field_value_t* value = getDecodedValue(msg, field, &decoded);
+  res = value ? RESULT_OK : RESULT_EMPTY;
+  if (value) {
     logOtherDebug("knx", "read %s %s", circuit.c_str(), name.c_str());
-    res = sendGroupValue(dest, APCI_GROUPVALUE_RESPONSE, sit->second.lengthFlag, value, field);
+    res = sendGroupValue(dest, APCI_GROUPVALUE_RESPONSE, sit->second.lengthFlag, *value);
   } else {
     logOtherError("knx", "read %s %s: %s", circuit.c_str(), name.c_str(), getResultCode(res));
   }
@@ -746,8 +816,9 @@ void KnxHandler::run() {
         lastSignal -= lastTaskRun-now;
       }
       lastTaskRun = now;
-    } else if (now > lastTaskRun+(m_scanFinishReceived ? 1 : 15)) {
+    } else if (now > lastTaskRun+(m_scanFinishReceived || m_availabilityChanged ? 1 : 15)) {
       m_scanFinishReceived = false;
+      m_availabilityChanged = false;
       if (m_con->isConnected()) {
         sendSignal = true;
         if (now > lastUptime + UPTIME_INTERVAL) {
@@ -916,6 +987,7 @@ void KnxHandler::run() {
             if (mit == m_subscribedMessages.cend()) {
               continue;
             }
+            bool decoded = false;
             for (auto destFlags : mit->second) {
               auto sit = m_subscribedGroups.find(destFlags);
               if (sit == m_subscribedGroups.end()) {
@@ -927,9 +999,10 @@ void KnxHandler::run() {
                 continue;
               }
               knx_addr_t dest = destFlags&0xffff;
-              unsigned int value = 0;
-              result = message->decodeLastDataNumField(nullptr, index, &value);
-              sendGroupValue(dest, APCI_GROUPVALUE_WRITE, sit->second.lengthFlag, value, field);
+              const field_value_t* value = getDecodedValue(message, field, &decoded);
+              if (value) {
+                sendGroupValue(dest, APCI_GROUPVALUE_WRITE, sit->second.lengthFlag, *value);
+              }
             }
           }
           it = m_updatedMessages.erase(it);
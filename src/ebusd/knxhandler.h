@@ -144,6 +144,9 @@ class KnxHandler : public DataSink, public DataSource, public WaitThread {
   // @copydoc
   void notifyScanStatus(scanStatus_t scanStatus) override;
 
+  // @copydoc
+  void notifyAvailability(Message* message) override;
+
   /**
    * Send a group value.
    * @param dest the destination group address.
@@ -156,6 +159,35 @@ class KnxHandler : public DataSink, public DataSource, public WaitThread {
   result_t sendGroupValue(knx_addr_t dest, apci_t apci, dtlf_t& lengthFlag, unsigned int value,
   const SingleDataField *field = nullptr) const;
 
+  /**
+   * Send a typed field value as group value.
+   * @param dest the destination group address.
+   * @param apci the APCI value.
+   * @param lengthFlag the datatype length flag.
+   * @param value the typed value decoded from the field.
+   * @return the result code.
+   */
+  result_t sendGroupValue(knx_addr_t dest, apci_t apci, dtlf_t& lengthFlag, const field_value_t& value) const;
+
+  /**
+   * Send the group value already converted to the datatype.
+   * @param dest the destination group address.
+   * @param apci the APCI value.
+   * @param lengthFlag the datatype length flag.
+   * @param value the value in datatype format.
+   * @return the result code.
+   */
+  result_t sendGroupData(knx_addr_t dest, apci_t apci, dtlf_t& lengthFlag, unsigned int value) const;
+
+  /**
+   * Decode the typed values of the last data of a @a Message into @a m_decodedValues and find the one of a field.
+   * @param message the @a Message to decode.
+   * @param field the @a SingleDataField to find.
+   * @param decoded whether @a m_decodedValues already contains the values of the @a Message (updated on return).
+   * @return the typed value of the field, or nullptr if not available.
+   */
+  const field_value_t* getDecodedValue(const Message* message, const SingleDataField* field, bool* decoded);
+
   /**
    * Send a global value to the registered group address.
    * @param index the global value index to send.
@@ -276,8 +308,14 @@ class KnxHandler : public DataSink, public DataSource, public WaitThread {
   /** set to true when a scan finish was received. */
   bool m_scanFinishReceived;
 
+  /** set to true when the availability of a conditional message changed. */
+  bool m_availabilityChanged;
+
   /** the last system time when a communication error was logged. */
   time_t m_lastErrorLogTime;
+
+  /** the reusable typed values of the last decoded @a Message (only used by the handler thread). */
+  DataValueList m_decodedValues;
 };
 
 }  // namespace ebusd
@@ -45,6 +45,9 @@ using std::cout;
 /** the previous config path suffixes to rewrite to the current one. */
 #define PREVIOUS_CONFIG_PATH_SUFFIXES {"ebusd.eu/config/", "cfg.ebusd.eu/"}
 
+/** the maximum number of client requests waiting for the main loop (further clients wait for a free slot). */
+#define REQUEST_QUEUE_CAPACITY 64
+
 /** the opened PID file, or nullptr. */
 static FILE* s_pidFile = nullptr;
 
@@ -64,7 +67,7 @@ static ProtocolHandler* s_protocol = nullptr;
 static BusHandler* s_busHandler = nullptr;
 
 /** the @a Request @a Queue instance, or nullptr. */
-static Queue<Request*>* s_requestQueue = nullptr;
+static RingQueue<Request*>* s_requestQueue = nullptr;
 
 /** the @a MainLoop instance, or nullptr. */
 static MainLoop* s_mainLoop = nullptr;
@@ -335,6 +338,7 @@ int main(int argc, char* argv[], char* envp[]) {
   }
 
   s_messageMap = new MessageMap(s_opt.checkConfig, lang);
+  s_messageMap->setPollByPeriod(s_opt.pollBudget != POLL_BUDGET_CYCLE);
   s_scanHelper = new ScanHelper(s_messageMap, configPath, configLocalPrefix, configUriPrefix,
     configLangQuery, configHttpClient, s_opt.checkConfig);
   s_messageMap->setResolver(s_scanHelper);
@@ -463,7 +467,7 @@ int main(int argc, char* argv[], char* envp[]) {
     logWrite(lf_main, ll_notice, "using discovered device with ID %s and device string %s", address.id, device);
   }
 
-  s_busHandler = new BusHandler(s_messageMap, s_scanHelper, s_opt.pollInterval);
+  s_busHandler = new BusHandler(s_messageMap, s_scanHelper, s_opt.pollInterval, s_opt.pollBudget);
 
   // create the protocol and open the device
   ebus_protocol_config_t config = {
@@ -530,7 +534,7 @@ int main(int argc, char* argv[], char* envp[]) {
   s_protocol->open();
 
   // create the MainLoop
-  s_requestQueue = new Queue<Request*>();
+  s_requestQueue = new RingQueue<Request*>(REQUEST_QUEUE_CAPACITY);
   s_mainLoop = new MainLoop(s_opt, s_busHandler, s_messageMap, s_scanHelper, s_requestQueue);
 
   ostringstream ostream;
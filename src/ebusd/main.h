@@ -63,6 +63,7 @@ typedef struct options {
   OutputFormat dumpConfig;  //!< dump config files, then stop
   const char* dumpConfigTo;  //!< file to dump config to
   unsigned int pollInterval;  //!< poll interval in seconds, 0 to disable [5]
+  unsigned int pollBudget;  //!< maximum percentage of the bus airtime to fill with polls, 0 to cycle [0]
   bool injectCommands;  //!< inject remaining arguments as commands or already seen messages
   bool stopAfterInject;  //!< only inject arguments once, then stop
   int injectCount;  //!< number of arguments to inject, or 0
@@ -84,6 +85,7 @@ typedef struct options {
   bool foreground;  //!< run in foreground
   bool enableHex;  //!< enable hex/inject/answer commands
   bool enableDefine;  //!< enable define command
+  bool asyncRequests;  //!< answer other requests while bus bound commands are executed
   const char* pidFile;  //!< PID file name [/var/run/ebusd.pid]
   uint16_t port;  //!< port to listen for command line connections [8888]
   bool localOnly;  //!< listen on 127.0.0.1 interface only
@@ -47,6 +47,7 @@ static const options_t s_default_opt = {
   .dumpConfig = OF_NONE,
   .dumpConfigTo = nullptr,
   .pollInterval = 5,
+  .pollBudget = POLL_BUDGET_CYCLE,
   .injectCommands = false,
   .stopAfterInject = false,
   .injectCount = 0,
@@ -68,6 +69,7 @@ static const options_t s_default_opt = {
   .foreground = false,
   .enableHex = false,
   .enableDefine = false,
+  .asyncRequests = false,
   .pidFile = PACKAGE_PIDFILE,
   .port = 8888,
   .localOnly = false,
@@ -101,7 +103,8 @@ static string s_configPath = CONFIG_PATH;
 #define O_DMPCFG (O_CHKCFG-1)
 #define O_DMPCTO (O_DMPCFG-1)
 #define O_POLINT (O_DMPCTO-1)
-#define O_CAFILE (O_POLINT-1)
+#define O_POLBUD (O_POLINT-1)
+#define O_CAFILE (O_POLBUD-1)
 #define O_CAPATH (O_CAFILE-1)
 #define O_ANSWER (O_CAPATH-1)
 #define O_ACQTIM (O_ANSWER-1)
@@ -114,7 +117,8 @@ static string s_configPath = CONFIG_PATH;
 #define O_ACLFIL (O_ACLDEF-1)
 #define O_HEXCMD (O_ACLFIL-1)
 #define O_DEFCMD (O_HEXCMD-1)
-#define O_PIDFIL (O_DEFCMD-1)
+#define O_ASYNRQ (O_DEFCMD-1)
+#define O_PIDFIL (O_ASYNRQ-1)
 #define O_LOCAL  (O_PIDFIL-1)
 #define O_HTTPPT (O_LOCAL-1)
 #define O_HTMLPA (O_HTTPPT-1)
@@ -143,7 +147,10 @@ static const argDef argDefs[] = {
       "- prefix \"enh:\" for enhanced device, or\n"
       "- no prefix for plain device, and\n"
       "- suffix \"IP[:PORT]\" for network device, or\n"
-      "- suffix \"DEVICE\" for serial device"},
+      "- suffix \"DEVICE\" for serial device, or\n"
+      "- \"replay[@SPEED]:PATH\" for read only replay of a dump file at nominal bus speed times SPEED (0 for"
+      " maximum speed), or\n"
+      "- \"sim:PATH\" for a simulated bus with virtual masters and slaves defined in the profile file PATH"},
   {"nodevicecheck",  'n',      nullptr,    0, "Skip serial eBUS device test"},
   {"readonly",       'r',      nullptr,    0, "Only read from device, never write to it"},
   {"initsend",       O_INISND, nullptr,    0, "Send an initial escape symbol after connecting device"},
@@ -168,6 +175,8 @@ static const argDef argDefs[] = {
       "Check and dump config files in FORMAT (\"json\", \"csv\", or \"csvall\" for CSV with all attributes), then stop"},
   {"dumpconfigto",   O_DMPCTO, "FILE",     0, "Dump config files to FILE"},
   {"pollinterval",   O_POLINT, "SEC",      0, "Poll for data every SEC seconds (0=disable) [5]"},
+  {"pollbudget",     O_POLBUD, "PERCENT",  0, "Poll messages with priority N every N*SEC seconds instead, but only "
+      "while the bus traffic is below PERCENT of the airtime"},
   {"inject",         'i',      "stop", af_optional|ARG_NO_ENV, "Inject remaining arguments as commands or already seen messages "
       "(e.g. \"FF08070400/0AB5454850303003277201\"), optionally stop afterwards"},
   {nullptr,          O_INJPOS, "INJECT", af_optional|af_multiple, "Commands and/or messages to inject "
@@ -194,6 +203,7 @@ static const argDef argDefs[] = {
   {"foreground",     'f',      nullptr,    0, "Run in foreground"},
   {"enablehex",      O_HEXCMD, nullptr,    0, "Enable hex/inject/answer commands"},
   {"enabledefine",   O_DEFCMD, nullptr,    0, "Enable define command"},
+  {"asyncrequests",  O_ASYNRQ, nullptr,    0, "Answer other requests while read/write/hex commands wait for the bus"},
   {"pidfile",        O_PIDFIL, "FILE",     0, "PID file name (only for daemon) [" PACKAGE_PIDFILE "]"},
   {"port",           'p',      "PORT",     0, "Listen for command line connections on PORT [8888]"},
   {"localhost",      O_LOCAL,  nullptr,    0, "Listen for command line connections on 127.0.0.1 interface only"},
@@ -244,6 +254,9 @@ static int parse_opt(int key, char *arg, const argParseOpt *parseOpt, struct opt
       return EINVAL;
     }
     opt->device = arg;
+    if (strncmp(arg, "replay", 6) == 0 && (arg[6] == ':' || arg[6] == '@')) {
+      opt->readOnly = true;
+    }
     break;
   case 'n':  // --nodevicecheck
     opt->noDeviceCheck = true;
@@ -343,6 +356,14 @@ static int parse_opt(int key, char *arg, const argParseOpt *parseOpt, struct opt
     }
     opt->pollInterval = value;
     break;
+  case O_POLBUD:  // --pollbudget=50
+    value = parseInt(arg, 10, 1, 100, &result);
+    if (result != RESULT_OK) {
+      argParseError(parseOpt, "invalid pollbudget");
+      return EINVAL;
+    }
+    opt->pollBudget = value;
+    break;
   case 'i':  // --inject[=stop]
     opt->injectCommands = true;
     opt->stopAfterInject = arg && strcmp("stop", arg) == 0;
@@ -437,6 +458,9 @@ static int parse_opt(int key, char *arg, const argParseOpt *parseOpt, struct opt
   case O_DEFCMD:  // --enabledefine
     opt->enableDefine = true;
     break;
+  case O_ASYNRQ:  // --asyncrequests
+    opt->asyncRequests = true;
+    break;
   case O_PIDFIL:  // --pidfile=/var/run/ebusd.pid
     if (arg == nullptr || arg[0] == 0 || strcmp("/", arg) == 0) {
       argParseError(parseOpt, "invalid pidfile");
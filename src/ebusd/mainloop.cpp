@@ -104,13 +104,14 @@ result_t UserList::addFromFile(const string& filename, unsigned int lineNo, map<
 
 
 MainLoop::MainLoop(const struct options& opt, BusHandler* busHandler,
-    MessageMap* messages, ScanHelper* scanHelper, Queue<Request*>* requestQueue)
+    MessageMap* messages, ScanHelper* scanHelper, RingQueue<Request*>* requestQueue)
   : Thread(), m_busHandler(busHandler), m_protocol(busHandler->getProtocol()), m_reconnectCount(0),
     m_userList(opt.accessLevel), m_messages(messages),
     m_scanHelper(scanHelper), m_address(opt.address), m_scanConfig(opt.scanConfig),
     m_initialScan(opt.readOnly ? (symbol_t)ESC : opt.initialScan), m_scanRetries(opt.scanRetries),
     m_scanStatus(SCAN_STATUS_NONE), m_polling(opt.pollInterval > 0), m_enableHex(opt.enableHex),
-    m_shutdown(false), m_runUpdateCheck(opt.updateCheck), m_httpClient(), m_requestQueue(requestQueue) {
+    m_shutdown(false), m_runUpdateCheck(opt.updateCheck), m_httpClient(), m_requestQueue(requestQueue),
+    m_asyncRequests(opt.asyncRequests), m_asyncPending(0) {
   if (opt.aclFile[0]) {
     string errorDescription;
     time_t mtime = 0;
@@ -150,6 +151,10 @@ MainLoop::~MainLoop() {
     delete dataHandler;
   }
   m_dataHandlers.clear();
+  for (const auto asyncResult : m_asyncResults) {
+    delete asyncResult;
+  }
+  m_asyncResults.clear();
   if (m_newlyDefinedMessages) {
     delete m_newlyDefinedMessages;
     m_newlyDefinedMessages = nullptr;
@@ -175,6 +180,7 @@ void MainLoop::shutdown() {
 void MainLoop::run() {
   bool reload = true;
   time_t lastTaskRun, now, start, lastSignal = 0, since, sinkSince = 1, nextCheckRun;
+  uint64_t sequence, sinkSequence = 0;
   int taskDelay = 5;
   symbol_t lastScanAddress = 0;  // 0 is known to be a master
   scanStatus_t lastScanStatus = m_scanStatus;
@@ -233,7 +239,7 @@ void MainLoop::run() {
             master.push_back(0x07);
             master.push_back(0xfe);  // query existance message
             master.adjustHeader();
-            result = m_protocol->sendAndWait(master, &slave);
+            result = m_protocol->sendAndWait(master, &slave, rc_scan);
           } else {
             logNotice(lf_main, "starting initial scan for %2.2x", m_initialScan);
             result = m_busHandler->scanAndWait(m_initialScan, true);
@@ -354,61 +360,88 @@ void MainLoop::run() {
     if (!dataSinks.empty()) {
       messages.clear();
       m_messages->lock();
-      m_messages->findAll("", "", "*", false, true, true, true, true, true, sinkSince, now, false, &messages);
-      for (const auto message : messages) {
-        bool changed = message->getLastChangeTime() >= sinkSince;
-        for (const auto dataSink : dataSinks) {
-          dataSink->notifyUpdate(message, changed);
+      uint64_t lastSequence;
+      if (m_messages->findUpdated("*", sinkSequence, false, &lastSequence, &messages)) {
+        for (const auto message : messages) {
+          bool changed = message->getLastChangeSequence() > sinkSequence;
+          for (const auto dataSink : dataSinks) {
+            dataSink->notifyUpdate(message, changed);
+          }
+        }
+      } else {
+        // journal overrun, fall back to the update times
+        m_messages->findAll("", "", "*", false, true, true, true, true, true, sinkSince, now, false, &messages);
+        for (const auto message : messages) {
+          bool changed = message->getLastChangeTime() >= sinkSince;
+          for (const auto dataSink : dataSinks) {
+            dataSink->notifyUpdate(message, changed);
+          }
+        }
+      }
+      messages.clear();
+      if (m_messages->takeAvailabilityChanged(&messages)) {
+        for (const auto message : messages) {
+          for (const auto dataSink : dataSinks) {
+            dataSink->notifyAvailability(message);
+          }
         }
       }
       m_messages->unlock();
       sinkSince = now;
+      sinkSequence = lastSequence;
     }
+    completeAsyncResults();
     if (req == nullptr) {
       continue;
     }
     if (m_shutdown) {
-      req->setResult("ERR: shutdown", "", nullptr, now, true);
+      req->setResult("ERR: shutdown", "", nullptr, now, 0, true);
       break;
     }
     string user = req->getUser();
-    RequestMode reqMode = req->getMode(&since);
+    RequestMode reqMode = req->getMode(&since, &sequence);
     if (reqMode.listenMode == lm_none) {
       since = now;
+      sequence = m_messages->getLastSequence();
     }
     ostringstream ostream;
     bool connected = true;
     if (!req->empty()) {
       req->log();
       bool currentReload = reload;
-      result_t result = decodeRequest(req, &connected, &reqMode, &user, &reload, &ostream);
+      ClientBusRequest* async = nullptr;
+      result_t result = decodeRequest(req, &connected, &reqMode, &user, &reload, &ostream,
+          m_asyncRequests ? &async : nullptr);
       if (reload && !currentReload) {
         scanRetry = 0;  // restart scan counting
       }
-      if (!req->isHttp() && (ostream.tellp() == 0 || result != RESULT_OK)) {
-        string suffix;
-        if (result == RESULT_EMPTY && ostream.tellp() > 0) {
-          suffix = ostream.str();
+      if (async) {
+        // hand over to the bus and keep on handling other requests, the result is passed to the client when done
+        async->setClient(req, since, sequence);
+        m_asyncMutex.lock();
+        result = m_busHandler->readFromBusAsync(async);
+        if (result == RESULT_OK) {
+          m_asyncPending++;
         }
-        ostream.str("");
-        ostream << getResultCode(result);
-        if (!suffix.empty()) {
-          ostream << " " << suffix;
+        m_asyncMutex.unlock();
+        if (result == RESULT_OK) {
+          continue;
         }
+        async_result_t* asyncResult = async->createResult(result, SlaveSymbolString());
+        delete async;
+        result = finishBusCommand(*asyncResult, &ostream);
+        delete asyncResult;
       }
-      const auto resp = ostream.str();
-      req->log(&resp);
-      if (ostream.tellp() == 0) {
-        ostream << "\n";  // only for HTTP
-      } else if (!req->isHttp()) {
-        ostream << (reqMode.listenMode == lm_direct ? "\n" : "\n\n");
-      }
+      formatResponse(req, result, reqMode.listenMode, &ostream);
     }
     if (reqMode.listenMode == lm_listen) {
       if (!reqMode.listenOnlyUnknown) {
         string levels = getUserLevels(user);
         messages.clear();
-        m_messages->findAll("", "", levels, false, true, true, true, true, true, since, now, true, &messages);
+        if (!m_messages->findUpdated(levels, sequence, true, &sequence, &messages)) {
+          // journal overrun, fall back to the change times
+          m_messages->findAll("", "", levels, false, true, true, true, true, true, since, now, true, &messages);
+        }
         for (const auto message : messages) {
           ostream << message->getCircuit() << " " << message->getName() << " = " << dec;
           message->decodeLastData(pt_any, false, nullptr, -1, reqMode.format, &ostream);
@@ -428,12 +461,99 @@ void MainLoop::run() {
       }
     }
     // send result to client
-    req->setResult(ostream.str(), user, &reqMode, now, !connected);
+    req->setResult(ostream.str(), user, &reqMode, now, sequence, !connected);
+  }
+}
+
+void MainLoop::formatResponse(const Request* req, result_t result, ListenMode listenMode, ostringstream* ostream) {
+  if (!req->isHttp() && (ostream->tellp() == 0 || result != RESULT_OK)) {
+    string suffix;
+    if (result == RESULT_EMPTY && ostream->tellp() > 0) {
+      suffix = ostream->str();
+    }
+    ostream->str("");
+    *ostream << getResultCode(result);
+    if (!suffix.empty()) {
+      *ostream << " " << suffix;
+    }
+  }
+  if (req->getReceivedTime() > 0) {
+    m_requestLatencies.add(clockGetMicros() - req->getReceivedTime());
+  }
+  const auto resp = ostream->str();
+  req->log(&resp);
+  if (ostream->tellp() == 0) {
+    *ostream << "\n";  // only for HTTP
+  } else if (!req->isHttp()) {
+    *ostream << (listenMode == lm_direct ? "\n" : "\n\n");
+  }
+}
+
+void ClientBusRequest::completed(result_t result, const SlaveSymbolString& slave) {
+  // only copy the raw result here as decoding and formatting is left to the main loop thread
+  m_mainLoop->queueAsyncResult(createResult(result, slave));
+}
+
+async_result_t* ClientBusRequest::createResult(result_t result, const SlaveSymbolString& slave) const {
+  async_result_t* asyncResult = new async_result_t();
+  asyncResult->command = m_command;
+  asyncResult->message = getMessage();
+  asyncResult->hexMessage = m_hexMessage;
+  asyncResult->verbosity = m_verbosity;
+  asyncResult->fieldName = m_fieldName;
+  asyncResult->fieldIndex = m_fieldIndex;
+  asyncResult->master = getMaster();
+  asyncResult->slave = slave;
+  asyncResult->result = result;
+  asyncResult->request = m_request;
+  asyncResult->since = m_since;
+  asyncResult->sequence = m_sequence;
+  return asyncResult;
+}
+
+void MainLoop::queueAsyncResult(async_result_t* result) {
+  m_asyncMutex.lock();
+  m_asyncResults.push_back(result);
+  m_asyncMutex.unlock();
+  m_requestQueue->push(nullptr);  // just to notify potentially waiting thread
+}
+
+void MainLoop::completeAsyncResults() {
+  deque<async_result_t*> results;
+  m_asyncMutex.lock();
+  results.swap(m_asyncResults);
+  m_asyncPending -= static_cast<unsigned int>(results.size());
+  m_asyncMutex.unlock();
+  for (const auto asyncResult : results) {
+    ostringstream ostream;
+    result_t result = finishBusCommand(*asyncResult, &ostream);
+    Request* req = asyncResult->request;
+    formatResponse(req, result, req->getMode().listenMode, &ostream);
+    // listen updates are left to the next regular request of the client
+    req->setResult(ostream.str(), req->getUser(), nullptr, asyncResult->since, asyncResult->sequence, false);
+    delete asyncResult;
+  }
+}
+
+result_t MainLoop::finishBusCommand(const async_result_t& result, ostringstream* ostream) {
+  switch (result.command) {
+    case ac_read:
+      return finishRead(result.message, result.result, result.verbosity, result.fieldName, result.fieldIndex,
+          ostream);
+    case ac_readHex:
+      return finishReadHex(result.hexMessage, result.master, result.slave, result.result, ostream);
+    case ac_write:
+      return finishWrite(result.message, result.result, result.verbosity, ostream);
+    case ac_writeHex:
+      return finishWriteHex(result.hexMessage, result.master, result.slave, result.result, result.verbosity,
+          ostream);
+    default:
+      return finishHex(result.master, result.slave, result.result, false, ostream);
   }
 }
 
 result_t MainLoop::decodeRequest(Request* req, bool* connected, RequestMode* reqMode,
-    string* user, bool* reload, ostringstream* ostream) {
+    string* user, bool* reload, ostringstream* ostream, ClientBusRequest** async) {
   vector<string> args;
   req->split(&args);
   string cmd = args.size() > 0 ? args[0] : "";
@@ -475,14 +595,14 @@ result_t MainLoop::decodeRequest(Request* req, bool* connected, RequestMode* req
     return executeAuth(args, user, ostream);
   }
   if (cmd == "R" || cmd == "READ") {
-    return executeRead(args, getUserLevels(*user), ostream);
+    return executeRead(args, getUserLevels(*user), ostream, async);
   }
   if (cmd == "W" || cmd == "WRITE") {
-    return executeWrite(args, getUserLevels(*user), ostream);
+    return executeWrite(args, getUserLevels(*user), ostream, async);
   }
   if (cmd == "HEX") {
     if (m_enableHex) {
-      return executeHex(args, ostream);
+      return executeHex(args, ostream, async);
     }
     *ostream << "ERR: command not enabled";
     return RESULT_OK;
@@ -516,6 +636,9 @@ result_t MainLoop::decodeRequest(Request* req, bool* connected, RequestMode* req
   if (cmd == "G" || cmd == "GRAB") {
     return executeGrab(args, ostream);
   }
+  if (cmd == "AIRTIME") {
+    return executeAirtime(args, ostream);
+  }
   if (cmd == "DEF" || cmd == "DEFINE") {
     if (m_newlyDefinedMessages) {
       return executeDefine(args, ostream);
@@ -615,7 +738,8 @@ result_t MainLoop::executeAuth(const vector<string>& args, string* user, ostring
   return RESULT_OK;
 }
 
-result_t MainLoop::executeRead(const vector<string>& args, const string& levels, ostringstream* ostream) {
+result_t MainLoop::executeRead(const vector<string>& args, const string& levels, ostringstream* ostream,
+    ClientBusRequest** async) {
   size_t argPos = 1;
   bool hex = false, newDefinition = false, writeDirection = false;
   OutputFormat verbosity = OF_NONE;
@@ -798,28 +922,13 @@ result_t MainLoop::executeRead(const vector<string>& args, const string& levels,
     }
 
     // send message
-    SlaveSymbolString slave;
-    ret = m_protocol->sendAndWait(master, &slave);
-
-    if (ret == RESULT_OK) {
-      ret = message->storeLastData(master, slave);
-      ostringstream result;
-      if (ret == RESULT_OK) {
-        ret = message->decodeLastData(pt_slaveData, false, nullptr, -1, OF_NONE, &result);
-      }
-      if (ret >= RESULT_OK) {
-        logInfo(lf_main, "read hex %s %s cache update: %s", message->getCircuit().c_str(), message->getName().c_str(),
-                result.str().c_str());
-      } else {
-        logError(lf_main, "read hex %s %s cache update: %s", message->getCircuit().c_str(), message->getName().c_str(),
-                 getResultCode(ret));
-      }
-      *ostream << slave.getStr();
-      return RESULT_OK;
+    if (async) {
+      *async = new ClientBusRequest(this, ac_readHex, master, message, OF_NONE);
+      return RESULT_CONTINUE;
     }
-    logError(lf_main, "read hex %s %s: %s", message->getCircuit().c_str(), message->getName().c_str(),
-             getResultCode(ret));
-    return ret;
+    SlaveSymbolString slave;
+    ret = m_protocol->sendAndWait(master, &slave, rc_read);
+    return finishReadHex(message, master, slave, ret, ostream);
   }
 
   string fieldName;
@@ -910,7 +1019,40 @@ result_t MainLoop::executeRead(const vector<string>& args, const string& levels,
     return RESULT_ERR_INVALID_ADDR;
   }
   // read directly from bus
+  if (async && !newDefinition) {
+    *async = new ClientBusRequest(this, ac_read, message, params, dstAddress, srcAddress, verbosity,
+        fieldName, fieldIndex);
+    return RESULT_CONTINUE;
+  }
   ret = m_busHandler->readFromBus(message, params, dstAddress, srcAddress);
+  return finishRead(message, ret, verbosity, fieldName, fieldIndex, ostream);
+}
+
+result_t MainLoop::finishReadHex(Message* message, const MasterSymbolString& master, const SlaveSymbolString& slave,
+    result_t ret, ostringstream* ostream) {
+  if (ret == RESULT_OK) {
+    ret = message->storeLastData(master, slave);
+    ostringstream result;
+    if (ret == RESULT_OK) {
+      ret = message->decodeLastData(pt_slaveData, false, nullptr, -1, OF_NONE, &result);
+    }
+    if (ret >= RESULT_OK) {
+      logInfo(lf_main, "read hex %s %s cache update: %s", message->getCircuit().c_str(), message->getName().c_str(),
+              result.str().c_str());
+    } else {
+      logError(lf_main, "read hex %s %s cache update: %s", message->getCircuit().c_str(), message->getName().c_str(),
+               getResultCode(ret));
+    }
+    *ostream << slave.getStr();
+    return RESULT_OK;
+  }
+  logError(lf_main, "read hex %s %s: %s", message->getCircuit().c_str(), message->getName().c_str(),
+           getResultCode(ret));
+  return ret;
+}
+
+result_t MainLoop::finishRead(Message* message, result_t ret, OutputFormat verbosity, const string& fieldName,
+    ssize_t fieldIndex, ostringstream* ostream) {
   if (ret != RESULT_OK) {
     return ret;
   }
@@ -937,7 +1079,8 @@ result_t MainLoop::executeRead(const vector<string>& args, const string& levels,
   return ret;
 }
 
-result_t MainLoop::executeWrite(const vector<string>& args, const string levels, ostringstream* ostream) {
+result_t MainLoop::executeWrite(const vector<string>& args, const string levels, ostringstream* ostream,
+    ClientBusRequest** async) {
   size_t argPos = 1;
   bool hex = false, newDefinition = false;
   OutputFormat verbosity = OF_NONE;
@@ -1043,36 +1186,13 @@ result_t MainLoop::executeWrite(const vector<string>& args, const string levels,
     }
 
     // send message
+    if (async) {
+      *async = new ClientBusRequest(this, ac_writeHex, master, message, verbosity);
+      return RESULT_CONTINUE;
+    }
     SlaveSymbolString slave;
     ret = m_protocol->sendAndWait(master, &slave);
-
-    if (ret == RESULT_OK) {
-      // also update read messages
-      ret = message->storeLastData(master, slave);
-      ostringstream result;
-      if (ret == RESULT_OK) {
-        ret = message->decodeLastData(pt_slaveData, false, nullptr, -1, verbosity, &result);
-      }
-      if (ret >= RESULT_OK) {
-        logInfo(lf_main, "write hex %s %s cache update: %s", message->getCircuit().c_str(),
-            message->getName().c_str(), result.str().c_str());
-      } else {
-        logError(lf_main, "write hex %s %s cache update: %s", message->getCircuit().c_str(),
-            message->getName().c_str(), getResultCode(ret));
-      }
-      if (master[1] == BROADCAST) {
-        *ostream << "done broadcast";
-        return RESULT_OK;
-      }
-      if (isMaster(master[1])) {
-        return RESULT_OK;
-      }
-      *ostream << slave.getStr();
-      return RESULT_OK;
-    }
-    logError(lf_main, "write hex %s %s: %s", message->getCircuit().c_str(), message->getName().c_str(),
-        getResultCode(ret));
-    return ret;
+    return finishWriteHex(message, master, slave, ret, verbosity, ostream);
   }
 
   Message* message;
@@ -1106,14 +1226,53 @@ result_t MainLoop::executeWrite(const vector<string>& args, const string levels,
     return RESULT_ERR_INVALID_ADDR;
   }
   // allow missing values
-  ret = m_busHandler->readFromBus(message, args.size() == argPos + 1 ? "" : args[argPos + 1], dstAddress, srcAddress);
+  const string inputStr = args.size() == argPos + 1 ? "" : args[argPos + 1];
+  if (async && !newDefinition) {
+    *async = new ClientBusRequest(this, ac_write, message, inputStr, dstAddress, srcAddress, verbosity);
+    return RESULT_CONTINUE;
+  }
+  ret = m_busHandler->readFromBus(message, inputStr, dstAddress, srcAddress);
+  return finishWrite(message, ret, verbosity, ostream);
+}
+
+result_t MainLoop::finishWriteHex(Message* message, const MasterSymbolString& master,
+    const SlaveSymbolString& slave, result_t ret, OutputFormat verbosity, ostringstream* ostream) {
+  if (ret == RESULT_OK) {
+    // also update read messages
+    ret = message->storeLastData(master, slave);
+    ostringstream result;
+    if (ret == RESULT_OK) {
+      ret = message->decodeLastData(pt_slaveData, false, nullptr, -1, verbosity, &result);
+    }
+    if (ret >= RESULT_OK) {
+      logInfo(lf_main, "write hex %s %s cache update: %s", message->getCircuit().c_str(),
+          message->getName().c_str(), result.str().c_str());
+    } else {
+      logError(lf_main, "write hex %s %s cache update: %s", message->getCircuit().c_str(),
+          message->getName().c_str(), getResultCode(ret));
+    }
+    if (master[1] == BROADCAST) {
+      *ostream << "done broadcast";
+      return RESULT_OK;
+    }
+    if (isMaster(master[1])) {
+      return RESULT_OK;
+    }
+    *ostream << slave.getStr();
+    return RESULT_OK;
+  }
+  logError(lf_main, "write hex %s %s: %s", message->getCircuit().c_str(), message->getName().c_str(),
+      getResultCode(ret));
+  return ret;
+}
+
+result_t MainLoop::finishWrite(Message* message, result_t ret, OutputFormat verbosity, ostringstream* ostream) {
   if (ret != RESULT_OK) {
     logError(lf_main, "write %s %s: %s", message->getCircuit().c_str(), message->getName().c_str(),
         getResultCode(ret));
     return ret;
   }
-  dstAddress = message->getLastMasterData()[1];
-
+  symbol_t dstAddress = message->getLastMasterData()[1];
   ret = message->decodeLastData(pt_slaveData, false, nullptr, -1, verbosity, ostream);  // decode data
   if (ret < RESULT_OK) {
     logError(lf_main, "write %s %s: decode %s", message->getCircuit().c_str(), message->getName().c_str(),
@@ -1135,7 +1294,7 @@ result_t MainLoop::executeWrite(const vector<string>& args, const string levels,
 }
 
 result_t MainLoop::parseHexAndSend(const vector<string>& args, size_t& argPos, bool isDirectMode,
-    ostringstream* ostream) {
+    ostringstream* ostream, ClientBusRequest** async) {
   symbol_t srcAddress = SYN;
   bool autoLength = false;
   while (args.size() > argPos && args[argPos][0] == '-') {
@@ -1169,9 +1328,17 @@ result_t MainLoop::parseHexAndSend(const vector<string>& args, size_t& argPos, b
   logNotice(lf_main, isDirectMode ? "direct cmd: %s" : "hex cmd: %s", master.getStr().c_str());
 
   // send message
+  if (async) {
+    *async = new ClientBusRequest(this, ac_hex, master, nullptr, OF_NONE);
+    return RESULT_CONTINUE;
+  }
   SlaveSymbolString slave;
   ret = m_protocol->sendAndWait(master, &slave);
+  return finishHex(master, slave, ret, isDirectMode, ostream);
+}
 
+result_t MainLoop::finishHex(const MasterSymbolString& master, const SlaveSymbolString& slave, result_t ret,
+    bool isDirectMode, ostringstream* ostream) {
   if (ret == RESULT_OK) {
     if (master[1] == BROADCAST) {
       *ostream << "done broadcast";
@@ -1188,9 +1355,9 @@ result_t MainLoop::parseHexAndSend(const vector<string>& args, size_t& argPos, b
   return ret;
 }
 
-result_t MainLoop::executeHex(const vector<string>& args, ostringstream* ostream) {
+result_t MainLoop::executeHex(const vector<string>& args, ostringstream* ostream, ClientBusRequest** async) {
   size_t argPos = 1;
-  result_t ret = parseHexAndSend(args, argPos, false, ostream);
+  result_t ret = parseHexAndSend(args, argPos, false, ostream, async);
   if (argPos != 0 && argPos == args.size()) {
     return ret;
   }
@@ -1687,6 +1854,16 @@ result_t MainLoop::executeGrab(const vector<string>& args, ostringstream* ostrea
   return RESULT_OK;
 }
 
+result_t MainLoop::executeAirtime(const vector<string>& args, ostringstream* ostream) {
+  if (args.size() == 1 || (args.size() == 2 && args[1] == "reset")) {
+    m_busHandler->formatAirtime(false, args.size() == 2, ostream);
+    return RESULT_OK;
+  }
+  *ostream << "usage: airtime [reset]\n"
+              " Report the bus airtime by source address, destination address, and message, and optionally reset it.";
+  return RESULT_OK;
+}
+
 result_t MainLoop::executeDefine(const vector<string>& args, ostringstream* ostream) {
   size_t argPos = 1;
   bool replace = false;
@@ -1971,6 +2148,13 @@ result_t MainLoop::executeReload(const vector<string>& args, ostringstream* ostr
                 " Reload CSV config files.";
     return RESULT_OK;
   }
+  m_asyncMutex.lock();
+  bool pending = m_asyncPending > 0;
+  m_asyncMutex.unlock();
+  if (pending) {
+    *ostream << "ERR: bus requests pending";  // messages still referenced by asynchronous client requests
+    return RESULT_OK;
+  }
   m_busHandler->clear();
   m_scanHelper->loadConfigFiles(!m_scanConfig);
   return RESULT_OK;
@@ -2009,6 +2193,14 @@ result_t MainLoop::executeInfo(const vector<string>& args, const string& user, o
       *ostream << "min symbol latency: " << m_protocol->getMinSymbolLatency() << "\n"
                << "max symbol latency: " << m_protocol->getMaxSymbolLatency() << "\n";
     }
+    if (m_protocol->getCoalescedCount() > 0) {
+      *ostream << "coalesced requests: " << m_protocol->getCoalescedCount() << "\n";
+    }
+    m_protocol->formatQueueInfo(ostream);
+    m_protocol->formatLatencyInfo(ostream, false, false);
+    *ostream << "request latency micros: ";
+    m_requestLatencies.format(ostream, false);
+    *ostream << "\n";
     if (m_scanStatus != SCAN_STATUS_NONE) {
       *ostream << "scan: " << (m_scanStatus == SCAN_STATUS_FINISHED ? "finished" : "running");
       unsigned int running = m_busHandler->getRunningScans();
@@ -2025,9 +2217,11 @@ result_t MainLoop::executeInfo(const vector<string>& args, const string& user, o
            << "messages: " << m_messages->size() << "\n"
            << "conditional: " << m_messages->sizeConditional() << "\n"
            << "poll: " << m_messages->sizePoll() << "\n"
+           << "poll suppressed: " << m_messages->getSuppressedPollCount() << "\n"
            << "update: " << m_messages->sizePassive();
   if (verbose) {
-    *ostream << "\nconfig path: " << m_scanHelper->getConfigPath();
+    *ostream << "\nconfig path: " << m_scanHelper->getConfigPath() << "\n";
+    formatInternInfo(ostream);
   }
   m_busHandler->formatSeenInfo(ostream);
   return RESULT_OK;
@@ -2066,6 +2260,7 @@ result_t MainLoop::executeHelp(ostringstream* ostream) {
       " info|i    Report information about the daemon, configuration, seen participants, and the device.\n"
       " grab|g    Grab messages:         grab [stop]\n"
       "           Report the messages:   grab result [all|decode]\n"
+      " airtime   Report bus airtime:    airtime [reset]\n"
       " define    Define new message:    define [-r] DEFINITION (if enabled)\n"
       " decode|d  Decode field(s):       decode [-v|-V] [-n|-N] DEFINITION DD[DD]*\n"
       " encode|e  Encode field(s):       encode DEFINITION VALUE[;VALUE]*\n"
@@ -2110,6 +2305,7 @@ result_t MainLoop::executeGet(const vector<string>& args, bool* connected, ostri
     string newDefinition;
     OutputFormat verbosity = OF_NAMES;
     time_t since = 0;
+    uint64_t sinceSequence = 0;
     size_t pollPriority = 0;
     bool exact = false;
     string user;
@@ -2129,6 +2325,12 @@ result_t MainLoop::executeGet(const vector<string>& args, bool* connected, ostri
         }
         if (qname == "since") {
           since = parseInt(value.c_str(), 10, 0, 0xffffffff, &ret);
+        } else if (qname == "seq") {
+          char* strEnd = nullptr;
+          sinceSequence = strtoull(value.c_str(), &strEnd, 10);
+          if (strEnd == nullptr || strEnd == value.c_str() || *strEnd != 0) {
+            ret = RESULT_ERR_INVALID_NUM;
+          }
         } else if (qname == "poll") {
           pollPriority = (size_t)parseInt(value.c_str(), 10, 1, 9, &ret);
         } else if (qname == "exact") {
@@ -2195,6 +2397,7 @@ result_t MainLoop::executeGet(const vector<string>& args, bool* connected, ostri
     time_t now;
     time(&now);
     time_t maxLastUp = 0;
+    uint64_t lastSequence = m_messages->getLastSequence();
     if (ret == RESULT_OK && !newDefinition.empty()) {
       string errorDescription;
       istringstream defstr("#\n" + newDefinition);  // ensure first line is not used for determining col names
@@ -2204,8 +2407,19 @@ result_t MainLoop::executeGet(const vector<string>& args, bool* connected, ostri
       bool first = true;
       verbosity |= OF_JSON | (full ? OF_ALL_ATTRS : OF_NONE) | (withDefinition ? OF_DEFINITION : OF_NONE);
       deque<Message*> messages;
-      m_messages->findAll(circuit, name, getUserLevels(user), exact, true, withWrite, true, true, true, 0, 0, false,
-                          &messages);
+      bool fromJournal = sinceSequence > 0 && !required && pollPriority == 0
+          && m_messages->findUpdated(circuit, name, getUserLevels(user), exact, withWrite, sinceSequence, false,
+                                     &lastSequence, &messages);
+      if (fromJournal) {
+        // group the updated messages by circuit and name like findAll() does
+        std::stable_sort(messages.begin(), messages.end(), [](const Message* a, const Message* b) {
+          int cmp = a->getCircuit().compare(b->getCircuit());
+          return cmp < 0 || (cmp == 0 && a->getName() < b->getName());
+        });
+      } else {
+        m_messages->findAll(circuit, name, getUserLevels(user), exact, true, withWrite, true, true, true, 0, 0, false,
+                            &messages);
+      }
       string lastName;
       for (deque<Message*>::iterator it = messages.begin(); it != messages.end(); it++) {
         Message* message = *it;
@@ -2226,7 +2440,8 @@ result_t MainLoop::executeGet(const vector<string>& args, bool* connected, ostri
             continue;
           }
         } else {
-          if (since > 0 && lastup <= since) {
+          if ((since > 0 && lastup <= since)
+              || (!fromJournal && sinceSequence > 0 && message->getLastUpdateSequence() <= sinceSequence)) {
             continue;
           }
           if (lastup > maxLastUp) {
@@ -2285,6 +2500,7 @@ result_t MainLoop::executeGet(const vector<string>& args, bool* connected, ostri
           *ostream << ",\n  \"minsymbollatency\": " << m_protocol->getMinSymbolLatency()
                    << ",\n  \"maxsymbollatency\": " << m_protocol->getMaxSymbolLatency();
         }
+        *ostream << ",\n  \"coalescedrequests\": " << m_protocol->getCoalescedCount();
       }
       if (!m_protocol->isReadOnly()) {
         *ostream << ",\n  \"qq\": " << static_cast<unsigned>(m_address);
@@ -2293,6 +2509,7 @@ result_t MainLoop::executeGet(const vector<string>& args, bool* connected, ostri
                << ",\n  \"masters\": " << m_protocol->getMasterCount()
                << ",\n  \"messages\": " << m_messages->size()
                << ",\n  \"lastup\": " << static_cast<unsigned>(maxLastUp)
+               << ",\n  \"sequence\": " << lastSequence
                << "\n }"
                << "\n}";
       type = 6;
@@ -2301,6 +2518,25 @@ result_t MainLoop::executeGet(const vector<string>& args, bool* connected, ostri
     return formatHttpResult(ret, type, ostream);
   }  // request for "/data..."
 
+  if (uri == "/latency") {
+    // the histograms are reset on each read
+    *ostream << "{";
+    m_protocol->formatLatencyInfo(ostream, true, true);
+    *ostream << ",\"request\":";
+    m_requestLatencies.format(ostream, true, true);
+    *ostream << "}";
+    type = 6;
+    *connected = false;
+    return formatHttpResult(ret, type, ostream);
+  }
+
+  if (uri == "/airtime") {
+    m_busHandler->formatAirtime(true, false, ostream);
+    type = 6;
+    *connected = false;
+    return formatHttpResult(ret, type, ostream);
+  }
+
   if (uri == "/datatypes") {
     *ostream << "[";
     OutputFormat verbosity = OF_NAMES|OF_JSON|OF_ALL_ATTRS;
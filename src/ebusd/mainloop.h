@@ -20,6 +20,7 @@
 #define EBUSD_MAINLOOP_H_
 
 #include <string>
+#include <deque>
 #include <list>
 #include <vector>
 #include <map>
@@ -32,6 +33,7 @@
 #include "lib/ebus/message.h"
 #include "lib/ebus/protocol.h"
 #include "lib/utils/httpclient.h"
+#include "lib/utils/queue.h"
 
 namespace ebusd {
 
@@ -96,10 +98,139 @@ class UserList : public UserInfo, public MappedFileReader {
 };
 
 
+class MainLoop;
+
+/** the kind of client command executed asynchronously on the bus. */
+enum AsyncCommand {
+  ac_read,      //!< read command with message name
+  ac_readHex,   //!< read command with hex message
+  ac_write,     //!< write command with message name
+  ac_writeHex,  //!< write command with hex message
+  ac_hex,       //!< hex command
+};
+
+/** the raw outcome of a finished @a ClientBusRequest handed back to the @a MainLoop for decoding. */
+typedef struct async_result {
+  AsyncCommand command;       //!< the executed @a AsyncCommand
+  Message* message;           //!< the associated @a Message, or nullptr for a hex message
+  Message* hexMessage;        //!< the @a Message matching the hex master data for updating the cache, or nullptr
+  OutputFormat verbosity;     //!< the @a OutputFormat for decoding the result
+  string fieldName;           //!< the name of the single field to decode, or empty
+  ssize_t fieldIndex;         //!< the index of the single field to decode, -1 for all with the name, or -2 for all
+  MasterSymbolString master;  //!< the master data sent for the last part
+  SlaveSymbolString slave;    //!< the slave data received for the last part
+  result_t result;            //!< the result code from the bus
+  Request* request;           //!< the client @a Request to pass the result to
+  time_t since;               //!< the listen start time to keep for the client
+  uint64_t sequence;          //!< the listen sequence number to keep for the client
+} async_result_t;
+
+/**
+ * An @a AsyncBusRequest executing a bus bound client command and passing the raw result back to the @a MainLoop
+ * for decoding and answering the client @a Request once finished.
+ */
+class ClientBusRequest : public AsyncBusRequest {
+  friend class MainLoop;
+
+ public:
+  /**
+   * Constructor for a read or write command with message name.
+   * @param mainLoop the @a MainLoop instance for formatting the result.
+   * @param command the @a AsyncCommand to execute.
+   * @param message the associated @a Message.
+   * @param inputStr the input @a string from which to read master values (if any).
+   * @param dstAddress the destination address to set, or @a SYN to keep the address defined during construction.
+   * @param srcAddress the source address to set, or @a SYN for the own master address.
+   * @param verbosity the @a OutputFormat for decoding the result.
+   * @param fieldName the name of the single field to decode, or empty.
+   * @param fieldIndex the index of the single field to decode, -1 for all with the name, or -2 for all fields.
+   */
+  ClientBusRequest(MainLoop* mainLoop, AsyncCommand command, Message* message, const string& inputStr,
+      symbol_t dstAddress, symbol_t srcAddress, OutputFormat verbosity, const string& fieldName = "",
+      ssize_t fieldIndex = -2)
+    : AsyncBusRequest(message, inputStr, dstAddress, srcAddress), m_mainLoop(mainLoop), m_command(command),
+      m_hexMessage(nullptr), m_verbosity(verbosity), m_fieldName(fieldName), m_fieldIndex(fieldIndex),
+      m_request(nullptr), m_since(0), m_sequence(0) {}
+
+  /**
+   * Constructor for a command with hex message.
+   * @param mainLoop the @a MainLoop instance for formatting the result.
+   * @param command the @a AsyncCommand to execute.
+   * @param master the master data @a MasterSymbolString to send.
+   * @param hexMessage the @a Message matching the master data for updating the cache, or nullptr.
+   * @param verbosity the @a OutputFormat for decoding the result.
+   */
+  ClientBusRequest(MainLoop* mainLoop, AsyncCommand command, const MasterSymbolString& master, Message* hexMessage,
+      OutputFormat verbosity)
+    : AsyncBusRequest(master, command == ac_readHex ? rc_read : rc_write), m_mainLoop(mainLoop), m_command(command),
+      m_hexMessage(hexMessage), m_verbosity(verbosity), m_fieldIndex(-2), m_request(nullptr), m_since(0),
+      m_sequence(0) {}
+
+  /**
+   * Destructor.
+   */
+  virtual ~ClientBusRequest() {}
+
+  /**
+   * Set the client @a Request to pass the result to.
+   * @param request the client @a Request.
+   * @param since the listen start time to keep for the client.
+   * @param sequence the listen sequence number to keep for the client.
+   */
+  void setClient(Request* request, time_t since, uint64_t sequence) {
+    m_request = request;
+    m_since = since;
+    m_sequence = sequence;
+  }
+
+  // @copydoc
+  void completed(result_t result, const SlaveSymbolString& slave) override;
+
+  /**
+   * Create the raw outcome of this request.
+   * @param result the result code from the bus.
+   * @param slave the @a SlaveSymbolString received for the last part.
+   * @return the new @a async_result_t (to be freed by the caller).
+   */
+  async_result_t* createResult(result_t result, const SlaveSymbolString& slave) const;
+
+
+ private:
+  /** the @a MainLoop instance for formatting the result. */
+  MainLoop* m_mainLoop;
+
+  /** the @a AsyncCommand to execute. */
+  const AsyncCommand m_command;
+
+  /** the @a Message matching the hex master data for updating the cache, or nullptr. */
+  Message* m_hexMessage;
+
+  /** the @a OutputFormat for decoding the result. */
+  const OutputFormat m_verbosity;
+
+  /** the name of the single field to decode, or empty. */
+  const string m_fieldName;
+
+  /** the index of the single field to decode, -1 for all with the name, or -2 for all fields. */
+  const ssize_t m_fieldIndex;
+
+  /** the client @a Request to pass the result to. */
+  Request* m_request;
+
+  /** the listen start time to keep for the client. */
+  time_t m_since;
+
+  /** the listen sequence number to keep for the client. */
+  uint64_t m_sequence;
+};
+
+
 /**
  * The main loop handling requests from connected clients.
  */
 class MainLoop : public Thread {
+  friend class ClientBusRequest;
+
  public:
   /**
    * Construct the main loop and create bus handling components.
@@ -110,7 +241,7 @@ class MainLoop : public Thread {
    * @param requestQueue the reference to the @a Request @a Queue.
    */
   MainLoop(const struct options& opt, BusHandler* busHandler,
-      MessageMap* messages, ScanHelper* scanHelper, Queue<Request*>* requestQueue);
+      MessageMap* messages, ScanHelper* scanHelper, RingQueue<Request*>* requestQueue);
 
   /**
    * Destructor.
@@ -137,12 +268,43 @@ class MainLoop : public Thread {
    * @param user set to the new user name when changed by authentication.
    * @param reload set to true when the configuration files were reloaded.
    * @param ostream the @a ostringstream to format the result string to.
+   * @param async where to store the @a ClientBusRequest to execute asynchronously for a bus bound command
+   * (indicated by result @a RESULT_CONTINUE), or nullptr to execute it synchronously.
    * @return the result code.
    */
   result_t decodeRequest(Request* req, bool* connected, RequestMode* reqMode,
-      string* user, bool* reload, ostringstream* ostream);
+      string* user, bool* reload, ostringstream* ostream, ClientBusRequest** async = nullptr);
 
  private:
+  /**
+   * Format the final response to the client.
+   * @param req the @a Request to format the response for.
+   * @param result the result code of the executed command.
+   * @param listenMode the current @a ListenMode of the client.
+   * @param ostream the @a ostringstream with the command output to format the response to.
+   */
+  void formatResponse(const Request* req, result_t result, ListenMode listenMode, ostringstream* ostream);
+
+  /**
+   * Called by a @a ClientBusRequest from within the @a ProtocolHandler thread when it was finished to hand the raw
+   * result over to the main loop thread.
+   * @param result the @a async_result_t to take over.
+   */
+  void queueAsyncResult(async_result_t* result);
+
+  /**
+   * Decode the results of finished @a ClientBusRequest instances and pass them to the clients.
+   */
+  void completeAsyncResults();
+
+  /**
+   * Finish a bus bound command after sending to the bus.
+   * @param result the @a async_result_t with the command details and the raw result.
+   * @param ostream the @a ostringstream to format the result string to.
+   * @return the result code.
+   */
+  result_t finishBusCommand(const async_result_t& result, ostringstream* ostream);
+
   /**
    * Parse the hex master message from the remaining arguments.
    * @param args the arguments passed to the command.
@@ -176,18 +338,72 @@ class MainLoop : public Thread {
    * @param args the arguments passed to the command (starting with the command itself), or empty for help.
    * @param levels the current user's access levels.
    * @param ostream the @a ostringstream to format the result string to.
+   * @param async where to store the @a ClientBusRequest when the command needs to be sent to the bus
+   * asynchronously (indicated by result @a RESULT_CONTINUE), or nullptr to send it synchronously.
    * @return the result code.
    */
-  result_t executeRead(const vector<string>& args, const string& levels, ostringstream* ostream);
+  result_t executeRead(const vector<string>& args, const string& levels, ostringstream* ostream,
+      ClientBusRequest** async);
+
+  /**
+   * Finish the read command with hex message after sending to the bus.
+   * @param message the @a Message matching the master data.
+   * @param master the @a MasterSymbolString sent.
+   * @param slave the @a SlaveSymbolString received.
+   * @param ret the result code from the bus.
+   * @param ostream the @a ostringstream to format the result string to.
+   * @return the result code.
+   */
+  result_t finishReadHex(Message* message, const MasterSymbolString& master, const SlaveSymbolString& slave,
+      result_t ret, ostringstream* ostream);
+
+  /**
+   * Finish the read command with message name after sending to the bus.
+   * @param message the @a Message that was read.
+   * @param ret the result code from the bus.
+   * @param verbosity the @a OutputFormat for decoding the result.
+   * @param fieldName the name of the single field to decode, or empty.
+   * @param fieldIndex the index of the single field to decode, -1 for all with the name, or -2 for all fields.
+   * @param ostream the @a ostringstream to format the result string to.
+   * @return the result code.
+   */
+  result_t finishRead(Message* message, result_t ret, OutputFormat verbosity, const string& fieldName,
+      ssize_t fieldIndex, ostringstream* ostream);
 
   /**
    * Execute the write command.
    * @param args the arguments passed to the command (starting with the command itself), or empty for help.
    * @param levels the current user's access levels.
    * @param ostream the @a ostringstream to format the result string to.
+   * @param async where to store the @a ClientBusRequest when the command needs to be sent to the bus
+   * asynchronously (indicated by result @a RESULT_CONTINUE), or nullptr to send it synchronously.
+   * @return the result code.
+   */
+  result_t executeWrite(const vector<string>& args, const string levels, ostringstream* ostream,
+      ClientBusRequest** async);
+
+  /**
+   * Finish the write command with hex message after sending to the bus.
+   * @param message the @a Message matching the master data.
+   * @param master the @a MasterSymbolString sent.
+   * @param slave the @a SlaveSymbolString received.
+   * @param ret the result code from the bus.
+   * @param verbosity the @a OutputFormat for decoding the cached data.
+   * @param ostream the @a ostringstream to format the result string to.
+   * @return the result code.
+   */
+  result_t finishWriteHex(Message* message, const MasterSymbolString& master, const SlaveSymbolString& slave,
+      result_t ret, OutputFormat verbosity, ostringstream* ostream);
+
+  /**
+   * Finish the write command with message name after sending to the bus.
+   * @param message the @a Message that was written.
+   * @param ret the result code from the bus.
+   * @param verbosity the @a OutputFormat for decoding the result.
+   * @param ostream the @a ostringstream to format the result string to.
    * @return the result code.
    */
-  result_t executeWrite(const vector<string>& args, const string levels, ostringstream* ostream);
+  result_t finishWrite(Message* message, result_t ret, OutputFormat verbosity, ostringstream* ostream);
 
   /**
    * Parse a hex or direct command and send it on the bus.
@@ -196,17 +412,35 @@ class MainLoop : public Thread {
    * invalid input.
    * @param isDirectMode true for direct mode, false for hex command.
    * @param ostream the @a ostringstream to format the result string to.
+   * @param async where to store the @a ClientBusRequest when the message needs to be sent to the bus
+   * asynchronously (indicated by result @a RESULT_CONTINUE), or nullptr to send it synchronously.
+   * @return the result code.
+   */
+  result_t parseHexAndSend(const vector<string>& args, size_t& argPos, bool isDirectMode, ostringstream* ostream,
+      ClientBusRequest** async = nullptr);
+
+  /**
+   * Finish the hex or direct command after sending to the bus.
+   * @param master the @a MasterSymbolString sent.
+   * @param slave the @a SlaveSymbolString received.
+   * @param ret the result code from the bus.
+   * @param isDirectMode true for direct mode, false for hex command.
+   * @param ostream the @a ostringstream to format the result string to.
    * @return the result code.
    */
-  result_t parseHexAndSend(const vector<string>& args, size_t& argPos, bool isDirectMode, ostringstream* ostream);
+  result_t finishHex(const MasterSymbolString& master, const SlaveSymbolString& slave, result_t ret,
+      bool isDirectMode, ostringstream* ostream);
 
   /**
    * Execute the hex command.
    * @param args the arguments passed to the command (starting with the command itself), or empty for help.
    * @param ostream the @a ostringstream to format the result string to.
+   * @param async where to store the @a ClientBusRequest when the command needs to be sent to the bus
+   * asynchronously (indicated by result @a RESULT_CONTINUE), or nullptr to send it synchronously.
    * @return the result code.
    */
-  result_t executeHex(const vector<string>& args, ostringstream* ostream);
+  result_t executeHex(const vector<string>& args, ostringstream* ostream,
+      ClientBusRequest** async);
 
   /**
    * Execute the inject command.
@@ -268,6 +502,14 @@ class MainLoop : public Thread {
    */
   result_t executeGrab(const vector<string>& args, ostringstream* ostream);
 
+  /**
+   * Execute the airtime command.
+   * @param args the arguments passed to the command (starting with the command itself), or empty for help.
+   * @param ostream the @a ostringstream to format the result string to.
+   * @return the result code.
+   */
+  result_t executeAirtime(const vector<string>& args, ostringstream* ostream);
+
   /**
    * Execute the define command.
    * @param args the arguments passed to the command (starting with the command itself), or empty for help.
@@ -385,6 +627,9 @@ class MainLoop : public Thread {
   /** the number of reconnects requested from the @a Device. */
   unsigned int m_reconnectCount;
 
+  /** the @a Histogram of the time [us] from receiving a client request to its response. */
+  Histogram m_requestLatencies;
+
   /** the @a UserList instance. */
   UserList m_userList;
 
@@ -429,7 +674,7 @@ class MainLoop : public Thread {
   HttpClient m_httpClient;
 
   /** the reference to the @a Request @a Queue. */
-  Queue<Request*>* m_requestQueue;
+  RingQueue<Request*>* m_requestQueue;
 
   /** the path for HTML files served by the HTTP port. */
   string m_htmlPath;
@@ -439,6 +684,18 @@ class MainLoop : public Thread {
 
   /** the result of the last update check, or empty. */
   string m_updateCheck;
+
+  /** whether to execute bus bound client commands asynchronously. */
+  const bool m_asyncRequests;
+
+  /** the @a Mutex for @a m_asyncPending and @a m_asyncResults. */
+  Mutex m_asyncMutex;
+
+  /** the number of @a ClientBusRequest instances currently handed over to the bus. */
+  unsigned int m_asyncPending;
+
+  /** the results of finished @a ClientBusRequest instances still to be decoded by the main loop thread. */
+  deque<async_result_t*> m_asyncResults;
 };
 
 }  // namespace ebusd
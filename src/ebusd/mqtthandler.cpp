@@ -378,7 +378,7 @@ string removeTrailingNonTopicPart(const string& str) {
 MqttHandler::MqttHandler(UserInfo* userInfo, BusHandler* busHandler, MessageMap* messages)
   : DataSink(userInfo, "mqtt", g_onlyChanges), DataSource(busHandler), WaitThread(),
     m_messages(messages), m_connected(false),
-    m_lastUpdateCheckResult("."), m_lastScanStatus(SCAN_STATUS_NONE) {
+    m_lastUpdateCheckResult("."), m_lastScanStatus(SCAN_STATUS_NONE), m_availabilityChanged(false) {
   m_definitionsSince = 0;
   m_client = nullptr;
   bool hasIntegration = false;
@@ -675,6 +675,11 @@ void MqttHandler::notifyUpdateCheckResult(const string& checkResult) {
   }
 }
 
+void MqttHandler::notifyAvailability(Message* message) {
+  m_availabilityChanged = true;  // publish the definitions of newly available messages soon
+  DataSink::notifyAvailability(message);
+}
+
 void MqttHandler::notifyScanStatus(scanStatus_t scanStatus) {
   if (scanStatus != m_lastScanStatus) {
     m_lastScanStatus = scanStatus;
@@ -761,7 +766,8 @@ void MqttHandler::run() {
         lastSignal -= lastTaskRun-now;
       }
       lastTaskRun = now;
-    } else if (now > lastTaskRun+15) {
+    } else if (now > lastTaskRun+(m_availabilityChanged ? 1 : 15)) {
+      m_availabilityChanged = false;
       allowReconnect = true;
       if (m_connected) {
         sendSignal = true;
@@ -94,6 +94,9 @@ class MqttHandler : public DataSink, public DataSource, public WaitThread, publi
   // @copydoc
   void notifyScanStatus(scanStatus_t scanStatus) override;
 
+  // @copydoc
+  void notifyAvailability(Message* message) override;
+
  protected:
   /**
    * Prepare the message part of a definition topic.
@@ -234,6 +237,9 @@ class MqttHandler : public DataSink, public DataSource, public WaitThread, publi
 
   /** the last scan status. */
   scanStatus_t m_lastScanStatus;
+
+  /** set to true when the availability of a conditional message changed. */
+  bool m_availabilityChanged;
 };
 
 }  // namespace ebusd
@@ -163,7 +163,7 @@ void Connection::run() {
 }
 
 
-Network::Network(const bool local, const uint16_t port, const uint16_t httpPort, Queue<Request*>* requestQueue)
+Network::Network(const bool local, const uint16_t port, const uint16_t httpPort, RingQueue<Request*>* requestQueue)
   : Thread(), m_requestQueue(requestQueue), m_listening(false) {
   m_tcpServer = new TCPServer(port, local ? "127.0.0.1" : "0.0.0.0");
 
@@ -186,7 +186,7 @@ Network::~Network() {
   stop();
   Request* req;
   while ((req = m_requestQueue->pop()) != nullptr) {
-    req->setResult("ERR: shutdown", "", nullptr, 0, true);
+    req->setResult("ERR: shutdown", "", nullptr, 0, 0, true);
   }
   while (!m_connections.empty()) {
     Connection* connection = m_connections.back();
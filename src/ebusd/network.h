@@ -48,7 +48,7 @@ class Connection : public Thread {
    * @param isHttp whether this is a HTTP message.
    * @param requestQueue the reference to the @a Request @a Queue.
    */
-  Connection(TCPSocket* socket, const bool isHttp, Queue<Request*>* requestQueue)
+  Connection(TCPSocket* socket, const bool isHttp, RingQueue<Request*>* requestQueue)
     : Thread(), m_isHttp(isHttp), m_socket(socket), m_requestQueue(requestQueue), m_endedAt(0) {
     m_id = ++m_ids;
   }
@@ -90,7 +90,7 @@ class Connection : public Thread {
   TCPSocket* m_socket;
 
   /** the reference to the @a Request @a Queue. */
-  Queue<Request*>* m_requestQueue;
+  RingQueue<Request*>* m_requestQueue;
 
   /** notification object for shutdown procedure. */
   Notify m_notify;
@@ -117,7 +117,7 @@ class Network : public Thread {
    * @param httpPort the port to listen for HTTP connections, or 0.
    * @param requestQueue the reference to the @a Request @a Queue.
    */
-  Network(const bool local, const uint16_t port, const uint16_t httpPort, Queue<Request*>* requestQueue);
+  Network(const bool local, const uint16_t port, const uint16_t httpPort, RingQueue<Request*>* requestQueue);
 
   /**
    * destructor.
@@ -140,7 +140,7 @@ class Network : public Thread {
   list<Connection*> m_connections;
 
   /** the reference to the @a Request @a Queue. */
-  Queue<Request*>* m_requestQueue;
+  RingQueue<Request*>* m_requestQueue;
 
   /** the command line @a TCPServer instance. */
   TCPServer* m_tcpServer;
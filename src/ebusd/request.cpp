@@ -29,7 +29,8 @@
 namespace ebusd {
 
 RequestImpl::RequestImpl(bool isHttp)
-  : Request(), m_isHttp(isHttp), m_resultSet(false), m_disconnect(false), m_listenSince(0) {
+  : Request(), m_isHttp(isHttp), m_resultSet(false), m_disconnect(false), m_listenSince(0),
+    m_listenSequence(0), m_receivedTime(0) {
   m_mode.listenMode = lm_none;
   m_mode.format = OF_NONE;
   m_mode.listenWithUnknown = false;
@@ -52,6 +53,7 @@ bool RequestImpl::add(const char* request) {
   }
   size_t pos = m_request.find(m_isHttp ? "\n\n" : "\n");
   if (pos != string::npos) {
+    m_receivedTime = clockGetMicros();
     if (m_isHttp) {
       pos = m_request.find("\n");
       m_request.resize(pos);  // reduce to first line
@@ -126,7 +128,7 @@ bool RequestImpl::waitResponse(string* result) {
 }
 
 void RequestImpl::setResult(const string& result, const string& user, RequestMode* mode, time_t listenUntil,
-      bool disconnect) {
+      uint64_t listenSequence, bool disconnect) {
   pthread_mutex_lock(&m_mutex);
   m_result = result;
   m_user = user;
@@ -135,6 +137,7 @@ void RequestImpl::setResult(const string& result, const string& user, RequestMod
     m_mode = *mode;
   }
   m_listenSince = listenUntil;
+  m_listenSequence = listenSequence;
   m_resultSet = true;
   pthread_cond_signal(&m_cond);
   pthread_mutex_unlock(&m_mutex);
@@ -28,6 +28,7 @@
 #include "lib/utils/notify.h"
 #include "lib/utils/thread.h"
 #include "lib/utils/log.h"
+#include "lib/utils/clock.h"
 
 namespace ebusd {
 
@@ -97,6 +98,12 @@ class Request {
    */
   virtual const string& getUser() const = 0;
 
+  /**
+   * Return the time the request was completely received.
+   * @return the time [us] the request was completely received.
+   */
+  virtual uint64_t getReceivedTime() const = 0;
+
   /**
    * Wait for the response being set and return the result string.
    * @param result the variable in which to store the result string.
@@ -110,17 +117,19 @@ class Request {
    * @param user the new user name.
    * @param newMode the new @a RequestMode.
    * @param listenUntil the end time to which to updates were added (exclusive).
+   * @param listenSequence the sequence number of the last message update that was added.
    * @param disconnect true when the client shall be disconnected.
    */
   virtual void setResult(const string& result, const string& user, RequestMode* newMode, time_t listenUntil,
-      bool disconnect) = 0;
+      uint64_t listenSequence, bool disconnect) = 0;
 
   /**
    * Return the @a RequestMode.
    * @param listenSince set listening to the specified start time from which to add updates (inclusive).
+   * @param listenSequence set to the sequence number of the last message update that was added.
    * @return the @a RequestMode.
    */
-  virtual RequestMode getMode(time_t* listenSince = nullptr) = 0;
+  virtual RequestMode getMode(time_t* listenSince = nullptr, uint64_t* listenSequence = nullptr) = 0;
 };
 
 /**
@@ -177,18 +186,24 @@ class RequestImpl : public Request {
   // @copydoc
   const string& getUser() const override { return m_user; }
 
+  // @copydoc
+  uint64_t getReceivedTime() const override { return m_receivedTime; }
+
   // @copydoc
   bool waitResponse(string* result) override;
 
   // @copydoc
   void setResult(const string& result, const string& user, RequestMode* mode, time_t listenUntil,
-      bool disconnect) override;
+      uint64_t listenSequence, bool disconnect) override;
 
   // @copydoc
-  RequestMode getMode(time_t* listenSince = nullptr) override {
+  RequestMode getMode(time_t* listenSince = nullptr, uint64_t* listenSequence = nullptr) override {
     if (listenSince) {
       *listenSince = m_listenSince;
     }
+    if (listenSequence) {
+      *listenSequence = m_listenSequence;
+    }
     return m_mode;
   }
 
@@ -223,6 +238,12 @@ class RequestImpl : public Request {
 
   /** start timestamp of listening update. */
   time_t m_listenSince;
+
+  /** the sequence number of the last message update passed to the listener. */
+  uint64_t m_listenSequence;
+
+  /** the time [us] the request was completely received. */
+  uint64_t m_receivedTime;
 };
 
 }  // namespace ebusd
@@ -268,7 +268,7 @@ static void readMessage(Message* message) {
   if (!executeInstructionsBusHandlerInstance || !message) {
     return;
   }
-  result_t result = executeInstructionsBusHandlerInstance->readFromBus(message, "");
+  result_t result = executeInstructionsBusHandlerInstance->readFromBus(message, "", SYN, SYN, true);
   if (result != RESULT_OK) {
     logError(lf_main, "error reading message %s %s: %s", message->getCircuit().c_str(), message->getName().c_str(),
         getResultCode(result));
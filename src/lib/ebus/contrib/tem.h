@@ -56,6 +56,14 @@ class TemParamDataType : public NumberDataType {
   result_t readSymbols(size_t offset, size_t length, const SymbolString& input,
       const OutputFormat outputFormat, ostream* output) const override;
 
+  // @copydoc
+  result_t readValue(size_t offset, size_t length, const SymbolString& input, data_value_t* value) const override {
+    return DataType::readValue(offset, length, input, value);  // only available as text
+  }
+
+  // @copydoc
+  DecodeOpcode getDecodeOpcode() const override { return do_field; }
+
   // @copydoc
   result_t writeSymbols(size_t offset, size_t length, istringstream* input,
       SymbolString* output, size_t* usedLength) const override;
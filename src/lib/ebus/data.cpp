@@ -121,7 +121,7 @@ void AttributedItem::appendJson(bool prependFieldSeparator, const string& name,
 }
 
 void AttributedItem::mergeAttributes(map<string, string>* attributes) const {
-  for (const auto& entry : m_attributes) {
+  for (const auto& entry : m_attributes->value) {
     const auto it = attributes->find(entry.first);
     if (it == attributes->end() || it->second.empty()) {
       (*attributes)[entry.first] = entry.second;
@@ -140,8 +140,8 @@ void AttributedItem::dumpAttribute(bool prependFieldSeparator, OutputFormat outp
 
 bool AttributedItem::appendAttribute(OutputFormat outputFormat, const string& name, bool onlyIfNonEmpty,
     const string& prefix, const string& suffix, ostream* output) const {
-  const auto it = m_attributes.find(name);
-  string value = it == m_attributes.end() ? "" : it->second;
+  const auto it = m_attributes->value.find(name);
+  string value = it == m_attributes->value.end() ? "" : it->second;
   if (onlyIfNonEmpty && value.empty()) {
     return false;
   }
@@ -162,7 +162,7 @@ bool AttributedItem::appendAttributes(OutputFormat outputFormat, ostream* output
     ret = appendAttribute(outputFormat, "comment", true, "[", "]", output) || ret;
   }
   if (outputFormat & OF_ALL_ATTRS) {
-    for (const auto& entry : m_attributes) {
+    for (const auto& entry : m_attributes->value) {
       ret = true;
       if (!entry.second.empty() && entry.first != "unit" && entry.first != "comment") {
         const string& key = entry.first;
@@ -186,8 +186,78 @@ bool AttributedItem::appendAttributes(OutputFormat outputFormat, ostream* output
 }
 
 string AttributedItem::getAttribute(const string& name) const {
-  const auto it = m_attributes.find(name);
-  return it == m_attributes.end() ? "" : it->second;
+  const auto it = m_attributes->value.find(name);
+  return it == m_attributes->value.end() ? "" : it->second;
+}
+
+/** the estimated number of bytes used by each map node besides the key and value. */
+#define MAP_NODE_OVERHEAD (4*sizeof(void*))
+
+/**
+ * Estimate the number of bytes used by a @a string outside of the instance itself.
+ * @param value the @a string.
+ * @return the estimated number of bytes.
+ */
+static size_t getStringSize(const string& value) {
+  return value.capacity() < sizeof(string) ? 0 : value.capacity() + 1;
+}
+
+/**
+ * Estimate the number of bytes used by a map of attributes.
+ * @param attributes the map of attributes.
+ * @return the estimated number of bytes.
+ */
+static size_t getAttributesSize(const map<string, string>& attributes) {
+  size_t size = sizeof(attributes);
+  for (const auto& it : attributes) {
+    size += MAP_NODE_OVERHEAD + sizeof(it) + getStringSize(it.first) + getStringSize(it.second);
+  }
+  return size;
+}
+
+/**
+ * Estimate the number of bytes used by a map of value=text assignments.
+ * @param values the map of value=text assignments.
+ * @return the estimated number of bytes.
+ */
+static size_t getValuesSize(const map<unsigned int, string>& values) {
+  size_t size = sizeof(values);
+  for (const auto& it : values) {
+    size += MAP_NODE_OVERHEAD + sizeof(it) + getStringSize(it.second);
+  }
+  return size;
+}
+
+InternPool<map<string, string>>* AttributedItem::getAttributePool() {
+  // intentionally never freed as static instances may refer to it until the very end
+  static InternPool<map<string, string>>* pool = new InternPool<map<string, string>>(getAttributesSize);
+  return pool;
+}
+
+InternPool<map<unsigned int, string>>* ValueListDataField::getValuePool() {
+  // intentionally never freed as static instances may refer to it until the very end
+  static InternPool<map<unsigned int, string>>* pool = new InternPool<map<unsigned int, string>>(getValuesSize);
+  return pool;
+}
+
+/**
+ * Format the statistics of an @a InternPool.
+ * @param stats the @a intern_stats_t to format.
+ * @param output the @a ostream to append the statistics to.
+ */
+static void formatInternStats(const intern_stats_t& stats, ostream* output) {
+  *output << stats.entries << " distinct, " << stats.references << " references, " << stats.bytes << " bytes, "
+          << stats.savedBytes << " bytes saved";
+}
+
+void formatInternInfo(ostream* output) {
+  intern_stats_t stats;
+  AttributedItem::getAttributePool()->getStats(&stats);
+  *output << "shared attributes: ";
+  formatInternStats(stats, output);
+  ValueListDataField::getValuePool()->getStats(&stats);
+  *output << "\nshared value lists: ";
+  formatInternStats(stats, output);
 }
 
 
@@ -720,11 +790,64 @@ result_t SingleDataField::write(char separator, size_t offset, istringstream* in
   return writeSymbols(offset, input, data, usedLength);
 }
 
+result_t SingleDataField::readValues(const SymbolString& data, size_t offset, DataValueList* values) const {
+  if (m_partType == pt_any) {
+    return RESULT_ERR_INVALID_PART;
+  }
+  if ((data.isMaster() ? pt_masterData : pt_slaveData) != m_partType) {
+    return RESULT_EMPTY;
+  }
+  bool remainder = m_length == REMAIN_LEN && m_dataType->isAdjustableLength();
+  if (offset + (remainder?1:m_length) > data.getDataSize()) {
+    return RESULT_ERR_INVALID_POS;
+  }
+  if (isIgnored()) {
+    return RESULT_EMPTY;
+  }
+  field_value_t* entry = values->add(this);
+  result_t result = readValue(data, offset, &entry->value);
+  if (result != RESULT_OK) {
+    values->removeLast();
+  }
+  return result;
+}
+
 result_t SingleDataField::readSymbols(const SymbolString& input, size_t offset,
     OutputFormat outputFormat, ostream* output) const {
   return m_dataType->readSymbols(offset, m_length, input, outputFormat, output);
 }
 
+result_t SingleDataField::readValue(const SymbolString& input, size_t offset, data_value_t* value) const {
+  return m_dataType->readValue(offset, m_length, input, value);
+}
+
+void SingleDataField::compile(decode_op_t* op) const {
+  op->field = this;
+  op->numberType = nullptr;
+  op->values = nullptr;
+  op->length = static_cast<uint8_t>(m_length);
+  op->plain = false;
+  if (isIgnored()) {
+    op->opcode = do_ignore;
+    return;
+  }
+  op->opcode = m_dataType->getDecodeOpcode();
+  if (op->opcode == do_field) {
+    return;
+  }
+  const NumberDataType* num = reinterpret_cast<const NumberDataType*>(m_dataType);
+  op->numberType = num;
+  op->reverse = num->hasFlag(REV);
+  op->required = num->hasFlag(REQ);
+  op->shift = static_cast<uint8_t>(num->getFirstBit() > 0 ? num->getFirstBit() : 0);
+  op->mask = num->getBitCount() < 8 ? (1 << num->getBitCount()) - 1 : 0xffffffff;
+  op->replacement = num->getReplacement();
+  op->minValue = num->getMinValue();
+  op->maxValue = num->getMaxValue();
+  op->divisor = num->getDivisor();
+  op->plain = !num->hasFlag(SIG) && !num->hasFlag(EXP);
+}
+
 result_t SingleDataField::writeSymbols(size_t offset, istringstream* input,
     SymbolString* output, size_t* usedLength) const {
   return m_dataType->writeSymbols(offset, m_length, input, output, usedLength);
@@ -840,7 +963,7 @@ result_t ValueListDataField::derive(const string& name, PartType partType, int d
         num, partType, m_length, values));
   } else {
     fields->push_back(new ValueListDataField(useName, *attributes,
-        num, partType, m_length, m_values));
+        num, partType, m_length, m_values->value));
   }
   return RESULT_OK;
 }
@@ -851,13 +974,13 @@ void ValueListDataField::dump(bool prependFieldSeparator, OutputFormat outputFor
   bool first = true;
   if (outputFormat & OF_JSON) {
     *output << ", \"values\": {";
-    for (const auto& it : m_values) {
+    for (const auto& it : m_values->value) {
       appendJson(!first, formatInt(it.first), it.second, true, output);  // TODO optimize?
       first = false;
     }
     *output << " }";
   } else {
-    for (const auto& it : m_values) {
+    for (const auto& it : m_values->value) {
       if (first) {
         first = false;
       } else {
@@ -877,13 +1000,13 @@ result_t ValueListDataField::readSymbols(const SymbolString& input, size_t offse
   if (result != RESULT_OK) {
     return result;
   }
-  const auto it = m_values.find(value);
-  if (it == m_values.end() && value != m_dataType->getReplacement()) {
+  const auto it = m_values->value.find(value);
+  if (it == m_values->value.end() && value != m_dataType->getReplacement()) {
     // fall back to raw value in input
     *output << setw(0) << dec << value;
     return RESULT_OK;
   }
-  if (it == m_values.end()) {
+  if (it == m_values->value.end()) {
     if (outputFormat & OF_JSON) {
       *output << "null";
     } else if (value == m_dataType->getReplacement()) {
@@ -907,6 +1030,33 @@ result_t ValueListDataField::readSymbols(const SymbolString& input, size_t offse
   return RESULT_OK;
 }
 
+result_t ValueListDataField::readValue(const SymbolString& input, size_t offset, data_value_t* value) const {
+  unsigned int rawValue = 0;
+  result_t result = m_dataType->readRawValue(offset, m_length, input, &rawValue);
+  if (result != RESULT_OK) {
+    return result;
+  }
+  value->integer = rawValue;
+  value->number = rawValue;
+  const auto it = m_values->value.find(rawValue);
+  if (it != m_values->value.end()) {
+    value->type = dvt_list;
+    value->text = it->second;
+  } else {
+    // fall back to raw value in input
+    value->type = rawValue == m_dataType->getReplacement() ? dvt_null : dvt_integer;
+    value->text.clear();
+  }
+  return RESULT_OK;
+}
+
+void ValueListDataField::compile(decode_op_t* op) const {
+  SingleDataField::compile(op);
+  if (op->numberType) {
+    op->values = &m_values->value;
+  }
+}
+
 result_t ValueListDataField::writeSymbols(size_t offset, istringstream* input,
     SymbolString* output, size_t* usedLength) const {
   const NumberDataType* numType = reinterpret_cast<const NumberDataType*>(m_dataType);
@@ -916,7 +1066,7 @@ result_t ValueListDataField::writeSymbols(size_t offset, istringstream* input,
     return numType->writeRawValue(numType->getReplacement(), offset, m_length, output, usedLength);
   }
 
-  for (const auto& it : m_values) {
+  for (const auto& it : m_values->value) {
     if (it.second == inputStr) {
       return numType->writeRawValue(it.first, offset, m_length, output, usedLength);
     }
@@ -928,7 +1078,7 @@ result_t ValueListDataField::writeSymbols(size_t offset, istringstream* input,
   if (strEnd == nullptr || strEnd == str || (*strEnd != 0 && *strEnd != '.')) {
     return RESULT_ERR_INVALID_NUM;  // invalid value
   }
-  if (m_values.find(value) != m_values.end()) {
+  if (m_values->value.find(value) != m_values->value.end()) {
     return numType->writeRawValue(value, offset, m_length, output, usedLength);
   }
   return RESULT_ERR_NOTFOUND;  // value assignment not found
@@ -946,7 +1096,7 @@ result_t ConstantDataField::derive(const string& name, PartType partType, int di
     return RESULT_ERR_INVALID_PART;  // cannot create a template from a concrete instance
   }
   string useName = name.empty() ? m_name : name;
-  for (const auto& entry : m_attributes) {  // merge with this attributes
+  for (const auto& entry : m_attributes->value) {  // merge with this attributes
     if ((*attributes)[entry.first].empty()) {
       (*attributes)[entry.first] = entry.second;
     }
@@ -993,6 +1143,24 @@ result_t ConstantDataField::readSymbols(const SymbolString& input, size_t offset
   return RESULT_OK;
 }
 
+result_t ConstantDataField::readValue(const SymbolString& input, size_t offset, data_value_t* value) const {
+  if (m_verify) {
+    ostringstream verified;
+    result_t result = readSymbols(input, offset, OF_NONE, &verified);
+    if (result != RESULT_OK) {
+      return result;
+    }
+  }
+  return SingleDataField::readValue(input, offset, value);
+}
+
+void ConstantDataField::compile(decode_op_t* op) const {
+  SingleDataField::compile(op);
+  if (m_verify && op->opcode != do_ignore) {
+    op->opcode = do_field;  // verification only available through readValue()
+  }
+}
+
 result_t ConstantDataField::writeSymbols(size_t offset, istringstream* input,
     SymbolString* output, size_t* usedLength) const {
   istringstream cinput(m_value);
@@ -1000,10 +1168,21 @@ result_t ConstantDataField::writeSymbols(size_t offset, istringstream* input,
 }
 
 
+field_value_t* DataValueList::add(const SingleDataField* field) {
+  if (m_count == m_values.size()) {
+    m_values.resize(m_count + 1);
+  }
+  field_value_t* entry = &m_values[m_count++];
+  entry->field = field;
+  return entry;
+}
+
+
 DataFieldSet* DataFieldSet::s_identFields = nullptr;
 
 DataFieldSet* DataFieldSet::getIdentFields() {
   if (s_identFields == nullptr) {
+    ArenaScope heap(nullptr);  // the shared instance outlives any loaded definitions
     const NumberDataType* uchDataType = reinterpret_cast<const NumberDataType*>(
         DataTypeList::getInstance()->get("UCH"));
     const StringDataType* stringDataType = reinterpret_cast<const StringDataType*>(
@@ -1266,6 +1445,272 @@ result_t DataFieldSet::read(const SymbolString& data, size_t offset,
   return RESULT_OK;
 }
 
+result_t DataFieldSet::readValues(const SymbolString& data, size_t offset, DataValueList* values) const {
+  bool previousFullByteOffset = true, found = false;
+  int16_t previousFirstBit = -1;
+  PartType partType = data.isMaster() ? pt_masterData : pt_slaveData;
+  for (const auto field : m_fields) {
+    if (field->getPartType() != partType) {
+      continue;
+    }
+    if (!previousFullByteOffset && !field->hasFullByteOffset(false, previousFirstBit)) {
+      offset--;
+    }
+    result_t result = field->readValues(data, offset, values);
+    if (result < RESULT_OK) {
+      return result;
+    }
+    offset += field->getLength(partType, data.getDataSize()-offset);
+    previousFullByteOffset = field->hasFullByteOffset(true, previousFirstBit);
+    if (result != RESULT_EMPTY) {
+      found = true;
+    }
+  }
+  return found ? RESULT_OK : RESULT_EMPTY;
+}
+
+bool DecodeProgram::compile(const DataField* fields) {
+  m_masterOps.clear();
+  m_slaveOps.clear();
+  size_t offsets[] = { 0, 0, 0, 0 };
+  bool previousFullByteOffset[] = { true, true, true, true };
+  int16_t previousFirstBit[] = { -1, -1, -1, -1 };
+  m_compiled = true;
+  if (fields->isSet()) {
+    const DataFieldSet* set = static_cast<const DataFieldSet*>(fields);
+    for (size_t index = 0; m_compiled && index < set->size(); index++) {
+      m_compiled = add((*set)[index], offsets, previousFullByteOffset, previousFirstBit);
+    }
+  } else {
+    const SingleDataField* field = static_cast<const SingleDataField*>(fields);
+    m_compiled = field->getPartType() != pt_any && add(field, offsets, previousFullByteOffset, previousFirstBit);
+  }
+  if (!m_compiled) {
+    m_masterOps.clear();
+    m_slaveOps.clear();
+  }
+  return m_compiled;
+}
+
+bool DecodeProgram::add(const SingleDataField* field, size_t* offsets, bool* previousFullByteOffset,
+    int16_t* previousFirstBit) {
+  PartType partType = field->getPartType();
+  if (partType != pt_masterData && partType != pt_slaveData) {
+    return true;  // never read within a set
+  }
+  size_t length = field->getLength(partType, REMAIN_LEN);
+  if (length == REMAIN_LEN) {
+    return false;  // subsequent offsets depend on the data
+  }
+  if (!previousFullByteOffset[partType] && !field->hasFullByteOffset(false, previousFirstBit[partType])) {
+    offsets[partType]--;
+  }
+  decode_op_t op;
+  field->compile(&op);
+  if (offsets[partType] > 0xff) {
+    return false;
+  }
+  op.offset = static_cast<uint8_t>(offsets[partType]);
+  (partType == pt_masterData ? m_masterOps : m_slaveOps).push_back(op);
+  offsets[partType] += length;
+  previousFullByteOffset[partType] = field->hasFullByteOffset(true, previousFirstBit[partType]);
+  return true;
+}
+
+result_t DecodeProgram::execute(const SymbolString& data, size_t offset, DataValueList* values) const {
+  const vector<decode_op_t>& ops = data.isMaster() ? m_masterOps : m_slaveOps;
+  size_t dataSize = data.getDataSize();
+  bool found = false;
+  for (const auto& op : ops) {
+    size_t pos = offset + op.offset;
+    if (pos + op.length > dataSize) {
+      return RESULT_ERR_INVALID_POS;
+    }
+    result_t result;
+    if (op.opcode == do_ignore) {
+      continue;
+    }
+    if (op.opcode == do_field) {
+      result = op.field->readValues(data, pos, values);
+      if (result < RESULT_OK) {
+        return result;
+      }
+      if (result != RESULT_EMPTY) {
+        found = true;
+      }
+      continue;
+    }
+    // same as NumberDataType::readRawValue()
+    unsigned int raw = 0;
+    bool replaced = false;
+    int incr = op.reverse ? -1 : 1;
+    size_t index = op.reverse ? pos + op.length - 1 : pos;
+    if (op.opcode == do_binary) {
+      for (unsigned int i = 0, shift = 0; i < op.length; i++, index += incr, shift += 8) {
+        raw |= static_cast<unsigned int>(data.dataAt(index)) << shift;
+      }
+    } else {
+      unsigned int exp = 1;
+      for (unsigned int i = 0; i < op.length; i++, index += incr, exp *= 100) {
+        symbol_t symbol = data.dataAt(index);
+        if (!op.required && symbol == (op.replacement & 0xff)) {
+          raw = op.replacement;
+          replaced = true;
+          break;
+        }
+        if (op.opcode == do_bcd) {
+          if ((symbol & 0xf0) > 0x90 || (symbol & 0x0f) > 0x09) {
+            return RESULT_ERR_OUT_OF_RANGE;  // invalid BCD
+          }
+          symbol = (symbol_t)((symbol >> 4) * 10 + (symbol & 0x0f));
+        } else if (symbol > 0x63) {
+          return RESULT_ERR_OUT_OF_RANGE;  // invalid HCD
+        }
+        raw += symbol * exp;
+      }
+    }
+    if (!replaced) {
+      raw = (raw >> op.shift) & op.mask;
+    }
+    field_value_t* entry = values->add(op.field);
+    data_value_t* value = &entry->value;
+    if (op.values) {
+      // same as ValueListDataField::readValue()
+      value->integer = raw;
+      value->number = raw;
+      const auto it = op.values->find(raw);
+      if (it != op.values->end()) {
+        value->type = dvt_list;
+        value->text = it->second;
+      } else {
+        value->type = raw == op.replacement ? dvt_null : dvt_integer;
+        value->text.clear();
+      }
+      found = true;
+      continue;
+    }
+    if (!op.plain) {
+      result = op.numberType->getValueFromRawValue(raw, value);
+      if (result != RESULT_OK) {
+        values->removeLast();
+        return result;
+      }
+      found = true;
+      continue;
+    }
+    // same as NumberDataType::getValueFromRawValue() for unsigned values
+    value->text.clear();
+    if (!op.required && raw == op.replacement) {
+      value->type = dvt_null;
+      value->integer = 0;
+      value->number = 0;
+    } else if (raw < op.minValue || raw > op.maxValue) {
+      values->removeLast();
+      return RESULT_ERR_OUT_OF_RANGE;
+    } else if (op.divisor > 1) {
+      value->type = dvt_number;
+      value->integer = 0;
+      value->number = static_cast<double>(raw) / static_cast<double>(op.divisor);
+    } else {
+      value->type = dvt_integer;
+      value->integer = op.divisor < 0 ? static_cast<int64_t>(raw) * -op.divisor : static_cast<int64_t>(raw);
+      value->number = static_cast<double>(value->integer);
+    }
+    found = true;
+  }
+  return found ? RESULT_OK : RESULT_EMPTY;
+}
+
+result_t DecodeProgram::decodeColumn(const SingleDataField* field, const SymbolString* const* data, size_t count,
+    size_t offset, double* output) const {
+  const decode_op_t* found = nullptr;
+  for (const auto ops : {&m_masterOps, &m_slaveOps}) {
+    for (const auto& op : *ops) {
+      if (found) {
+        break;
+      }
+      if (op.field == field) {
+        found = &op;
+      }
+    }
+  }
+  if (!found || !found->numberType) {
+    return RESULT_ERR_INVALID_ARG;
+  }
+  // hoist everything from the per value loop
+  const decode_op_t& op = *found;
+  const NumberDataType* num = op.numberType;
+  const bool binary = op.opcode == do_binary, hcd = op.opcode == do_hcd;
+  const bool exponent = num->hasFlag(EXP), sign = num->hasFlag(SIG) && !exponent;
+  const unsigned int signShift = 32 - static_cast<unsigned int>(num->getBitCount());
+  const int64_t minSigned = static_cast<int32_t>(num->getMinValue() << signShift) >> signShift;
+  const int64_t maxSigned = static_cast<int32_t>(num->getMaxValue() << signShift) >> signShift;
+  const double divisor = op.divisor > 1 ? static_cast<double>(op.divisor) : 1.0;
+  const int64_t factor = op.divisor < 0 ? -op.divisor : 1;
+  const symbol_t replacementSymbol = op.required ? 0 : static_cast<symbol_t>(op.replacement & 0xff);
+  const size_t first = offset + op.offset, last = first + op.length - 1;
+  const size_t start = op.reverse ? last : first;
+  const int incr = op.reverse ? -1 : 1;
+  const size_t end = last + 1;
+  DataValueList values;
+  for (size_t row = 0; row < count; row++) {
+    const SymbolString& input = *data[row];
+    if (input.getDataSize() < end) {
+      output[row] = NAN;
+      continue;
+    }
+    unsigned int raw = 0;
+    size_t index = start;
+    if (binary) {
+      for (unsigned int i = 0, shift = 0; i < op.length; i++, index += incr, shift += 8) {
+        raw |= static_cast<unsigned int>(input.dataAt(index)) << shift;
+      }
+    } else {
+      // branch free BCD/HCD: collect replacement and invalid symbols and decide afterwards
+      bool replaced = false, invalid = false;
+      for (unsigned int i = 0, exp100 = 1; i < op.length; i++, index += incr, exp100 *= 100) {
+        unsigned int symbol = input.dataAt(index);
+        replaced |= !op.required && symbol == replacementSymbol;
+        if (hcd) {
+          invalid |= symbol > 0x63;
+        } else {
+          invalid |= (symbol & 0xf0) > 0x90 || (symbol & 0x0f) > 0x09;
+          symbol = (symbol >> 4) * 10 + (symbol & 0x0f);
+        }
+        raw += symbol * exp100;
+      }
+      if (replaced || invalid) {
+        output[row] = NAN;
+        continue;
+      }
+    }
+    raw = (raw >> op.shift) & op.mask;
+    if (op.values) {
+      output[row] = raw == op.replacement && op.values->find(raw) == op.values->end()
+        ? NAN : static_cast<double>(raw);
+      continue;
+    }
+    if (exponent) {
+      values.clear();
+      data_value_t* value = &values.add(field)->value;
+      output[row] = num->getValueFromRawValue(raw, value) == RESULT_OK && value->type == dvt_number
+        ? value->number : NAN;
+      continue;
+    }
+    int64_t signedValue = sign ? static_cast<int32_t>(raw << signShift) >> signShift : static_cast<int64_t>(raw);
+    bool outOfRange = sign ? signedValue < minSigned || signedValue > maxSigned
+      : raw < op.minValue || raw > op.maxValue;
+    if ((!op.required && raw == op.replacement) || outOfRange) {
+      output[row] = NAN;
+    } else if (op.divisor > 1) {
+      output[row] = static_cast<double>(signedValue) / divisor;
+    } else {
+      output[row] = static_cast<double>(signedValue * factor);
+    }
+  }
+  return RESULT_OK;
+}
+
 result_t DataFieldSet::write(char separator, size_t offset, istringstream* input,
     SymbolString* data, size_t* usedLength) const {
   string token;
@@ -30,6 +30,8 @@
 #include "lib/ebus/result.h"
 #include "lib/ebus/filereader.h"
 #include "lib/ebus/datatype.h"
+#include "lib/utils/arena.h"
+#include "lib/utils/intern.h"
 
 namespace ebusd {
 
@@ -53,10 +55,96 @@ namespace ebusd {
 class DataFieldTemplates;
 class SingleDataField;
 
+/**
+ * A typed value of a single field decoded by @a DataField#readValues().
+ */
+typedef struct field_value {
+  const SingleDataField* field;  //!< the decoded @a SingleDataField
+  data_value_t value;            //!< the decoded value
+} field_value_t;
+
+/**
+ * A single operation of a compiled field decoder (see @a DecodeProgram).
+ */
+typedef struct decode_op {
+  DecodeOpcode opcode;                      //!< the base type opcode
+  bool reverse;                             //!< whether the most significant byte comes first
+  bool required;                            //!< whether the replacement value is a regular value
+  uint8_t offset;                           //!< the offset in the data part
+  uint8_t length;                           //!< the number of symbols
+  uint8_t shift;                            //!< the number of bits to shift the raw value right
+  unsigned int mask;                        //!< the bit mask to apply to the shifted raw value
+  unsigned int replacement;                 //!< the replacement value
+  unsigned int minValue;                    //!< the minimum raw value (only for @a plain)
+  unsigned int maxValue;                    //!< the maximum raw value (only for @a plain)
+  int divisor;                              //!< the divisor (negative for multiplier, only for @a plain)
+  bool plain;                               //!< whether the raw value is unsigned without exponent
+  const SingleDataField* field;             //!< the @a SingleDataField being decoded
+  const NumberDataType* numberType;         //!< the @a NumberDataType for converting non-plain values
+  const map<unsigned int, string>* values;  //!< the value list, or nullptr
+} decode_op_t;
+
+/**
+ * A reusable list of typed field values that keeps its entries (including the allocated text) when being cleared.
+ */
+class DataValueList {
+ public:
+  /**
+   * Constructor.
+   */
+  DataValueList() : m_count(0) {}
+
+  /**
+   * Remove all values while keeping the allocated entries.
+   */
+  void clear() { m_count = 0; }
+
+  /**
+   * @return the number of values.
+   */
+  size_t size() const { return m_count; }
+
+  /**
+   * @return true when there are no values.
+   */
+  bool empty() const { return m_count == 0; }
+
+  /**
+   * Get a value.
+   * @param index the index of the value.
+   * @return the @a field_value_t at the index.
+   */
+  const field_value_t& operator[](size_t index) const { return m_values[index]; }
+
+  /**
+   * Add a value entry to fill.
+   * @param field the @a SingleDataField the value belongs to.
+   * @return the added @a field_value_t (reused from a previous run if possible).
+   */
+  field_value_t* add(const SingleDataField* field);
+
+  /**
+   * Remove the last added value entry.
+   */
+  void removeLast() {
+    if (m_count > 0) {
+      m_count--;
+    }
+  }
+
+
+ private:
+  /** the allocated value entries. */
+  vector<field_value_t> m_values;
+
+  /** the number of used entries in @a m_values. */
+  size_t m_count;
+};
+
 /**
  * Base class for named items with optional named attributes.
  */
-class AttributedItem {
+class AttributedItem : public ArenaObject {
  public:
   /**
    * Constructs a new instance.
@@ -64,19 +152,31 @@ class AttributedItem {
    * @param attributes the additional named attributes.
    */
   AttributedItem(const string& name, const map<string, string>& attributes)
-    : m_name(name), m_attributes(attributes) {}
+    : m_name(name), m_attributes(getAttributePool()->acquire(attributes)) {}
 
   /**
    * Constructs a new instance (without additional attributes).
    * @param name the field name.
    */
   explicit AttributedItem(const string& name)
-    : m_name(name) {}
+    : m_name(name), m_attributes(getAttributePool()->getEmpty()) {}
+
+  /**
+   * Copy constructor.
+   * @param src the object to copy from.
+   */
+  AttributedItem(const AttributedItem& src)
+    : m_name(src.m_name), m_attributes(getAttributePool()->acquire(src.m_attributes)) {}
 
   /**
    * Destructor.
    */
-  virtual ~AttributedItem() {}
+  virtual ~AttributedItem() { getAttributePool()->release(m_attributes); }
+
+  /**
+   * @return the @a InternPool sharing the additional named attributes of all instances.
+   */
+  static InternPool<map<string, string>>* getAttributePool();
 
 
   /**
@@ -167,11 +267,18 @@ class AttributedItem {
   /** the field name. */
   const string m_name;
 
-  /** the additional named attributes. */
-  const map<string, string> m_attributes;
+  /** the additional named attributes (shared via @a getAttributePool()). */
+  InternPool<map<string, string>>::entry_t* const m_attributes;
 };
 
 
+/**
+ * Format the statistics of the attributes and value lists shared between all fields and messages.
+ * @param output the @a ostream to append the statistics to.
+ */
+void formatInternInfo(ostream* output);
+
+
 /**
  * Base class for all kinds of data fields.
  */
@@ -359,6 +466,17 @@ class DataField : public AttributedItem {
     bool leadingSeparator, const char* fieldName, ssize_t fieldIndex,
     OutputFormat outputFormat, ssize_t outputIndex, ostream* output) const = 0;
 
+  /**
+   * Reads the typed values of all non-ignored fields in the part of the @a SymbolString.
+   * @param data the data @a SymbolString for reading binary data.
+   * @param offset the additional offset to add for reading binary data.
+   * @param values the @a DataValueList to append the typed values to.
+   * @return @a RESULT_OK on success,
+   * or @a RESULT_EMPTY if no field was read (either if the partType does not match or all fields are ignored),
+   * or an error code.
+   */
+  virtual result_t readValues(const SymbolString& data, size_t offset, DataValueList* values) const = 0;
+
   /**
    * Writes the value to the master or slave @a SymbolString.
    * @param input the @a istringstream to parse the formatted value from.
@@ -471,6 +589,12 @@ class SingleDataField : public DataField {
    */
   const DataType* getDataType() const { return m_dataType; }
 
+  /**
+   * Fill the operation for decoding this field in a compiled field decoder (except for the offset).
+   * @param op the @a decode_op_t to fill.
+   */
+  virtual void compile(decode_op_t* op) const;
+
   /**
    * Dump the common prefix field settings to the output (name and part type).
    * @param prependFieldSeparator whether to start with a @a FIELD_SEPARATOR.
@@ -501,6 +625,9 @@ class SingleDataField : public DataField {
       bool leadingSeparator, const char* fieldName, ssize_t fieldIndex,
       OutputFormat outputFormat, ssize_t outputIndex, ostream* output) const override;
 
+  // @copydoc
+  result_t readValues(const SymbolString& data, size_t offset, DataValueList* values) const override;
+
   // @copydoc
   result_t write(char separator, size_t offset, istringstream* input,
       SymbolString* data, size_t* usedLength) const override;
@@ -518,6 +645,15 @@ class SingleDataField : public DataField {
   virtual result_t readSymbols(const SymbolString& input, size_t offset,
       OutputFormat outputFormat, ostream* output) const;
 
+  /**
+   * Internal method for reading the typed value of the field from a @a SymbolString.
+   * @param input the @a SymbolString to read the binary value from.
+   * @param offset the offset in the @a SymbolString.
+   * @param value the @a data_value_t to fill.
+   * @return @a RESULT_OK on success, or an error code.
+   */
+  virtual result_t readValue(const SymbolString& input, size_t offset, data_value_t* value) const;
+
   /**
    * Internal method for writing the field to a @a SymbolString.
    * @param input the @a istringstream to parse the formatted value from.
@@ -557,12 +693,24 @@ class ValueListDataField : public SingleDataField {
   ValueListDataField(const string& name, const map<string, string>& attributes, const DataType* dataType,
     PartType partType, size_t length, const map<unsigned int, string>& values)
     : SingleDataField(name, attributes, dataType, partType, length),
-    m_values(values) {}
+    m_values(getValuePool()->acquire(values)) {}
+
+  /**
+   * Copy constructor.
+   * @param src the object to copy from.
+   */
+  ValueListDataField(const ValueListDataField& src)
+    : SingleDataField(src), m_values(getValuePool()->acquire(src.m_values)) {}
 
   /**
    * Destructor.
    */
-  virtual ~ValueListDataField() {}
+  virtual ~ValueListDataField() { getValuePool()->release(m_values); }
+
+  /**
+   * @return the @a InternPool sharing the value=text assignments of all instances.
+   */
+  static InternPool<map<unsigned int, string>>* getValuePool();
 
   // @copydoc
   const ValueListDataField* clone() const override;
@@ -581,21 +729,27 @@ class ValueListDataField : public SingleDataField {
   /**
    * @return the value=text assignments.
    */
-  const map<unsigned int, string>& getList() const { return m_values; }
+  const map<unsigned int, string>& getList() const { return m_values->value; }
+
+  // @copydoc
+  void compile(decode_op_t* op) const override;
 
  protected:
   // @copydoc
   result_t readSymbols(const SymbolString& input, size_t offset,
       const OutputFormat outputFormat, ostream* output) const override;
 
+  // @copydoc
+  result_t readValue(const SymbolString& input, size_t offset, data_value_t* value) const override;
+
   // @copydoc
   result_t writeSymbols(size_t offset, istringstream* input,
       SymbolString* output, size_t* usedLength) const override;
 
 
  private:
-  /** the value=text assignments. */
-  const map<unsigned int, string> m_values;
+  /** the value=text assignments (shared via @a getValuePool()). */
+  InternPool<map<unsigned int, string>>::entry_t* const m_values;
 };
 
 
@@ -635,12 +789,18 @@ class ConstantDataField : public SingleDataField {
   // @copydoc
   void dump(bool prependFieldSeparator, OutputFormat outputFormat, ostream* output) const override;
 
+  // @copydoc
+  void compile(decode_op_t* op) const override;
+
 
  protected:
   // @copydoc
   result_t readSymbols(const SymbolString& input, size_t offset,
       const OutputFormat outputFormat, ostream* output) const override;
 
+  // @copydoc
+  result_t readValue(const SymbolString& input, size_t offset, data_value_t* value) const override;
+
   // @copydoc
   result_t writeSymbols(size_t offset, istringstream* input,
       SymbolString* output, size_t* usedLength) const override;
@@ -762,6 +922,9 @@ class DataFieldSet : public DataField {
       bool leadingSeparator, const char* fieldName, ssize_t fieldIndex,
       OutputFormat outputFormat, ssize_t outputIndex, ostream* output) const override;
 
+  // @copydoc
+  result_t readValues(const SymbolString& data, size_t offset, DataValueList* values) const override;
+
   // @copydoc
   result_t write(char separator, size_t offset, istringstream* input,
       SymbolString* data, size_t* usedLength) const override;
@@ -783,6 +946,80 @@ class DataFieldSet : public DataField {
 };
 
 
+/**
+ * A compiled field decoder: a flat list of operations per data part with precalculated offsets that is executed
+ * without walking the @a DataField hierarchy. Fields having no opcode are still decoded through their
+ * @a DataField#readValues() at the precalculated offset.
+ */
+class DecodeProgram {
+ public:
+  /**
+   * Constructor.
+   */
+  DecodeProgram() : m_compiled(false) {}
+
+  /**
+   * Compile the fields.
+   * @param fields the @a DataField (set) to compile.
+   * @return true when the fields could be compiled, false when they have to be decoded through
+   * @a DataField#readValues() (e.g. for variable length fields).
+   */
+  bool compile(const DataField* fields);
+
+  /**
+   * @return whether the fields were successfully compiled.
+   */
+  bool isCompiled() const { return m_compiled; }
+
+  /**
+   * Execute the program on the part of the @a SymbolString.
+   * This is equivalent to @a DataField#readValues() on the compiled fields.
+   * @param data the data @a SymbolString for reading binary data.
+   * @param offset the additional offset to add for reading binary data.
+   * @param values the @a DataValueList to append the typed values to.
+   * @return @a RESULT_OK on success,
+   * or @a RESULT_EMPTY if no field was read (either if the partType does not match or all fields are ignored),
+   * or an error code.
+   */
+  result_t execute(const SymbolString& data, size_t offset, DataValueList* values) const;
+
+  /**
+   * Decode the numeric values of a single field from many telegrams of the same definition at once.
+   * This is meant for bulk workloads like exports of stored telegrams.
+   * @param field the compiled numeric @a SingleDataField to decode.
+   * @param data the data @a SymbolString instances of the part of the field.
+   * @param count the number of @a SymbolString instances in @a data.
+   * @param offset the additional offset to add for reading binary data.
+   * @param output the array of @a count numbers to fill with the values having the divisor applied
+   * (NaN for the replacement value or invalid data).
+   * @return @a RESULT_OK on success, or @a RESULT_ERR_INVALID_ARG if the field is not compiled as numeric field.
+   */
+  result_t decodeColumn(const SingleDataField* field, const SymbolString* const* data, size_t count,
+      size_t offset, double* output) const;
+
+
+ private:
+  /**
+   * Add the field to the program.
+   * @param field the @a SingleDataField to add.
+   * @param offsets the offset for each part type to update.
+   * @param previousFullByteOffset whether the previous field ended on a full byte for each part type.
+   * @param previousFirstBit the first bit of the previous field for each part type.
+   * @return true on success, false if the field can not be compiled.
+   */
+  bool add(const SingleDataField* field, size_t* offsets, bool* previousFullByteOffset, int16_t* previousFirstBit);
+
+  /** whether the fields were successfully compiled. */
+  bool m_compiled;
+
+  /** the operations for the master data. */
+  vector<decode_op_t> m_masterOps;
+
+  /** the operations for the slave data. */
+  vector<decode_op_t> m_slaveOps;
+};
+
+
 /**
  * A special @a DataFieldSet that supports loading via @a MappedFileReader.
  */
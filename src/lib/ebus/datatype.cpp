@@ -156,6 +156,19 @@ bool DataType::dump(OutputFormat outputFormat, size_t length, AppendDivisor appe
   return false;
 }
 
+result_t DataType::readValue(size_t offset, size_t length, const SymbolString& input, data_value_t* value) const {
+  ostringstream output;
+  result_t result = readSymbols(offset, length, input, OF_NONE, &output);
+  if (result != RESULT_OK) {
+    return result;
+  }
+  value->type = dvt_string;
+  value->integer = 0;
+  value->number = 0;
+  value->text = output.str();
+  return RESULT_OK;
+}
+
 
 bool StringDataType::dump(OutputFormat outputFormat, size_t length, AppendDivisor appendDivisor, ostream* output
 ) const {
@@ -172,6 +185,29 @@ result_t StringDataType::readRawValue(size_t, size_t, const SymbolString&, unsig
 
 result_t StringDataType::readSymbols(size_t offset, size_t length, const SymbolString& input,
                                      OutputFormat outputFormat, ostream* output) const {
+  data_value_t value;
+  result_t result = readValue(offset, length, input, &value);
+  if (result != RESULT_OK) {
+    return result;
+  }
+  if (!(outputFormat & OF_JSON)) {
+    *output << value.text;
+    return RESULT_OK;
+  }
+  *output << '"';
+  for (const auto ch : value.text) {
+    if (ch == '"' || ch == '\\') {
+      *output << '\\';  // escape
+    }
+    *output << ch;
+  }
+  *output << '"';
+  return RESULT_OK;
+}
+
+result_t StringDataType::readValue(size_t offset, size_t length, const SymbolString& input,
+                                   data_value_t* value) const {
+  static const char* hexDigits = "0123456789abcdef";
   size_t start = 0, count = length;
   int incr = 1;
   symbol_t symbol;
@@ -185,38 +221,29 @@ result_t StringDataType::readSymbols(size_t offset, size_t length, const SymbolS
     start = length - 1;
     incr = -1;
   }
-
-  if (outputFormat & OF_JSON) {
-    *output << '"';
-  }
-  *output << setfill('0') << (m_isHex ? hex : dec);
+  value->type = dvt_string;
+  value->integer = 0;
+  value->number = 0;
+  value->text.clear();
   for (size_t index = start, i = 0; i < count; index += incr, i++) {
     symbol = input.dataAt(offset + index);
     if (m_isHex) {
       if (i > 0) {
-        *output << ' ';
+        value->text.push_back(' ');
       }
-      *output << setw(2) << static_cast<unsigned>(symbol);
-    } else {
-      if (symbol == 0x00) {
-        terminated = true;
-      } else if (!terminated) {
-        if (symbol < 0x20) {
-          symbol = (symbol_t)m_replacement;
-        } else if (!isprint(symbol)) {
-          symbol = '?';
-        } else if (outputFormat & OF_JSON) {
-          if (symbol == '"' || symbol == '\\') {
-            *output << '\\';  // escape
-          }
-        }
-        *output << static_cast<char>(symbol);
+      value->text.push_back(hexDigits[symbol >> 4]);
+      value->text.push_back(hexDigits[symbol & 0x0f]);
+    } else if (symbol == 0x00) {
+      terminated = true;
+    } else if (!terminated) {
+      if (symbol < 0x20) {
+        symbol = (symbol_t)m_replacement;
+      } else if (!isprint(symbol)) {
+        symbol = '?';
       }
+      value->text.push_back(static_cast<char>(symbol));
     }
   }
-  if (outputFormat & OF_JSON) {
-    *output << '"';
-  }
   return RESULT_OK;
 }
 
@@ -473,6 +500,20 @@ result_t DateTimeDataType::readSymbols(size_t offset, size_t length, const Symbo
   return RESULT_OK;
 }
 
+result_t DateTimeDataType::readValue(size_t offset, size_t length, const SymbolString& input,
+                                     data_value_t* value) const {
+  result_t result = DataType::readValue(offset, length, input, value);
+  if (result != RESULT_OK) {
+    return result;
+  }
+  if (value->text.find_first_of("0123456789") == string::npos) {
+    value->type = dvt_null;  // only replacement values
+  } else {
+    value->type = m_hasDate ? m_hasTime ? dvt_datetime : dvt_date : dvt_time;
+  }
+  return RESULT_OK;
+}
+
 result_t DateTimeDataType::writeSymbols(size_t offset, size_t length, istringstream* input,
                                         SymbolString* output, size_t* usedLength) const {
   size_t start = 0, count = length;
@@ -932,6 +973,69 @@ result_t NumberDataType::readSymbols(size_t offset, size_t length, const SymbolS
   return readFromRawValue(value, outputFormat, output);
 }
 
+result_t NumberDataType::readValue(size_t offset, size_t length, const SymbolString& input,
+                                   data_value_t* value) const {
+  unsigned int rawValue = 0;
+  result_t result = readRawValue(offset, length, input, &rawValue);
+  if (result != RESULT_OK) {
+    return result;
+  }
+  return getValueFromRawValue(rawValue, value);
+}
+
+result_t NumberDataType::getValueFromRawValue(unsigned int value, data_value_t* output) const {
+  output->integer = 0;
+  output->number = 0;
+  output->text.clear();
+  if (!hasFlag(REQ) && value == m_replacement) {
+    output->type = dvt_null;
+    return RESULT_OK;
+  }
+  bool negative = false;
+  result_t ret = checkValueRange(value, &negative);
+  if (ret != RESULT_OK) {
+    return ret;
+  }
+  int64_t signedValue;
+  if (m_bitCount == 32) {
+    if (hasFlag(EXP)) {  // IEEE 754 binary32
+      float val = uintToFloat(value, negative);
+      if (!isfinite(val)) {
+        output->type = dvt_null;
+        return RESULT_OK;
+      }
+      if (val != 0.0) {
+        if (m_divisor < 0) {
+          val *= static_cast<float>(-m_divisor);
+          if (!isfinite(val)) {
+            // reached beyond infinity
+            return RESULT_ERR_OUT_OF_RANGE;
+          }
+        } else if (m_divisor > 1) {
+          val /= static_cast<float>(m_divisor);
+        }
+      }
+      output->type = dvt_number;
+      output->number = static_cast<double>(val);
+      return RESULT_OK;
+    }
+    signedValue = negative ? static_cast<int>(value) : static_cast<int64_t>(value);
+  } else if (negative) {  // negative signed value
+    signedValue = static_cast<int>(value) - (1 << m_bitCount);
+  } else {
+    signedValue = static_cast<int>(value);
+  }
+  if (m_divisor > 1) {
+    output->type = dvt_number;
+    output->number = static_cast<double>(signedValue) / static_cast<double>(m_divisor);
+    return RESULT_OK;
+  }
+  output->type = dvt_integer;
+  output->integer = m_divisor < 0 ? signedValue * -m_divisor : signedValue;
+  output->number = static_cast<double>(output->integer);
+  return RESULT_OK;
+}
+
 result_t NumberDataType::getFloatFromRawValue(unsigned int value, float* output) const {
   if (!hasFlag(REQ) && value == m_replacement) {
     return RESULT_EMPTY;
@@ -228,6 +228,37 @@ float uint16ToFloat(uint16_t value);
  */
 uint16_t floatToUint16(float value);
 
+/** the kinds of typed values decoded by @a DataType#readValue(). */
+enum DataValueType {
+  dvt_null,      //!< no value (replacement value)
+  dvt_integer,   //!< integer number without fraction
+  dvt_number,    //!< fixed or floating point number with divisor applied
+  dvt_string,    //!< string or hex sequence
+  dvt_date,      //!< date
+  dvt_time,      //!< time
+  dvt_datetime,  //!< date and time
+  dvt_list,      //!< index into a value list along with its label
+};
+
+/**
+ * A typed value decoded by @a DataType#readValue().
+ */
+typedef struct data_value {
+  DataValueType type;  //!< the kind of value
+  int64_t integer;     //!< the integer value (@a dvt_integer), or the raw value (@a dvt_list)
+  double number;       //!< the number with divisor applied (@a dvt_number and @a dvt_integer)
+  string text;         //!< the formatted text (@a dvt_string, date/time), or the label (@a dvt_list)
+} data_value_t;
+
+/** the base type opcodes of a compiled field decoder (see @a DecodeProgram). */
+enum DecodeOpcode {
+  do_field,   //!< no opcode available, decode through the field itself
+  do_ignore,  //!< ignored field, only check the position
+  do_binary,  //!< binary number
+  do_bcd,     //!< BCD number
+  do_hcd,     //!< HCD number
+};
+
 /**
  * Base class for all kinds of data types.
  */
@@ -321,6 +352,23 @@ class DataType {
   virtual result_t readSymbols(size_t offset, size_t length, const SymbolString& input,
       OutputFormat outputFormat, ostream* output) const = 0;
 
+  /**
+   * Internal method for reading the typed value from a @a SymbolString.
+   * The default implementation stores the text formatted by @a readSymbols() as @a dvt_string.
+   * @param offset the offset in the data of the @a SymbolString.
+   * @param length the number of symbols to read.
+   * @param input the @a SymbolString to read the binary value from.
+   * @param value the @a data_value_t to fill (the text keeps its allocated capacity for reuse).
+   * @return @a RESULT_OK on success, or an error code.
+   */
+  virtual result_t readValue(size_t offset, size_t length, const SymbolString& input, data_value_t* value) const;
+
+  /**
+   * Get the opcode for decoding this type in a compiled field decoder.
+   * @return the @a DecodeOpcode, or @a do_field if decoding is only available through @a readValue().
+   */
+  virtual DecodeOpcode getDecodeOpcode() const { return do_field; }
+
   /**
    * Internal method for writing the field to a @a SymbolString.
    * @param offset the offset in the @a SymbolString.
@@ -383,6 +431,9 @@ class StringDataType : public DataType {
   result_t readSymbols(size_t offset, size_t length, const SymbolString& input,
       OutputFormat outputFormat, ostream* output) const override;
 
+  // @copydoc
+  result_t readValue(size_t offset, size_t length, const SymbolString& input, data_value_t* value) const override;
+
   // @copydoc
   result_t writeSymbols(size_t offset, size_t length, istringstream* input,
       SymbolString* output, size_t* usedLength) const override;
@@ -445,6 +496,9 @@ class DateTimeDataType : public DataType {
   result_t readSymbols(size_t offset, size_t length, const SymbolString& input,
       OutputFormat outputFormat, ostream* output) const override;
 
+  // @copydoc
+  result_t readValue(size_t offset, size_t length, const SymbolString& input, data_value_t* value) const override;
+
   // @copydoc
   result_t writeSymbols(const size_t offset, size_t length, istringstream* input,
       SymbolString* output, size_t* usedLength) const override;
@@ -623,6 +677,22 @@ class NumberDataType : public DataType {
    */
   result_t getFloatFromRawValue(unsigned int value, float* output) const;
 
+  // @copydoc
+  result_t readValue(size_t offset, size_t length, const SymbolString& input, data_value_t* value) const override;
+
+  // @copydoc
+  DecodeOpcode getDecodeOpcode() const override {
+    return hasFlag(BCD) ? hasFlag(HCD) ? do_hcd : do_bcd : do_binary;
+  }
+
+  /**
+   * Convert the numeric raw value to its typed representation (including optional divisor).
+   * @param value the numeric raw value.
+   * @param output the @a data_value_t to fill.
+   * @return @a RESULT_OK on success, or an error code.
+   */
+  result_t getValueFromRawValue(unsigned int value, data_value_t* output) const;
+
   /**
    * Convert the float value to the numeric raw value (including optional divisor).
    * @param value the float value.
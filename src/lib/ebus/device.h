@@ -151,6 +151,21 @@ class Device {
    */
   virtual result_t recv(unsigned int timeout, symbol_t* value, ArbitrationState* arbitrationState) = 0;  // abstract
 
+  /**
+   * Peek at the bytes already received and buffered for handling them at once without waiting. This is only possible
+   * while not arbitrating and the buffered bytes need to be marked as handled via @a consumeBuffered() afterwards.
+   * @param data the reference in which the pointer to the buffered bytes is stored.
+   * @param len the reference in which the number of buffered bytes is stored.
+   * @return true when buffered bytes are available, false otherwise or if not supported by the device.
+   */
+  virtual bool peekBuffered(const symbol_t** data, size_t* len) { return false; }
+
+  /**
+   * Mark bytes retrieved via @a peekBuffered() as handled.
+   * @param len the number of handled bytes.
+   */
+  virtual void consumeBuffered(size_t len) {}
+
   /**
    * Start the arbitration with the specified master address. A subsequent request while an arbitration is currently in
    * checking state will always result in @a RESULT_ERR_DUPLICATE.
@@ -133,6 +133,27 @@ result_t PlainDevice::recv(unsigned int timeout, symbol_t* value, ArbitrationSta
   return result;
 }
 
+bool PlainDevice::peekBuffered(const symbol_t** data, size_t* len) {
+  if (m_arbitrationMaster != SYN) {
+    return false;  // each symbol needs to be checked during arbitration
+  }
+  return m_transport->read(0, data, len) == RESULT_OK && *len > 0 && *data;
+}
+
+void PlainDevice::consumeBuffered(size_t len) {
+  if (len == 0) {
+    return;
+  }
+  if (m_listener != nullptr) {
+    const uint8_t* data = nullptr;
+    size_t available = 0;
+    if (m_transport->read(0, &data, &available) == RESULT_OK && data) {
+      m_listener->notifyDeviceData(data, len < available ? len : available, true);
+    }
+  }
+  m_transport->readConsumed(len);
+}
+
 
 /** the features requested. */
 #define REQUEST_FEATURES 0x01
@@ -128,6 +128,12 @@ class PlainDevice : public BaseDevice {
 
   // @copydoc
   result_t recv(unsigned int timeout, symbol_t* value, ArbitrationState* arbitrationState) override;
+
+  // @copydoc
+  bool peekBuffered(const symbol_t** data, size_t* len) override;
+
+  // @copydoc
+  void consumeBuffered(size_t len) override;
 };
 
 
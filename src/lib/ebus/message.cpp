@@ -17,6 +17,9 @@
  */
 
 #include "lib/ebus/message.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
 #include <string>
 #include <vector>
 #include <cstring>
@@ -66,6 +69,84 @@ using std::endl;
 /** special value for invalid message key. */
 #define INVALID_KEY 0xffffffffffffffffLL
 
+/** the @a Mutex for the decoding caches of all @a Message instances. */
+static Mutex decodeCacheMutex;
+
+/**
+ * Get the decode index header of a message key.
+ * @param key the message key.
+ * @return the destination address, primary, and secondary command byte of the key.
+ */
+static inline uint32_t getDecodeHeader(uint64_t key) {
+  return static_cast<uint32_t>(key >> (8 * 4)) & 0xffffff;
+}
+
+/**
+ * Get the decode index bit of a message key.
+ * @param key the message key.
+ * @return the bit representing the ID length and source kind (specific passive, any passive, active read, or active
+ * write) of the key.
+ */
+static inline uint32_t getDecodeBit(uint64_t key) {
+  uint64_t source = key & ID_SOURCE_MASK;
+  unsigned int kind = source == 0 ? 1 : source == ID_SOURCE_ACTIVE_READ ? 2 : source == ID_SOURCE_ACTIVE_WRITE ? 3 : 0;
+  return 1U << (4 * static_cast<unsigned int>(key >> (8 * 7 + 5)) + kind);
+}
+
+/** the FNV-1a offset basis for the name key hash. */
+#define NAME_HASH_BASIS 0xcbf29ce484222325ULL
+
+/** the FNV-1a prime for the name key hash. */
+#define NAME_HASH_PRIME 0x100000001b3ULL
+
+/**
+ * Lowercase a single ASCII character.
+ * @param ch the character.
+ * @return the lowercase character.
+ */
+static inline char lowerChar(char ch) {
+  return ch >= 'A' && ch <= 'Z' ? static_cast<char>(ch + ('a' - 'A')) : ch;
+}
+
+/**
+ * Continue the case insensitive hash of a name key with a single character.
+ * @param hash the hash so far.
+ * @param ch the character to add.
+ * @return the new hash.
+ */
+static inline uint64_t getNameHash(uint64_t hash, char ch) {
+  return (hash ^ static_cast<unsigned char>(lowerChar(ch))) * NAME_HASH_PRIME;
+}
+
+/**
+ * Continue the case insensitive hash of a name key with a string.
+ * @param hash the hash so far.
+ * @param str the string to add.
+ * @return the new hash.
+ */
+static uint64_t getNameHash(uint64_t hash, const string& str) {
+  for (const char ch : str) {
+    hash = getNameHash(hash, ch);
+  }
+  return hash;
+}
+
+/**
+ * Check whether the string matches the part of the name key at the position ignoring case.
+ * @param key the lowercase name key.
+ * @param pos the position in the key to start at.
+ * @param str the string to compare.
+ * @return whether the string matches.
+ */
+static bool matchesNamePart(const string& key, size_t pos, const string& str) {
+  for (const char ch : str) {
+    if (key[pos++] != lowerChar(ch)) {
+      return false;
+    }
+  }
+  return true;
+}
+
 /** the maximum poll priority for a @a Message referred to by a @a Condition. */
 #define POLL_PRIORITY_CONDITION 5
 
@@ -91,8 +172,24 @@ static const char* defaultMessageFieldMap[] = {  // access level not included in
     "*name", "part", "type", "divisor/values", "unit", "comment",
 };
 
-/** the m_pollOrder of the last polled message. */
-static unsigned int g_lastPollOrder = 0;
+/** the maximum value of a poll attribute in seconds (one week). */
+#define POLL_ATTRIBUTE_MAX (7*24*3600)
+
+/**
+ * Get a poll attribute in seconds.
+ * @param item the @a AttributedItem to get the attribute from.
+ * @param name the name of the attribute.
+ * @return the attribute value in seconds, or 0 if not set or invalid.
+ */
+static unsigned int getPollAttribute(const AttributedItem& item, const string& name) {
+  string value = item.getAttribute(name);
+  if (value.empty()) {
+    return 0;
+  }
+  result_t result = RESULT_OK;
+  unsigned int seconds = parseInt(value.c_str(), 10, 1, POLL_ATTRIBUTE_MAX, &result);
+  return result == RESULT_OK ? seconds : 0;
+}
 
 
 Message::Message(const string& filename, const string& circuit, const string& level, const string& name,
@@ -110,11 +207,20 @@ Message::Message(const string& filename, const string& circuit, const string& le
       m_data(data), m_deleteData(deleteData),
       m_pollPriority(pollPriority),
       m_usedByCondition(false), m_isScanMessage(false), m_condition(condition), m_availableSinceTime(0),
-      m_dataHandlerState(0), m_lastUpdateTime(0), m_lastChangeTime(0), m_pollOrder(0), m_lastPollTime(0) {
+      m_availabilityPending(false),
+      m_dataVersion(0), m_decodeCacheNext(0),
+      m_dataHandlerState(0), m_lastUpdateTime(0), m_lastChangeTime(0),
+      m_pollPeriod(getPollAttribute(*this, "pollperiod")), m_pollJitter(getPollAttribute(*this, "polljitter")),
+      m_pollMaxStale(getPollAttribute(*this, "maxstale")), m_pollDue(0), m_pollOrder(0), m_pollIndex(SIZE_MAX),
+      m_staleDue(0), m_staleOrder(0), m_staleIndex(SIZE_MAX), m_lastPollTime(0), m_lastPassiveTime(0),
+      m_updateMap(nullptr), m_updatePrev(nullptr), m_updateNext(nullptr), m_changePrev(nullptr),
+      m_changeNext(nullptr), m_lastUpdateSequence(0), m_lastChangeSequence(0),
+      m_siblingPrev(this), m_siblingNext(this) {
   if (strcasecmp(circuit.c_str(), "scan") == 0) {
     setScanMessage();
     m_pollPriority = 0;
   }
+  m_decodeProgram.compile(m_data);
   time(&m_createTime);
 }
 
@@ -130,7 +236,15 @@ Message::Message(const string& circuit, const string& level, const string& name,
       m_data(data), m_deleteData(deleteData),
       m_pollPriority(0),
       m_usedByCondition(false), m_isScanMessage(true), m_condition(nullptr), m_availableSinceTime(0),
-      m_lastUpdateTime(0), m_lastChangeTime(0), m_pollOrder(0), m_lastPollTime(0) {
+      m_availabilityPending(false),
+      m_dataVersion(0), m_decodeCacheNext(0),
+      m_lastUpdateTime(0), m_lastChangeTime(0), m_pollPeriod(0), m_pollJitter(0), m_pollMaxStale(0), m_pollDue(0),
+      m_pollOrder(0), m_pollIndex(SIZE_MAX), m_staleDue(0), m_staleOrder(0), m_staleIndex(SIZE_MAX),
+      m_lastPollTime(0), m_lastPassiveTime(0),
+      m_updateMap(nullptr), m_updatePrev(nullptr), m_updateNext(nullptr), m_changePrev(nullptr),
+      m_changeNext(nullptr), m_lastUpdateSequence(0), m_lastChangeSequence(0),
+      m_siblingPrev(this), m_siblingNext(this) {
+  m_decodeProgram.compile(m_data);
   time(&m_createTime);
 }
 
@@ -528,7 +642,7 @@ bool Message::extractFieldNames(const string& str, bool checkAbbreviated, vector
 
 Message* Message::derive(symbol_t dstAddress, symbol_t srcAddress, const string& circuit) const {
   Message* result = new Message(m_filename, circuit.length() == 0 ? m_circuit : circuit, m_level, m_name,
-    m_isWrite, m_isPassive, m_attributes,
+    m_isWrite, m_isPassive, m_attributes->value,
     srcAddress == SYN ? m_srcAddress : srcAddress, dstAddress,
     m_id, m_data, false,
     m_pollPriority, m_condition);
@@ -623,27 +737,27 @@ bool Message::setPollPriority(size_t priority) {
   }
   bool ret = m_pollPriority == 0 && usePriority > 0;
   m_pollPriority = usePriority;
-  if (ret || m_pollOrder > g_lastPollOrder+(unsigned int)m_pollPriority) {
-    // ensure a later increased or newly set priority does not prefer that message before all others
-    m_pollOrder = g_lastPollOrder+(unsigned int)m_pollPriority;
-  }
   return ret;
 }
 
-bool Message::isLessPollWeight(const Message* other) const {
-  if (m_pollOrder > other->m_pollOrder) {
-    return true;
+unsigned int Message::getPollPeriod(unsigned int baseInterval) const {
+  if (m_pollPeriod > 0) {
+    return m_pollPeriod;
   }
-  if (m_pollOrder < other->m_pollOrder) {
-    return false;
-  }
-  if (m_pollPriority > other->m_pollPriority) {
-    return true;
-  }
-  if (m_pollPriority < other->m_pollPriority) {
-    return false;
-  }
-  return m_lastPollTime > other->m_lastPollTime;
+  return static_cast<unsigned int>(m_pollPriority > 0 ? m_pollPriority : 1) * baseInterval;
+}
+
+unsigned int Message::getPollJitter(unsigned int baseInterval) const {
+  return m_pollJitter > 0 ? m_pollJitter : getPollPeriod(baseInterval) / POLL_JITTER_DIVISOR;
+}
+
+unsigned int Message::getPollMaxStale(unsigned int baseInterval) const {
+  return m_pollMaxStale > 0 ? m_pollMaxStale : getPollPeriod(baseInterval) * POLL_MAX_STALE_FACTOR;
+}
+
+time_t Message::getPollStaleTime(unsigned int baseInterval) const {
+  time_t fresh = m_lastUpdateTime > m_lastPollTime ? m_lastUpdateTime : m_lastPollTime;
+  return fresh == 0 ? 0 : fresh + getPollMaxStale(baseInterval);
 }
 
 void Message::setUsedByCondition() {
@@ -656,21 +770,33 @@ void Message::setUsedByCondition() {
   }
 }
 
-bool Message::isAvailable() {
+bool Message::isAvailable() const {
   return (m_condition == nullptr) || m_condition->isTrue();
 }
 
-time_t Message::getAvailableSinceTime() {
+time_t Message::getAvailableSinceTime() const {
   if (m_condition == nullptr) {
     return m_createTime;
   }
   if (!m_condition->isTrue()) {
     return 0;
   }
-  if (m_availableSinceTime == 0) {  // was not yet available
-    m_availableSinceTime = m_condition->getLastCheckTime();
+  return m_availableSinceTime == 0 ? m_createTime : m_availableSinceTime;
+}
+
+void Message::addDependentCondition(Condition* condition) {
+  m_dependentConditions.push_back(condition);
+}
+
+void Message::updateDependentConditions() {
+  if (m_dependentConditions.empty()) {
+    return;
+  }
+  time_t now;
+  time(&now);
+  for (const auto condition : m_dependentConditions) {
+    condition->update(now);
   }
-  return m_availableSinceTime;
 }
 
 bool Message::hasField(const char* fieldName, bool numeric) const {
@@ -733,9 +859,17 @@ result_t Message::prepareSlave(istringstream* input, SlaveSymbolString* slave) {
   }
   slave->adjustHeader();
   time(&m_lastUpdateTime);
-  if (*slave != m_lastSlaveData) {
+  bool changed = *slave != m_lastSlaveData;
+  if (changed) {
     m_lastChangeTime = m_lastUpdateTime;
     m_lastSlaveData = *slave;
+    m_dataVersion++;
+  }
+  if (m_updateMap) {
+    m_updateMap->messageUpdated(this, true, changed);
+  }
+  if (changed) {
+    updateDependentConditions();
   }
   return result;
 }
@@ -749,36 +883,109 @@ result_t Message::storeLastData(const MasterSymbolString& master, const SlaveSym
 }
 
 result_t Message::storeLastData(size_t index, const MasterSymbolString& data) {
-  if (data.size() > 0 && (m_isWrite || this->m_dstAddress == BROADCAST || isMaster(this->m_dstAddress)
-      || data.getDataSize() + 2 > m_id.size())) {
-    time(&m_lastUpdateTime);
-  }
+  bool updated = data.size() > 0 && (m_isWrite || this->m_dstAddress == BROADCAST || isMaster(this->m_dstAddress)
+      || data.getDataSize() + 2 > m_id.size());
+  time_t now;
+  time(&now);
+  if (updated) {
+    m_lastUpdateTime = now;
+  }
+  bool changed = false;
   switch (data.compareTo(m_lastMasterData)) {
   case 1:  // completely different
-    m_lastChangeTime = m_lastUpdateTime;
+    m_lastChangeTime = now;  // even when not updated for keeping the change list ordered by time
     m_lastMasterData = data;
+    m_dataVersion++;
+    changed = true;
     break;
   case 2:  // only master address is different
     m_lastMasterData = data;
+    m_dataVersion++;
     break;
   // else: identical
   }
+  if (m_updateMap && (updated || changed)) {
+    m_updateMap->messageUpdated(this, updated, changed);
+  }
+  if (changed) {
+    updateDependentConditions();
+  }
   return RESULT_OK;
 }
 
 result_t Message::storeLastData(size_t index, const SlaveSymbolString& data) {
-  if (data.size() > 0) {
-    time(&m_lastUpdateTime);
-  }
-  if (m_lastSlaveData != data) {
-    m_lastChangeTime = m_lastUpdateTime;
+  bool updated = data.size() > 0;
+  time_t now;
+  time(&now);
+  if (updated) {
+    m_lastUpdateTime = now;
+  }
+  bool changed = m_lastSlaveData != data;
+  if (changed) {
+    m_lastChangeTime = now;  // even when not updated for keeping the change list ordered by time
     m_lastSlaveData = data;
+    m_dataVersion++;
+  }
+  if (m_updateMap && (updated || changed)) {
+    m_updateMap->messageUpdated(this, updated, changed);
+  }
+  if (changed) {
+    updateDependentConditions();
   }
   return RESULT_OK;
 }
 
 result_t Message::decodeLastData(PartType part, bool leadingSeparator, const char* fieldName,
     ssize_t fieldIndex, const OutputFormat outputFormat, ostream* output) const {
+  decodeCacheMutex.lock();
+  unsigned int dataVersion = m_dataVersion;
+  for (const auto& entry : m_decodeCache) {
+    if (entry.dataVersion == dataVersion && entry.part == part && entry.leadingSeparator == leadingSeparator
+        && entry.fieldIndex == fieldIndex && entry.outputFormat == outputFormat
+        && (fieldName ? !entry.allFields && entry.fieldName == fieldName : entry.allFields)) {
+      *output << entry.output;
+      result_t result = entry.result;
+      decodeCacheMutex.unlock();
+      return result;
+    }
+  }
+  decodeCacheMutex.unlock();
+  ostringstream decoded;
+  result_t result = decodeLastDataUncached(part, leadingSeparator, fieldName, fieldIndex, outputFormat, &decoded);
+  const string& str = decoded.str();
+  decodeCacheMutex.lock();
+  decode_cache_entry_t* entry = nullptr;
+  for (auto& check : m_decodeCache) {
+    if (check.dataVersion != m_dataVersion) {
+      entry = &check;  // reuse outdated entry
+      break;
+    }
+  }
+  if (!entry) {
+    if (m_decodeCache.size() < DECODE_CACHE_SIZE) {
+      m_decodeCache.resize(m_decodeCache.size() + 1);
+      entry = &m_decodeCache.back();
+    } else {
+      entry = &m_decodeCache[m_decodeCacheNext];
+      m_decodeCacheNext = (m_decodeCacheNext + 1) % DECODE_CACHE_SIZE;
+    }
+  }
+  entry->dataVersion = dataVersion;
+  entry->part = part;
+  entry->leadingSeparator = leadingSeparator;
+  entry->allFields = fieldName == nullptr;
+  entry->fieldName = fieldName ? fieldName : "";
+  entry->fieldIndex = fieldIndex;
+  entry->outputFormat = outputFormat;
+  entry->result = result;
+  entry->output = str;
+  decodeCacheMutex.unlock();
+  *output << str;
+  return result;
+}
+
+result_t Message::decodeLastDataUncached(PartType part, bool leadingSeparator, const char* fieldName,
+    ssize_t fieldIndex, const OutputFormat outputFormat, ostream* output) const {
   if ((outputFormat & OF_RAWDATA) && !(outputFormat & OF_JSON)) {
     *output << "[" << m_lastMasterData.getStr(2, 0, false)
             << "/" << m_lastSlaveData.getStr(0, 0, false)
@@ -835,6 +1042,58 @@ result_t Message::decodeLastDataNumField(const char* fieldName, ssize_t fieldInd
   return result;
 }
 
+result_t Message::decodeLastValues(DataValueList* values) const {
+  values->clear();
+  bool compiled = m_decodeProgram.isCompiled();
+  result_t result = compiled ? m_decodeProgram.execute(m_lastMasterData, getIdLength(), values)
+    : m_data->readValues(m_lastMasterData, getIdLength(), values);
+  if (result < RESULT_OK) {
+    return result;
+  }
+  result = compiled ? m_decodeProgram.execute(m_lastSlaveData, 0, values)
+    : m_data->readValues(m_lastSlaveData, 0, values);
+  if (result < RESULT_OK) {
+    return result;
+  }
+  return values->empty() ? RESULT_EMPTY : RESULT_OK;
+}
+
+result_t Message::decodeColumn(ssize_t fieldIndex, const vector<const SymbolString*>& data,
+    vector<double>* output) const {
+  const SingleDataField* field = m_data->getField(fieldIndex);
+  if (!field) {
+    return RESULT_ERR_NOTFOUND;
+  }
+  output->resize(data.size());
+  if (data.empty()) {
+    return RESULT_OK;
+  }
+  size_t offset = field->getPartType() == pt_masterData ? getIdLength() : 0;
+  if (m_decodeProgram.isCompiled()
+      && m_decodeProgram.decodeColumn(field, data.data(), data.size(), offset, output->data()) == RESULT_OK) {
+    return RESULT_OK;
+  }
+  // not available as compiled numeric field: decode each telegram separately
+  DataValueList values;
+  for (size_t row = 0; row < data.size(); row++) {
+    double number = NAN;
+    values.clear();
+    if (m_data->readValues(*data[row], offset, &values) >= RESULT_OK) {
+      for (size_t index = 0; index < values.size(); index++) {
+        const field_value_t& entry = values[index];
+        if (entry.field == field) {
+          if (entry.value.type == dvt_number || entry.value.type == dvt_integer || entry.value.type == dvt_list) {
+            number = entry.value.number;
+          }
+          break;
+        }
+      }
+    }
+    (*output)[row] = number;
+  }
+  return RESULT_OK;
+}
+
 void Message::dumpHeader(const vector<string>* fieldNames, ostream* output) {
   bool first = true;
   if (fieldNames == nullptr) {
@@ -1090,7 +1349,7 @@ ChainedMessage::~ChainedMessage() {
 
 Message* ChainedMessage::derive(symbol_t dstAddress, symbol_t srcAddress, const string& circuit) const {
   ChainedMessage* result = new ChainedMessage(m_filename, circuit.length() == 0 ? m_circuit : circuit, m_level, m_name,
-    m_isWrite, m_attributes,
+    m_isWrite, m_attributes->value,
     srcAddress == SYN ? m_srcAddress : srcAddress, dstAddress,
     m_id, m_ids, m_lengths, m_data, false,
     m_pollPriority, m_condition);
@@ -1375,6 +1634,70 @@ Message* getFirstAvailable(const vector<Message*>& messages, const Message* same
   return nullptr;
 }
 
+void PollScheduler::schedule(Message* message, time_t due, uint64_t order) {
+  message->*m_due = due;
+  message->*m_order = order;
+  if (contains(message)) {
+    update(message->*m_index);
+    return;
+  }
+  m_heap.push_back(message);
+  message->*m_index = m_heap.size() - 1;
+  update(message->*m_index);
+}
+
+void PollScheduler::remove(Message* message) {
+  if (!contains(message)) {
+    return;
+  }
+  size_t index = message->*m_index;
+  message->*m_index = SIZE_MAX;
+  Message* last = m_heap.back();
+  m_heap.pop_back();
+  if (last != message) {
+    place(index, last);
+    update(index);
+  }
+}
+
+void PollScheduler::clear() {
+  for (const auto message : m_heap) {
+    message->*m_index = SIZE_MAX;
+  }
+  m_heap.clear();
+}
+
+void PollScheduler::update(size_t index) {
+  Message* message = m_heap[index];
+  // move up towards the root while due before the parent
+  while (index > 0) {
+    size_t parent = (index - 1) / 2;
+    if (!isBefore(message, m_heap[parent])) {
+      break;
+    }
+    place(index, m_heap[parent]);
+    index = parent;
+  }
+  // move down towards the leaves while any child is due before
+  size_t size = m_heap.size();
+  while (true) {
+    size_t child = 2 * index + 1;
+    if (child >= size) {
+      break;
+    }
+    if (child + 1 < size && isBefore(m_heap[child + 1], m_heap[child])) {
+      child++;
+    }
+    if (!isBefore(m_heap[child], message)) {
+      break;
+    }
+    place(index, m_heap[child]);
+    index = child;
+  }
+  place(index, message);
+}
+
+
 /**
  * Split up a list of string values separated by @a VALUE_SEPARATOR.
  * @param valueList the input string to split.
@@ -1519,6 +1842,55 @@ result_t Condition::create(const string& condName, const map<string, string>& ro
   return RESULT_OK;
 }
 
+Mutex Condition::s_updateMutex;
+
+void Condition::addParent(Condition* parent) {
+  if (find(m_parents.begin(), m_parents.end(), parent) == m_parents.end()) {
+    m_parents.push_back(parent);
+  }
+}
+
+void Condition::addDependentMessage(Message* message) {
+  s_updateMutex.lock();
+  m_dependentMessages.push_back(message);
+  if (m_isTrue) {
+    time(&message->m_availableSinceTime);
+  }
+  s_updateMutex.unlock();
+}
+
+void Condition::removeDependentMessage(Message* message) {
+  s_updateMutex.lock();
+  m_dependentMessages.erase(std::remove(m_dependentMessages.begin(), m_dependentMessages.end(), message),
+      m_dependentMessages.end());
+  s_updateMutex.unlock();
+}
+
+void Condition::update(time_t now) {
+  s_updateMutex.lock();
+  propagate(now);
+  s_updateMutex.unlock();
+}
+
+void Condition::propagate(time_t now) {
+  bool isTrue = evaluate();
+  if (isTrue == m_isTrue) {
+    return;  // nothing changed for the parents and dependent messages
+  }
+  m_isTrue = isTrue;
+  for (const auto message : m_dependentMessages) {
+    if (isTrue) {
+      message->m_availableSinceTime = now;
+    }
+    if (message->m_updateMap) {
+      message->m_updateMap->messageAvailabilityChanged(message);
+    }
+  }
+  for (const auto parent : m_parents) {
+    parent->propagate(now);
+  }
+}
+
 SimpleCondition* SimpleCondition::derive(const string& valueList) const {
   if (valueList.empty()) {
     return nullptr;
@@ -1644,9 +2016,11 @@ result_t SimpleCondition::resolve(void (*readMessageFunc)(Message* message), Mes
     }
     m_message = message;
     message->setUsedByCondition();
+    message->addDependentCondition(this);
     if (m_name.length() > 0 && !message->isScanMessage()) {
       messages->addPollMessage(true, message);
     }
+    update(time(nullptr));  // initial evaluation, later ones are pushed on every change of the message
   }
   if (m_message->getLastUpdateTime() == 0 && readMessageFunc != nullptr) {
     (*readMessageFunc)(m_message);
@@ -1654,19 +2028,11 @@ result_t SimpleCondition::resolve(void (*readMessageFunc)(Message* message), Mes
   return RESULT_OK;
 }
 
-bool SimpleCondition::isTrue() {
-  if (!m_message) {
+bool SimpleCondition::evaluate() {
+  if (!m_message || m_message->getLastChangeTime() == 0) {
     return false;
   }
-  if (m_message->getLastChangeTime() > m_lastCheckTime) {
-    bool isTrue = !m_hasValues;  // for message seen check
-    if (!isTrue) {
-      isTrue = checkValue(m_message, m_field);
-    }
-    m_isTrue = isTrue;
-    m_lastCheckTime = m_message->getLastChangeTime();
-  }
-  return m_isTrue;
+  return !m_hasValues || checkValue(m_message, m_field);  // without values for message seen check
 }
 
 
@@ -1746,6 +2112,7 @@ void CombinedCondition::dumpJson(ostream* output) const {
 result_t CombinedCondition::resolve(void (*readMessageFunc)(Message* message), MessageMap* messages,
     ostringstream* errorMessage) {
   for (const auto condition : m_conditions) {
+    condition->addParent(this);
     ostringstream dummy;
     result_t ret = condition->resolve(readMessageFunc, messages, &dummy);
     if (ret != RESULT_OK) {
@@ -1753,10 +2120,11 @@ result_t CombinedCondition::resolve(void (*readMessageFunc)(Message* message), M
       return ret;
     }
   }
+  update(time(nullptr));  // initial evaluation as the parts might have been resolved and evaluated already
   return RESULT_OK;
 }
 
-bool CombinedCondition::isTrue() {
+bool CombinedCondition::evaluate() {
   for (const auto condition : m_conditions) {
     if (!condition->isTrue()) {
       return false;
@@ -1935,31 +2303,58 @@ result_t MessageMap::add(bool storeByName, Message* message, bool replace) {
       }
       unlock();
     }
-    m_messagesByName[nameKey].push_back(message);
+    // find a sibling with the same circuit and name from any of the read/write/passive variants
+    Message* sibling = nullptr;
+    string circuitName = nameKey.substr(0, nameKey.length() - 1);
+    for (const char type : {'R', 'W', 'P'}) {
+      const auto siblingIt = m_messagesByName.find(circuitName + type);
+      if (siblingIt != m_messagesByName.end() && !siblingIt->second.empty()) {
+        sibling = siblingIt->second.front();
+        break;
+      }
+    }
+    getOrAddByName(nameKey)->push_back(message);
+    if (sibling) {
+      m_updateMutex.lock();
+      message->m_siblingPrev = sibling;
+      message->m_siblingNext = sibling->m_siblingNext;
+      sibling->m_siblingNext->m_siblingPrev = message;
+      sibling->m_siblingNext = message;
+      m_updateMutex.unlock();
+    }
     nameKey = suffix;  // also store without circuit
-    const auto nameIt = m_messagesByName.find(nameKey);
-    if (nameIt == m_messagesByName.end()) {
+    vector<Message*>* messages = getOrAddByName(nameKey);
+    if (messages->empty()) {
       // always store first message without circuit (in order of circuit name)
-      m_messagesByName[nameKey].push_back(message);
+      messages->push_back(message);
     } else {
-      vector<Message*>* messages = &nameIt->second;
       Message* first = messages->front();
       if (circuit < first->getCircuit()) {
         // always store first message without circuit (in order of circuit name)
-        m_messagesByName[nameKey].at(0) = message;
+        messages->at(0) = message;
       } else if (m_addAll || (conditional && first->isConditional())) {
         // store further messages only if both are conditional or if storing everything
-        m_messagesByName[nameKey].push_back(message);
+        messages->push_back(message);
       }
     }
     m_messageCount++;
     if (conditional) {
       m_conditionalMessageCount++;
+      message->m_condition->addDependentMessage(message);
     }
     if (isPassive) {
       m_passiveMessageCount++;
     }
     addPollMessage(false, message);
+    m_updateMutex.lock();
+    message->m_updateMap = this;
+    if (message->m_lastUpdateTime != 0) {
+      appendMessage(message, &Message::m_updatePrev, &Message::m_updateNext, &m_firstUpdated, &m_lastUpdated);
+    }
+    if (message->m_lastChangeTime != 0) {
+      appendMessage(message, &Message::m_changePrev, &Message::m_changeNext, &m_firstChanged, &m_lastChanged);
+    }
+    m_updateMutex.unlock();
   }
   size_t idLength = message->getIdLength();
   if (message->getDstAddress() == BROADCAST && idLength > m_maxBroadcastIdLength) {
@@ -1969,6 +2364,7 @@ result_t MessageMap::add(bool storeByName, Message* message, bool replace) {
     m_maxIdLength = idLength;
   }
   m_messagesByKey[key].push_back(message);
+  m_decodeMasks[getDecodeHeader(key)] |= getDecodeBit(key);
   return RESULT_OK;
 }
 
@@ -1996,6 +2392,29 @@ void MessageMap::remove(Message* message) {
       m_messagesByKey.erase(keyIt);
     }
   }
+  if (message->m_updateMap == this) {
+    m_updateMutex.lock();
+    message->m_updateMap = nullptr;
+    unlinkMessage(message, &Message::m_updatePrev, &Message::m_updateNext, &m_firstUpdated, &m_lastUpdated);
+    unlinkMessage(message, &Message::m_changePrev, &Message::m_changeNext, &m_firstChanged, &m_lastChanged);
+    for (const auto sequence : {message->m_lastUpdateSequence, message->m_lastChangeSequence}) {
+      if (sequence > 0 && m_journal[sequence % MESSAGE_JOURNAL_SIZE] == message) {
+        m_journal[sequence % MESSAGE_JOURNAL_SIZE] = nullptr;
+      }
+    }
+    message->m_siblingPrev->m_siblingNext = message->m_siblingNext;
+    message->m_siblingNext->m_siblingPrev = message->m_siblingPrev;
+    message->m_siblingPrev = message->m_siblingNext = message;
+    if (message->m_availabilityPending) {
+      message->m_availabilityPending = false;
+      m_availabilityChanged.erase(std::remove(m_availabilityChanged.begin(), m_availabilityChanged.end(), message),
+          m_availabilityChanged.end());
+    }
+    m_updateMutex.unlock();
+    if (conditional) {
+      message->m_condition->removeDependentMessage(message);
+    }
+  }
   bool storedByName = false;
   for (auto nameIt = m_messagesByName.begin(); nameIt != m_messagesByName.end(); ) {
     vector<Message*>* messages = &nameIt->second;
@@ -2010,6 +2429,19 @@ void MessageMap::remove(Message* message) {
       }
     }
     if (messages->empty()) {
+      auto range = m_messagesByNameHash.equal_range(getNameHash(NAME_HASH_BASIS, nameIt->first));
+      for (auto hashIt = range.first; hashIt != range.second; ++hashIt) {
+        if (hashIt->second == nameIt) {
+          m_messagesByNameHash.erase(hashIt);
+          break;
+        }
+      }
+      if (nameIt->first[0] != FIELD_SEPARATOR) {
+        const auto circuitIt = m_circuitKeys.find(nameIt->first.substr(0, nameIt->first.find(FIELD_SEPARATOR) + 1));
+        if (circuitIt != m_circuitKeys.end() && --circuitIt->second == 0) {
+          m_circuitKeys.erase(circuitIt);
+        }
+      }
       nameIt = m_messagesByName.erase(nameIt);
     } else {
       ++nameIt;
@@ -2025,9 +2457,9 @@ void MessageMap::remove(Message* message) {
       m_passiveMessageCount--;
     }
   }
-  if (message->getPollPriority() > 0) {
-    m_pollMessages.remove(message);
-  }
+  m_pollMessages.remove(message);
+  m_stalePollMessages.remove(message);
+  m_cyclePollMessages.remove(message);
   if (needDelete) {
     delete message;
   }
@@ -2344,6 +2776,7 @@ result_t MessageMap::readFromStream(istream* stream, const string& filename, con
   if (!size) {
     size = &localSize;
   }
+  ArenaScope scope(m_arena);
   result_t result
   = MappedFileReader::readFromStream(stream, filename, mtime, verbose, defaults, errorDescription, replace, hash, size);
   if (defaults) {
@@ -2622,33 +3055,82 @@ const vector<Message*>* MessageMap::getByKey(uint64_t key) const {
   return nullptr;
 }
 
+vector<Message*>* MessageMap::getOrAddByName(const string& nameKey) {
+  auto result = m_messagesByName.insert(std::make_pair(nameKey, vector<Message*>()));
+  if (result.second) {
+    m_messagesByNameHash.insert(std::make_pair(getNameHash(NAME_HASH_BASIS, nameKey), result.first));
+    if (nameKey[0] != FIELD_SEPARATOR) {
+      m_circuitKeys[nameKey.substr(0, nameKey.find(FIELD_SEPARATOR) + 1)]++;
+    }
+  }
+  return &result.first->second;
+}
+
 Message* MessageMap::find(const string& circuit, const string& name, const string& levels, bool isWrite,
     bool isPassive) const {
-  string lcircuit = circuit;
-  FileReader::tolower(&lcircuit);
-  string lname = name;
-  FileReader::tolower(&lname);
-  string suffix = FIELD_SEPARATOR + lname + (isPassive ? "P" : (isWrite ? "W" : "R"));
-  for (int i = 0; i < 2; i++) {
-    string nameKey;
-    if (i == 0) {
-      nameKey = lcircuit + suffix;
-    } else if (lcircuit.empty()) {
-      nameKey = suffix;  // second try: without circuit
-    } else {
-      continue;  // not allowed without circuit
+  // hash the key "circuit,name[PWR]" without building it (the key without circuit is the same for empty circuit)
+  char type = isPassive ? 'p' : (isWrite ? 'w' : 'r');
+  uint64_t hash = getNameHash(getNameHash(getNameHash(getNameHash(NAME_HASH_BASIS, circuit), FIELD_SEPARATOR),
+    name), type);
+  size_t keyLength = circuit.length() + 1 + name.length() + 1;
+  auto range = m_messagesByNameHash.equal_range(hash);
+  for (auto it = range.first; it != range.second; ++it) {
+    const string& key = it->second->first;
+    if (key.length() != keyLength || !matchesNamePart(key, 0, circuit) || key[circuit.length()] != FIELD_SEPARATOR
+        || !matchesNamePart(key, circuit.length() + 1, name) || lowerChar(key[keyLength - 1]) != type) {
+      continue;
     }
-    const auto it = m_messagesByName.find(nameKey);
-    if (it != m_messagesByName.end()) {
-      Message* message = getFirstAvailable(it->second);
-      if (message && message->hasLevel(levels)) {
-        return message;
-      }
+    Message* message = getFirstAvailable(it->second->second);
+    if (message && message->hasLevel(levels)) {
+      return message;
     }
   }
   return nullptr;
 }
 
+/**
+ * Check whether the string matches the lowercase part ignoring case.
+ * @param str the string to check.
+ * @param lower the lowercase part to match.
+ * @param complete true for a complete match, false for a partial one.
+ * @return whether the string matches.
+ */
+static bool matchesIgnoreCase(const string& str, const string& lower, bool complete) {
+  size_t len = lower.length();
+  if (complete ? str.length() != len : str.length() < len) {
+    return false;
+  }
+  size_t last = complete ? 0 : str.length() - len;
+  for (size_t start = 0; start <= last; start++) {
+    size_t pos = 0;
+    while (pos < len && lowerChar(str[start + pos]) == lower[pos]) {
+      pos++;
+    }
+    if (pos == len) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool MessageMap::matchesFilter(Message* message, const string& lcircuit, const string& lname,
+    const string& levels, bool completeMatch, bool withRead, bool withWrite, bool withPassive,
+    bool includeEmptyLevel, bool onlyAvailable) {
+  if (levels != "*" && !message->hasLevel(levels, includeEmptyLevel)) {
+    return false;
+  }
+  if (!lcircuit.empty() && !matchesIgnoreCase(message->getCircuit(), lcircuit, completeMatch)) {
+    return false;
+  }
+  if (!lname.empty() && !matchesIgnoreCase(message->getName(), lname, completeMatch)) {
+    return false;
+  }
+  if (!(message->isPassive() ? withPassive : message->isWrite() ? withWrite : withRead)) {
+    return false;
+  }
+  return !onlyAvailable || message->isAvailable();
+}
+
 void MessageMap::findAll(const string& circuit, const string& name, const string& levels,
     bool completeMatch, bool withRead, bool withWrite, bool withPassive, bool includeEmptyLevel, bool onlyAvailable,
     time_t since, time_t until, bool changedSince, deque<Message*>* messages) const {
@@ -2656,62 +3138,71 @@ void MessageMap::findAll(const string& circuit, const string& name, const string
   FileReader::tolower(&lcircuit);
   string lname = name;
   FileReader::tolower(&lname);
-  bool checkCircuit = lcircuit.length() > 0;
-  bool checkLevel = levels != "*";
-  bool checkName = lname.length() > 0;
-  for (const auto& it : m_messagesByName) {
-    if (it.first[0] == FIELD_SEPARATOR) {  // avoid duplicates: instances stored multiple times have a special key
-      continue;
-    }
-    for (const auto message : it.second) {
-      if (checkLevel && !message->hasLevel(levels, includeEmptyLevel)) {
+  if (since != 0) {
+    // walk backwards through the messages in order of the last update/change, skipping those outside the time range
+    // as the order is not strictly by time (e.g. on clock skew)
+    vector<Message*> found;
+    m_updateMutex.lock();
+    for (Message* message = changedSince ? m_lastChanged : m_lastUpdated; message;
+        message = changedSince ? message->m_changePrev : message->m_updatePrev) {
+      time_t lastchg = changedSince ? message->getLastChangeTime() : message->getLastUpdateTime();
+      if (lastchg < since || (until != 0 && lastchg >= until) || message->getDstAddress() == SYN) {
         continue;
       }
-      if (checkCircuit) {
-        string check = message->getCircuit();
-        FileReader::tolower(&check);
-        if (completeMatch ? (check != lcircuit) : (check.find(lcircuit) == check.npos)) {
-          continue;
-        }
+      if (matchesFilter(message, lcircuit, lname, levels, completeMatch, withRead, withWrite, withPassive,
+          includeEmptyLevel, onlyAvailable)) {
+        found.push_back(message);
       }
-      if (checkName) {
-        string check = message->getName();
-        FileReader::tolower(&check);
-        if (completeMatch ? (check != lname) : (check.find(lname) == check.npos)) {
-          continue;
-        }
-      }
-      if (message->isPassive()) {
-        if (!withPassive) {
-          continue;
-        }
-      } else if (message->isWrite()) {
-        if (!withWrite) {
-          continue;
+    }
+    m_updateMutex.unlock();
+    messages->insert(messages->end(), found.rbegin(), found.rend());
+    return;
+  }
+  // walk through all name keys or only those of the matching circuits (in the same order)
+  auto circuitIt = m_circuitKeys.begin();
+  auto nameIt = lcircuit.empty() ? m_messagesByName.begin() : m_messagesByName.end();
+  string circuitKey;
+  while (true) {
+    if (!lcircuit.empty()) {
+      if (nameIt == m_messagesByName.end() || nameIt->first.compare(0, circuitKey.length(), circuitKey) != 0) {
+        // continue with the next matching circuit
+        for (; circuitIt != m_circuitKeys.end(); ++circuitIt) {
+          const string& key = circuitIt->first;
+          if (completeMatch ? key.length() == lcircuit.length() + 1 && key.compare(0, lcircuit.length(), lcircuit) == 0
+              : key.find(lcircuit) < key.length() - lcircuit.length()) {
+            break;
+          }
         }
-      } else {
-        if (!withRead) {
-          continue;
+        if (circuitIt == m_circuitKeys.end()) {
+          break;
         }
+        circuitKey = circuitIt->first;
+        ++circuitIt;
+        nameIt = m_messagesByName.lower_bound(circuitKey);
+        continue;
       }
-      if (since != 0 || until != 0) {
-        if (message->getDstAddress() == SYN) {
-          continue;
-        }
-        time_t lastchg = changedSince ? message->getLastChangeTime() : message->getLastUpdateTime();
-        if ((since != 0 && lastchg < since)
-        || (until != 0 && lastchg >= until)) {
-          continue;
+    } else if (nameIt == m_messagesByName.end()) {
+      break;
+    }
+    const string& key = nameIt->first;
+    char type = key[key.length() - 1];
+    if (key[0] != FIELD_SEPARATOR  // avoid duplicates: instances stored multiple times have a special key
+        && (type == 'P' ? withPassive : type == 'W' ? withWrite : withRead)) {
+      for (const auto message : nameIt->second) {
+        if (matchesFilter(message, "", lname, levels, completeMatch, withRead, withWrite, withPassive,
+            includeEmptyLevel, onlyAvailable)
+            && (until == 0 || (message->getDstAddress() != SYN
+            && (changedSince ? message->getLastChangeTime() : message->getLastUpdateTime()) < until))) {
+          messages->push_back(message);
         }
       }
-      if (!onlyAvailable || message->isAvailable()) {
-        messages->push_back(message);
-      }
     }
+    ++nameIt;
   }
 }
 
-Message* MessageMap::getFirstAvailableFromIterator(const map<uint64_t, vector<Message*> >::const_iterator& it,
+Message* MessageMap::getFirstAvailableFromIterator(
+    const unordered_map<uint64_t, vector<Message*> >::const_iterator& it,
     const MasterSymbolString* sameIdExtAs, bool onlyAvailable) const {
   if (it != m_messagesByKey.end()) {
     return getFirstAvailable(it->second, sameIdExtAs, onlyAvailable);
@@ -2729,11 +3220,22 @@ Message* MessageMap::find(const MasterSymbolString& master, bool anyDestination,
   if (baseKey == INVALID_KEY) {
     return nullptr;
   }
+  const auto maskIt = m_decodeMasks.find(getDecodeHeader(baseKey));
+  if (maskIt == m_decodeMasks.end()) {
+    return nullptr;
+  }
+  // only probe the keys with ID length and source kind known to be present
+  uint32_t mask = maskIt->second;
   bool isWriteDest = isMaster(master[1]) || master[1] == BROADCAST;
   for (size_t idLength = maxIdLength; true; idLength--) {
     uint64_t key = baseKey;
     if (idLength == maxIdLength) {
       baseKey &= ~ID_LENGTH_AND_IDS_MASK;
+    } else if ((mask & (0xfU << (4 * (idLength & 7)))) == 0) {
+      if (idLength == 0) {
+        break;
+      }
+      continue;  // nothing with this ID length
     } else {
       key |= (uint64_t)idLength << (8 * 7 + 5);
       int exp = 3;
@@ -2745,7 +3247,7 @@ Message* MessageMap::find(const MasterSymbolString& master, bool anyDestination,
       }
     }
     Message* message;
-    if (withPassive) {
+    if (withPassive && (mask & getDecodeBit(key))) {
       message = getFirstAvailableFromIterator(m_messagesByKey.find(key), &master, onlyAvailable);
       if (message) {
         return message;
@@ -2753,7 +3255,7 @@ Message* MessageMap::find(const MasterSymbolString& master, bool anyDestination,
     }
     if ((key & ID_SOURCE_MASK) != 0) {
       key &= ~ID_SOURCE_MASK;
-      if (withPassive) {
+      if (withPassive && (mask & getDecodeBit(key))) {
         // try again without specific source master
         message = getFirstAvailableFromIterator(m_messagesByKey.find(key), &master, onlyAvailable);
         if (message) {
@@ -2763,20 +3265,22 @@ Message* MessageMap::find(const MasterSymbolString& master, bool anyDestination,
     }
     if (withRead) {
       // try again with special value for active read
-      message = getFirstAvailableFromIterator(
-        m_messagesByKey.find(key | (isWriteDest ? ID_SOURCE_ACTIVE_READ_MASTER : ID_SOURCE_ACTIVE_READ)),
-        &master, onlyAvailable);
-      if (message) {
-        return message;
+      uint64_t readKey = key | (isWriteDest ? ID_SOURCE_ACTIVE_READ_MASTER : ID_SOURCE_ACTIVE_READ);
+      if (mask & getDecodeBit(readKey)) {
+        message = getFirstAvailableFromIterator(m_messagesByKey.find(readKey), &master, onlyAvailable);
+        if (message) {
+          return message;
+        }
       }
     }
     if (withWrite) {
       // try again with special value for active write
-      message = getFirstAvailableFromIterator(
-        m_messagesByKey.find(key | (isWriteDest ? ID_SOURCE_ACTIVE_WRITE_MASTER : ID_SOURCE_ACTIVE_WRITE)),
-        &master, onlyAvailable);
-      if (message) {
-        return message;
+      uint64_t writeKey = key | (isWriteDest ? ID_SOURCE_ACTIVE_WRITE_MASTER : ID_SOURCE_ACTIVE_WRITE);
+      if (mask & getDecodeBit(writeKey)) {
+        message = getFirstAvailableFromIterator(m_messagesByKey.find(writeKey), &master, onlyAvailable);
+        if (message) {
+          return message;
+        }
       }
     }
     if (idLength == 0) {
@@ -2791,23 +3295,158 @@ void MessageMap::invalidateCache(Message* message) {
   if (message->m_data == DataFieldSet::getIdentFields()) {
     return;
   }
-  message->m_lastUpdateTime = 0;
-  string circuit = message->getCircuit();
-  string name = message->getName();
-  deque<Message*> messages;
-  findAll(circuit, name, "*", true, true, true, true, true, true, 0, 0, false, &messages);
-  for (auto checkMessage : messages) {
-    if (checkMessage != message) {
-      checkMessage->m_lastUpdateTime = 0;
+  m_updateMutex.lock();
+  Message* checkMessage = message;
+  do {
+    checkMessage->m_lastUpdateTime = 0;
+    uint64_t sequence = checkMessage->m_lastUpdateSequence;
+    checkMessage->m_lastUpdateSequence = 0;
+    releaseJournalEntry(checkMessage, sequence);
+    if (checkMessage->m_updateMap == this) {
+      unlinkMessage(checkMessage, &Message::m_updatePrev, &Message::m_updateNext, &m_firstUpdated, &m_lastUpdated);
+    }
+    checkMessage = checkMessage->m_siblingNext;
+  } while (checkMessage != message);
+  m_updateMutex.unlock();
+}
+
+void MessageMap::messageUpdated(Message* message, bool updated, bool changed) {
+  m_updateMutex.lock();
+  if (message->m_updateMap == this) {
+    m_lastSequence++;
+    m_journal[m_lastSequence % MESSAGE_JOURNAL_SIZE] = message;
+    uint64_t updateSequence = message->m_lastUpdateSequence, changeSequence = message->m_lastChangeSequence;
+    if (updated) {
+      message->m_lastUpdateSequence = m_lastSequence;
+      appendMessage(message, &Message::m_updatePrev, &Message::m_updateNext, &m_firstUpdated, &m_lastUpdated);
+    }
+    if (changed) {
+      message->m_lastChangeSequence = m_lastSequence;
+      appendMessage(message, &Message::m_changePrev, &Message::m_changeNext, &m_firstChanged, &m_lastChanged);
+    }
+    // keep only the journal entries of the last update and change so that remove() can find all of them
+    releaseJournalEntry(message, updateSequence);
+    releaseJournalEntry(message, changeSequence);
+  }
+  m_updateMutex.unlock();
+}
+
+void MessageMap::messageAvailabilityChanged(Message* message) {
+  m_updateMutex.lock();
+  if (message->m_updateMap == this && !message->m_availabilityPending) {
+    message->m_availabilityPending = true;
+    m_availabilityChanged.push_back(message);
+  }
+  m_updateMutex.unlock();
+}
+
+bool MessageMap::takeAvailabilityChanged(deque<Message*>* messages) {
+  m_updateMutex.lock();
+  bool found = !m_availabilityChanged.empty();
+  for (const auto message : m_availabilityChanged) {
+    message->m_availabilityPending = false;
+    messages->push_back(message);
+  }
+  m_availabilityChanged.clear();
+  m_updateMutex.unlock();
+  return found;
+}
+
+uint64_t MessageMap::getLastSequence() const {
+  m_updateMutex.lock();
+  uint64_t sequence = m_lastSequence;
+  m_updateMutex.unlock();
+  return sequence;
+}
+
+bool MessageMap::findUpdated(const string& circuit, const string& name, const string& levels, bool completeMatch,
+    bool withWrite, uint64_t sinceSequence, bool changedSince, uint64_t* lastSequence,
+    deque<Message*>* messages) const {
+  string lcircuit = circuit;
+  FileReader::tolower(&lcircuit);
+  string lname = name;
+  FileReader::tolower(&lname);
+  m_updateMutex.lock();
+  *lastSequence = m_lastSequence;
+  if (sinceSequence > m_lastSequence || m_lastSequence - sinceSequence > MESSAGE_JOURNAL_SIZE) {
+    m_updateMutex.unlock();
+    return false;
+  }
+  for (uint64_t sequence = sinceSequence + 1; sequence <= m_lastSequence; sequence++) {
+    Message* message = m_journal[sequence % MESSAGE_JOURNAL_SIZE];
+    // only the latest journal entry of a message counts in order to report each one only once
+    if (!message || (changedSince ? message->m_lastChangeSequence : message->m_lastUpdateSequence) != sequence
+        || message->getDstAddress() == SYN) {
+      continue;
+    }
+    if (matchesFilter(message, lcircuit, lname, levels, completeMatch, true, withWrite, true, true, true)) {
+      messages->push_back(message);
     }
   }
+  m_updateMutex.unlock();
+  return true;
+}
+
+void MessageMap::releaseJournalEntry(const Message* message, uint64_t sequence) {
+  if (sequence == 0) {
+    return;
+  }
+  size_t slot = sequence % MESSAGE_JOURNAL_SIZE;
+  if (m_journal[slot] != message
+      || (message->m_lastUpdateSequence > 0 && message->m_lastUpdateSequence % MESSAGE_JOURNAL_SIZE == slot)
+      || (message->m_lastChangeSequence > 0 && message->m_lastChangeSequence % MESSAGE_JOURNAL_SIZE == slot)) {
+    return;  // overwritten meanwhile or still in use
+  }
+  m_journal[slot] = nullptr;
+}
+
+void MessageMap::unlinkMessage(Message* message, Message* Message::*prev, Message* Message::*next, Message** first,
+    Message** last) {
+  if (message->*prev) {
+    (message->*prev)->*next = message->*next;
+  } else if (*first == message) {
+    *first = message->*next;
+  } else {
+    return;  // not linked
+  }
+  if (message->*next) {
+    (message->*next)->*prev = message->*prev;
+  } else {
+    *last = message->*prev;
+  }
+  message->*prev = message->*next = nullptr;
+}
+
+void MessageMap::appendMessage(Message* message, Message* Message::*prev, Message* Message::*next, Message** first,
+    Message** last) {
+  if (*last == message) {
+    return;  // already the most recent one
+  }
+  unlinkMessage(message, prev, next, first, last);
+  message->*prev = *last;
+  if (*last) {
+    (*last)->*next = message;
+  } else {
+    *first = message;
+  }
+  *last = message;
 }
 
 void MessageMap::addPollMessage(bool toFront, Message* message) {
   if (message != nullptr && message->getPollPriority() > 0) {
     lock();
-    message->m_lastPollTime = toFront ? 0 : m_pollMessages.size();
-    m_pollMessages.push(message);
+    if (m_pollByPeriod || message->hasPollPeriod()) {
+      if (toFront) {
+        m_pollMessages.schedule(message, 0, 0);
+      } else if (!m_pollMessages.contains(message)) {
+        m_pollMessages.schedule(message, 0, m_nextPollOrder++);
+      }
+    } else if (toFront) {
+      m_cyclePollMessages.schedule(message, m_lastCycleSlot, 0);
+    } else if (!m_cyclePollMessages.contains(message)) {
+      m_cyclePollMessages.schedule(message, m_lastCycleSlot + static_cast<time_t>(message->getPollPriority()),
+          m_nextPollOrder++);
+    }
     unlock();
   }
 }
@@ -2829,41 +3468,26 @@ void MessageMap::clear() {
   m_loadedFiles.clear();
   m_loadedFileInfos.clear();
   // clear poll messages
-  while (!m_pollMessages.empty()) {
-    m_pollMessages.pop();
-  }
-  // free message instances by name
-  for (auto it : m_messagesByName) {
-    vector<Message*> nameMessages = it.second;
+  m_pollMessages.clear();
+  m_stalePollMessages.clear();
+  m_cyclePollMessages.clear();
+  m_lastCycleSlot = 0;
+  // collect the message instances stored by name and by key to free each of them once
+  vector<Message*> messages;
+  messages.reserve(m_messageCount + m_passiveMessageCount);
+  for (const auto& it : m_messagesByName) {
     if (it.first[0] == FIELD_SEPARATOR) {  // avoid double free: instances stored multiple times have a special key
       continue;
     }
-    for (Message* message : it.second) {
-      const auto keyIt = m_messagesByKey.find(message->getKey());
-      if (keyIt != m_messagesByKey.end()) {
-        vector<Message*>* keyMessages = &keyIt->second;
-        if (!keyMessages->empty()) {
-          auto kit = keyMessages->begin();
-          while (kit != keyMessages->end()) {
-            if (*kit == message) {
-              kit = keyMessages->erase(kit);
-            } else {
-              kit++;
-            }
-          }
-        }
-      }
-      delete message;
-    }
-    it.second.clear();
+    messages.insert(messages.end(), it.second.begin(), it.second.end());
   }
-  // free remaining message instances by key
   for (const auto& it : m_messagesByKey) {
-    vector<Message*> keyMessages = it.second;
-    for (auto message : keyMessages) {
-      delete message;
-    }
-    keyMessages.clear();
+    messages.insert(messages.end(), it.second.begin(), it.second.end());
+  }
+  sort(messages.begin(), messages.end());
+  messages.erase(unique(messages.begin(), messages.end()), messages.end());
+  for (const auto message : messages) {
+    delete message;
   }
   // free condition instances
   for (const auto& it : m_conditions) {
@@ -2871,19 +3495,26 @@ void MessageMap::clear() {
   }
   // free instruction instances
   for (const auto& it : m_instructions) {
-    vector<Instruction*> instructions = it.second;
-    for (const auto instruction : instructions) {
+    for (const auto instruction : it.second) {
       delete instruction;
     }
-    instructions.clear();
   }
   // clear messages by name
   m_messageCount = 0;
   m_conditionalMessageCount = 0;
   m_passiveMessageCount = 0;
   m_messagesByName.clear();
+  m_messagesByNameHash.clear();
+  m_circuitKeys.clear();
+  m_updateMutex.lock();
+  m_firstUpdated = m_lastUpdated = m_firstChanged = m_lastChanged = nullptr;
+  // keep the sequence number for not confusing the callers of findUpdated()
+  m_journal.assign(MESSAGE_JOURNAL_SIZE, nullptr);
+  m_availabilityChanged.clear();
+  m_updateMutex.unlock();
   // clear messages by key
   m_messagesByKey.clear();
+  m_decodeMasks.clear();
   m_conditions.clear();
   m_instructions.clear();
   for (const auto& it : m_circuitData) {
@@ -2892,25 +3523,121 @@ void MessageMap::clear() {
   m_circuitData.clear();
   m_maxIdLength = m_maxBroadcastIdLength = 0;
   m_additionalScanMessages = false;
+  // let the next load start with a fresh chunk so that the ones of this load are released with their last object
+  m_arena->close();
 }
 
-Message* MessageMap::getNextPoll() {
-  if (m_pollMessages.empty()) {
+Message* MessageMap::getNextPoll(time_t now, unsigned int baseInterval, bool overBudget) {
+  if (m_pollMessages.empty() && m_cyclePollMessages.empty()) {
     return nullptr;
   }
   lock();
-  Message* ret = m_pollMessages.top();
-  m_pollMessages.pop();
-  if (ret->m_pollOrder > g_lastPollOrder) {
-    g_lastPollOrder = ret->m_pollOrder;
-  }
-  ret->m_pollOrder += (unsigned int)ret->m_pollPriority;
-  time(&(ret->m_lastPollTime));
-  m_pollMessages.push(ret);  // re-insert at new position
+  Message* ret = getNextPeriodPoll(now, baseInterval, overBudget);
+  if (!ret && !overBudget) {
+    ret = getNextCyclePoll(now, baseInterval);
+  }
   unlock();
   return ret;
 }
 
+time_t MessageMap::getLastPassiveTime(const Message* message) const {
+  m_updateMutex.lock();
+  time_t seen = 0;
+  const Message* checkMessage = message;
+  do {
+    if (checkMessage->m_lastPassiveTime > seen) {
+      seen = checkMessage->m_lastPassiveTime;
+    }
+    checkMessage = checkMessage->m_siblingNext;
+  } while (checkMessage != message);
+  m_updateMutex.unlock();
+  return seen;
+}
+
+Message* MessageMap::getNextPeriodPoll(time_t now, unsigned int baseInterval, bool overBudget) {
+  Message* ret;
+  while ((ret = m_pollMessages.top()) != nullptr) {
+    if (ret->getPollPriority() == 0) {  // polling was disabled in the meantime
+      m_pollMessages.remove(ret);
+      m_stalePollMessages.remove(ret);
+      continue;
+    }
+    if (ret->m_pollDue > now) {
+      ret = nullptr;
+      break;
+    }
+    time_t seen = getLastPassiveTime(ret);
+    time_t fresh = seen + ret->getPollPeriod(baseInterval);
+    if (seen == 0 || fresh <= now) {
+      break;
+    }
+    // postpone until the passively seen value becomes outdated
+    m_pollMessages.schedule(ret, fresh, m_nextPollOrder++);
+    m_suppressedPollCount++;
+  }
+  if (ret && overBudget) {
+    // only the most overdue stale one may be polled, which is not necessarily the one due first
+    while ((ret = m_stalePollMessages.top()) != nullptr) {
+      if (ret->getPollPriority() == 0) {  // polling was disabled in the meantime
+        m_pollMessages.remove(ret);
+        m_stalePollMessages.remove(ret);
+        continue;
+      }
+      time_t stale = ret->getPollStaleTime(baseInterval);
+      if (stale == ret->m_staleDue) {
+        break;
+      }
+      // updated in the meantime
+      m_stalePollMessages.schedule(ret, stale, ret->m_staleOrder);
+    }
+    if (ret && (ret->m_staleDue > now || ret->m_pollDue > now)) {
+      ret = nullptr;  // the most overdue one is not stale yet or not due
+    }
+  }
+  if (!ret) {
+    return nullptr;
+  }
+  ret->m_lastPollTime = now;
+  m_stalePollMessages.schedule(ret, ret->getPollStaleTime(baseInterval), m_nextPollOrder);
+  time_t due = now + ret->getPollPeriod(baseInterval);
+  unsigned int jitter = ret->getPollJitter(baseInterval);
+  if (jitter > 0) {
+    due += static_cast<time_t>(rand() % (2 * jitter + 1)) - jitter;
+  }
+  m_pollMessages.schedule(ret, due > now ? due : now + 1, m_nextPollOrder++);
+  return ret;
+}
+
+Message* MessageMap::getNextCyclePoll(time_t now, unsigned int baseInterval) {
+  if (m_lastCyclePoll != 0 && difftime(now, m_lastCyclePoll) <= baseInterval) {
+    return nullptr;  // at most one poll per interval
+  }
+  Message* ret;
+  while ((ret = m_cyclePollMessages.top()) != nullptr && ret->getPollPriority() == 0) {
+    m_cyclePollMessages.remove(ret);  // polling was disabled in the meantime
+  }
+  if (!ret) {
+    return nullptr;
+  }
+  m_lastCyclePoll = now;
+  if (ret->m_pollDue > m_lastCycleSlot) {
+    m_lastCycleSlot = ret->m_pollDue;
+  }
+  ret->m_lastPollTime = now;
+  // move behind all others with a lower poll priority
+  m_cyclePollMessages.schedule(ret, ret->m_pollDue + static_cast<time_t>(ret->getPollPriority()),
+      m_nextPollOrder++);
+  time_t seen = getLastPassiveTime(ret);
+  if (seen != 0 && seen + ret->getPollPeriod(baseInterval) > now) {
+    m_suppressedPollCount++;
+    return nullptr;  // the passively seen value is still fresh
+  }
+  if (difftime(now, ret->getLastUpdateTime()) <= baseInterval) {
+    return nullptr;  // updated already by other means within the interval
+  }
+  return ret;
+}
+
 void MessageMap::dump(bool withConditions, OutputFormat outputFormat, ostream* output, AddAttributes* addAttrs) const {
   bool first = true;
   bool isJson = (outputFormat & OF_JSON) != 0;
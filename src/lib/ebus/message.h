@@ -24,7 +24,7 @@
 #include <vector>
 #include <deque>
 #include <map>
-#include <queue>
+#include <unordered_map>
 #include "lib/ebus/data.h"
 #include "lib/ebus/result.h"
 #include "lib/ebus/symbol.h"
@@ -58,14 +58,41 @@ namespace ebusd {
  * template class.
  */
 
-using std::priority_queue;
 using std::deque;
+using std::unordered_map;
+using std::unordered_multimap;
 
 class Condition;
 class SimpleCondition;
 class CombinedCondition;
 class AddAttributes;
 class MessageMap;
+class PollScheduler;
+
+
+/** the maximum number of decoding results cached per @a Message. */
+#define DECODE_CACHE_SIZE 4
+
+/** the divisor of the poll period for the default poll jitter (i.e. 10%). */
+#define POLL_JITTER_DIVISOR 10
+
+/** the factor of the poll period for the default maximum staleness. */
+#define POLL_MAX_STALE_FACTOR 3
+
+/**
+ * A cached result of Message#decodeLastData().
+ */
+typedef struct decode_cache_entry {
+  unsigned int dataVersion;   //!< the data version of the @a Message that was decoded
+  PartType part;              //!< the decoded part
+  bool leadingSeparator;      //!< whether a separator was prepended
+  bool allFields;             //!< whether no field name was given
+  string fieldName;           //!< the field name the output was limited to
+  ssize_t fieldIndex;         //!< the field index the output was limited to, or -1
+  OutputFormat outputFormat;  //!< the @a OutputFormat options used
+  result_t result;            //!< the decoding result
+  string output;              //!< the formatted output
+} decode_cache_entry_t;
 
 
 /**
@@ -73,6 +100,8 @@ class MessageMap;
  */
 class Message : public AttributedItem {
   friend class MessageMap;
+  friend class Condition;
+  friend class PollScheduler;
  public:
   /**
    * Construct a new instance.
@@ -388,16 +417,22 @@ class Message : public AttributedItem {
   bool isConditional() const { return m_condition != nullptr; }
 
   /**
-   * Return whether this @a Message is available (optionally depending on a @a Condition evaluation).
+   * Return whether this @a Message is available (optionally depending on the last @a Condition evaluation).
    * @return true when this @a Message is available.
    */
-  bool isAvailable();
+  bool isAvailable() const;
+
+  /**
+   * Get the time when this (potentially conditional) message last became available.
+   * @return the time when this message last became available, or 0 if it is not available.
+   */
+  time_t getAvailableSinceTime() const;
 
   /**
-   * Get the time when this (potentially conditional) message first became available.
-   * @return the time when this message first became available, or 0 if it is not available.
+   * Add a @a Condition referring to this @a Message that needs to be updated on every change of the data.
+   * @param condition the dependent @a Condition.
    */
-  time_t getAvailableSinceTime();
+  void addDependentCondition(Condition* condition);
 
   /**
    * Return whether the field is available.
@@ -484,6 +519,25 @@ class Message : public AttributedItem {
   virtual result_t decodeLastData(PartType part, bool leadingSeparator, const char* fieldName,
       ssize_t fieldIndex, const OutputFormat outputFormat, ostream* output) const;
 
+  /**
+   * Decode value(s) from the last stored data without using the cache of formatted results.
+   * @param part the part to decode.
+   * @param leadingSeparator whether to prepend a separator before the formatted value.
+   * @param fieldName the optional name of a field to limit the output to.
+   * @param fieldIndex the optional index of the field to limit the output to (either named or overall), or -1.
+   * @param outputFormat the @a OutputFormat options to use.
+   * @param output the @a ostream to append the formatted value to.
+   * @return @a RESULT_OK on success, or an error code.
+   */
+  result_t decodeLastDataUncached(PartType part, bool leadingSeparator, const char* fieldName,
+      ssize_t fieldIndex, const OutputFormat outputFormat, ostream* output) const;
+
+  /**
+   * Get the version of the last stored data that is incremented whenever the data changes.
+   * @return the version of the last stored data.
+   */
+  unsigned int getDataVersion() const { return m_dataVersion; }
+
   /**
    * Decode a particular numeric field value from the last stored data.
    * @param fieldName the name of the field to decode, or nullptr for the first field.
@@ -493,6 +547,24 @@ class Message : public AttributedItem {
    */
   virtual result_t decodeLastDataNumField(const char* fieldName, ssize_t fieldIndex, unsigned int* output) const;
 
+  /**
+   * Decode the typed values of all non-ignored fields from the last stored data.
+   * The compiled @a DecodeProgram is used when available.
+   * @param values the @a DataValueList to fill (cleared first).
+   * @return @a RESULT_OK on success, @a RESULT_EMPTY if no field was decoded, or an error code.
+   */
+  result_t decodeLastValues(DataValueList* values) const;
+
+  /**
+   * Decode the numeric values of a single field from many stored telegrams of this message at once.
+   * @param fieldIndex the index of the field (excluding ignored fields).
+   * @param data the @a SymbolString instances of the part of the field (i.e. either master or slave data).
+   * @param output the @a vector to fill with the values having the divisor applied (NaN for the replacement value
+   * or invalid data).
+   * @return @a RESULT_OK on success, or an error code.
+   */
+  result_t decodeColumn(ssize_t fieldIndex, const vector<const SymbolString*>& data, vector<double>* output) const;
+
   /**
    * Get the last seen master data.
    * @return the last seen @a MasterSymbolString.
@@ -537,6 +609,25 @@ class Message : public AttributedItem {
    */
   time_t getLastChangeTime() const { return m_lastChangeTime; }
 
+  /**
+   * Get the sequence number of the last update of this message in the journal of the @a MessageMap.
+   * @return the sequence number of the last update, or 0.
+   */
+  uint64_t getLastUpdateSequence() const { return m_lastUpdateSequence; }
+
+  /**
+   * Get the sequence number of the last change of this message in the journal of the @a MessageMap.
+   * @return the sequence number of the last change, or 0.
+   */
+  uint64_t getLastChangeSequence() const { return m_lastChangeSequence; }
+
+  /**
+   * Get the next @a Message with the same circuit and name (i.e. the read/write/passive variants and conditional
+   * alternatives) stored in the @a MessageMap.
+   * @return the next @a Message of the ring of siblings, or this instance when there is none.
+   */
+  Message* getNextSibling() const { return m_siblingNext; }
+
   /**
    * Get the time when this message was last polled for.
    * @return the time when this message was last polled for, or 0 for never.
@@ -544,11 +635,57 @@ class Message : public AttributedItem {
   time_t getLastPollTime() const { return m_lastPollTime; }
 
   /**
-   * Return whether this @a Message needs to be polled after the other one.
-   * @param other the other @a Message to compare with.
-   * @return true if this @a Message needs to be polled after the other one.
+   * Get the time when this message is due for the next poll.
+   * @return the time when this message is due for the next poll, or 0 for as soon as possible.
+   */
+  time_t getPollDueTime() const { return m_pollDue; }
+
+  /**
+   * Return whether the "pollperiod" attribute is set.
+   * @return whether the "pollperiod" attribute is set.
    */
-  bool isLessPollWeight(const Message* other) const;
+  bool hasPollPeriod() const { return m_pollPeriod > 0; }
+
+  /**
+   * Get the target period between two polls (either from the "pollperiod" attribute, or the poll priority).
+   * @param baseInterval the poll period in seconds for poll priority 1.
+   * @return the target period between two polls in seconds.
+   */
+  unsigned int getPollPeriod(unsigned int baseInterval) const;
+
+  /**
+   * Get the maximum deviation from the poll period (either from the "polljitter" attribute, or 10% of the period).
+   * @param baseInterval the poll period in seconds for poll priority 1.
+   * @return the maximum deviation from the poll period in seconds.
+   */
+  unsigned int getPollJitter(unsigned int baseInterval) const;
+
+  /**
+   * Get the maximum age of the data after which polling ignores the bus budget (either from the "maxstale"
+   * attribute, or three times the period).
+   * @param baseInterval the poll period in seconds for poll priority 1.
+   * @return the maximum age of the data in seconds.
+   */
+  unsigned int getPollMaxStale(unsigned int baseInterval) const;
+
+  /**
+   * Get the time when the data of this message becomes older than its maximum staleness.
+   * @param baseInterval the poll period in seconds for poll priority 1.
+   * @return the system time when the data becomes stale, or 0 if it was never updated or polled.
+   */
+  time_t getPollStaleTime(unsigned int baseInterval) const;
+
+  /**
+   * Get the time when this message was last seen in traffic not initiated by this participant.
+   * @return the time when this message was last seen passively, or 0 for never.
+   */
+  time_t getLastPassiveTime() const { return m_lastPassiveTime; }
+
+  /**
+   * Set the time when this message was last seen in traffic not initiated by this participant.
+   * @param time the time when this message was seen passively.
+   */
+  void setLastPassiveTime(time_t time) { m_lastPassiveTime = time; }
 
   /**
    * Write the message definition header or parts of it to the @a ostream.
@@ -596,6 +733,11 @@ class Message : public AttributedItem {
   */
   virtual void dumpIdsJson(ostringstream* output) const;
 
+  /**
+   * Update the dependent @a Condition instances after the data changed.
+   */
+  void updateDependentConditions();
+
   /** the source filename. */
   const string m_filename;
 
@@ -662,15 +804,33 @@ class Message : public AttributedItem {
   /** the @a Condition for this message, or nullptr. */
   Condition* m_condition;
 
-  /** the time when the @a Condition first became available, or 0. */
+  /** the time when the @a Condition last became available, or 0. */
   time_t m_availableSinceTime;
 
+  /** the @a Condition instances referring to this message to be updated on every change of the data. */
+  vector<Condition*> m_dependentConditions;
+
+  /** whether this message is pending in the availability changes of @a m_updateMap. */
+  bool m_availabilityPending;
+
   /** the last seen @a MasterSymbolString. */
   MasterSymbolString m_lastMasterData;
 
   /** the last seen @a SlaveSymbolString. */
   SlaveSymbolString m_lastSlaveData;
 
+  /** the version of @a m_lastMasterData and @a m_lastSlaveData, incremented on every change. */
+  unsigned int m_dataVersion;
+
+  /** the cached results of @a decodeLastData() (guarded by a shared mutex). */
+  mutable vector<decode_cache_entry_t> m_decodeCache;
+
+  /** the index of the next entry in @a m_decodeCache to replace. */
+  mutable size_t m_decodeCacheNext;
+
+  /** the @a DecodeProgram compiled from @a m_data for @a decodeLastValues(). */
+  DecodeProgram m_decodeProgram;
+
   /** the system time when the message was created or changed in poll priority. */
   time_t m_createTime;
 
@@ -683,11 +843,65 @@ class Message : public AttributedItem {
   /** the system time when the message content was last changed, 0 for never. */
   time_t m_lastChangeTime;
 
-  /** the polling order of this message (roughly number of polls * priority). */
-  unsigned int m_pollOrder;
+  /** the target period between two polls in seconds from the "pollperiod" attribute, or 0 for the default. */
+  unsigned int m_pollPeriod;
+
+  /** the maximum deviation from the poll period in seconds from the "polljitter" attribute, or 0 for the default. */
+  unsigned int m_pollJitter;
+
+  /** the maximum age of the data in seconds from the "maxstale" attribute, or 0 for the default. */
+  unsigned int m_pollMaxStale;
+
+  /** the system time when this message is due for the next poll, 0 for as soon as possible. */
+  time_t m_pollDue;
+
+  /** the order of messages with the same @a m_pollDue (lower first). */
+  uint64_t m_pollOrder;
+
+  /** the index in the heap of the @a PollScheduler, or SIZE_MAX if not scheduled. */
+  size_t m_pollIndex;
+
+  /** the system time when the data of this message becomes stale as scheduled in the stale @a PollScheduler. */
+  time_t m_staleDue;
+
+  /** the order of messages with the same @a m_staleDue (lower first). */
+  uint64_t m_staleOrder;
+
+  /** the index in the heap of the stale @a PollScheduler, or SIZE_MAX if not scheduled. */
+  size_t m_staleIndex;
 
   /** the system time when this message was last polled for, 0 for never. */
   time_t m_lastPollTime;
+
+  /** the system time when this message was last seen in traffic not initiated by this participant, 0 for never. */
+  time_t m_lastPassiveTime;
+
+  /** the @a MessageMap to notify about updates and changes, or nullptr. */
+  MessageMap* m_updateMap;
+
+  /** the previous @a Message in the update order of @a m_updateMap, or nullptr. */
+  Message* m_updatePrev;
+
+  /** the next @a Message in the update order of @a m_updateMap, or nullptr. */
+  Message* m_updateNext;
+
+  /** the previous @a Message in the change order of @a m_updateMap, or nullptr. */
+  Message* m_changePrev;
+
+  /** the next @a Message in the change order of @a m_updateMap, or nullptr. */
+  Message* m_changeNext;
+
+  /** the sequence number of the last update in the journal of @a m_updateMap, 0 for never. */
+  uint64_t m_lastUpdateSequence;
+
+  /** the sequence number of the last change in the journal of @a m_updateMap, 0 for never. */
+  uint64_t m_lastChangeSequence;
+
+  /** the previous @a Message in the ring of siblings with the same circuit and name, or this instance. */
+  Message* m_siblingPrev;
+
+  /** the next @a Message in the ring of siblings with the same circuit and name, or this instance. */
+  Message* m_siblingNext;
 };
 
 
@@ -796,63 +1010,130 @@ class ChainedMessage : public Message {
 
 
 /**
- * A function that compares the weighted poll priority of two @a Message instances.
+ * A deadline scheduler for polling @a Message instances (a binary min heap ordered by the time each
+ * @a Message is due, with the heap index stored in the @a Message for updating and removing in O(log n)).
  */
-struct compareMessagePriority {
+class PollScheduler {
+ public:
   /**
-   * Compare the weighted poll priority of the two @a Message instances.
-   * @param x the first @a Message.
-   * @param y the second @a Message.
-   * @return whether @a x is smaller than @a y with regard to their weighted poll priority.
+   * Construct a new instance.
+   * @param byStaleTime true to order by the time the data becomes stale (using separate fields in the
+   * @a Message), false to order by the time the @a Message is due for polling.
    */
-  bool operator() (Message* x, Message* y) const { return x->isLessPollWeight(y); }
-};
+  explicit PollScheduler(bool byStaleTime = false)
+    : m_due(byStaleTime ? &Message::m_staleDue : &Message::m_pollDue),
+    m_order(byStaleTime ? &Message::m_staleOrder : &Message::m_pollOrder),
+    m_index(byStaleTime ? &Message::m_staleIndex : &Message::m_pollIndex) {}
+
+  /**
+   * Destructor.
+   */
+  ~PollScheduler() {}
+
+
+ private:
+  /**
+   * Hidden copy constructor.
+   * @param src the object to copy from.
+   */
+  PollScheduler(const PollScheduler& src);
 
 
-/**
- * Helper class extending @a priority_queue to hold distinct values only.
- */
-class MessagePriorityQueue
-  : public priority_queue<Message*, vector<Message*>, compareMessagePriority> {
  public:
   /**
-   * Add data to the queue and ensure it is contained only once.
-   * @param __x the element to add.
+   * @return the number of scheduled @a Message instances.
    */
-  void push(const value_type& __x) {
-    for (vector<Message*>::iterator it = c.begin(); it != c.end(); it++) {
-      if (*it == __x) {
-        c.erase(it);
-        break;
-      }
-    }
-    priority_queue<Message*, vector<Message*>, compareMessagePriority>::push(__x);
+  size_t size() const { return m_heap.size(); }
+
+  /**
+   * @return whether no @a Message is scheduled.
+   */
+  bool empty() const { return m_heap.empty(); }
+
+  /**
+   * @param message the @a Message to check.
+   * @return whether the @a Message is scheduled.
+   */
+  bool contains(const Message* message) const {
+    return message->*m_index < m_heap.size() && m_heap[message->*m_index] == message;
   }
+
   /**
-   * Remove data from the queue.
-   * @param __x the element to remove.
+   * @return the @a Message due first, or nullptr.
    */
-  void remove(const value_type& __x) {
-    for (vector<Message*>::iterator it = c.begin(); it != c.end(); it++) {
-      if (*it == __x) {
-        c.erase(it);
-        break;
-      }
-    }
+  Message* top() const { return m_heap.empty() ? nullptr : m_heap[0]; }
+
+  /**
+   * Schedule a @a Message or move it to a new due time.
+   * @param message the @a Message to schedule.
+   * @param due the system time when the @a Message is due.
+   * @param order the order of messages with the same due time (lower first).
+   */
+  void schedule(Message* message, time_t due, uint64_t order);
+
+  /**
+   * Remove a @a Message.
+   * @param message the @a Message to remove.
+   */
+  void remove(Message* message);
+
+  /**
+   * Remove all @a Message instances.
+   */
+  void clear();
+
+
+ private:
+  /**
+   * @param first the first @a Message.
+   * @param second the second @a Message.
+   * @return whether the first @a Message is due before the second one.
+   */
+  bool isBefore(const Message* first, const Message* second) const {
+    return first->*m_due < second->*m_due
+      || (first->*m_due == second->*m_due && first->*m_order < second->*m_order);
+  }
+
+  /**
+   * Place a @a Message at the heap index.
+   * @param index the heap index.
+   * @param message the @a Message to place.
+   */
+  void place(size_t index, Message* message) {
+    m_heap[index] = message;
+    message->*m_index = index;
   }
+
+  /**
+   * Restore the heap order for the @a Message at the heap index.
+   * @param index the heap index.
+   */
+  void update(size_t index);
+
+  /** the @a Message field with the time to order by. */
+  time_t Message::* const m_due;
+
+  /** the @a Message field with the order of messages with the same time. */
+  uint64_t Message::* const m_order;
+
+  /** the @a Message field with the heap index. */
+  size_t Message::* const m_index;
+
+  /** the binary min heap of scheduled @a Message instances. */
+  vector<Message*> m_heap;
 };
 
 
 /**
  * An abstract condition based on the value of one or more @a Message instances.
  */
-class Condition {
+class Condition : public ArenaObject {
  public:
   /**
    * Construct a new instance.
    */
   Condition()
-    : m_lastCheckTime(0), m_isTrue(false) { }
+    : m_isTrue(false) { }
 
   /**
    * Destructor.
@@ -914,24 +1195,62 @@ class Condition {
       ostringstream* errorMessage) = 0;
 
   /**
-   * Check and return whether this condition is fulfilled.
+   * Return whether this condition was fulfilled during the last evaluation.
    * @return whether this condition is fulfilled.
    */
-  virtual bool isTrue() = 0;
+  bool isTrue() const { return m_isTrue; }
 
   /**
-   * Get the system time when the condition was last checked.
-   * @return the system time when the condition was last checked, 0 for never.
+   * Add a @a CombinedCondition to update whenever the result of this condition changes.
+   * @param parent the @a CombinedCondition containing this condition.
    */
-  time_t getLastCheckTime() const { return m_lastCheckTime; }
+  void addParent(Condition* parent);
+
+  /**
+   * Add a @a Message depending on this condition for updating its availability whenever the result changes.
+   * @param message the dependent @a Message.
+   */
+  void addDependentMessage(Message* message);
+
+  /**
+   * Remove a @a Message previously added via @a addDependentMessage().
+   * @param message the dependent @a Message.
+   */
+  void removeDependentMessage(Message* message);
+
+  /**
+   * Re-evaluate this condition and push a changed result to the parents and dependent messages.
+   * @param now the current system time.
+   */
+  void update(time_t now);
 
 
  protected:
-  /** the system time when the condition was last checked, 0 for never. */
-  time_t m_lastCheckTime;
+  /**
+   * Evaluate whether this condition is currently fulfilled.
+   * @return whether this condition is fulfilled.
+   */
+  virtual bool evaluate() = 0;
 
-  /** whether the condition was @a true during the last check. */
+  /** whether the condition was @a true during the last evaluation. */
   bool m_isTrue;
+
+
+ private:
+  /**
+   * Re-evaluate this condition and push a changed result (with @a s_updateMutex being locked).
+   * @param now the current system time.
+   */
+  void propagate(time_t now);
+
+  /** the @a Mutex for serializing the updates of all conditions. */
+  static Mutex s_updateMutex;
+
+  /** the @a CombinedCondition instances containing this condition. */
+  vector<Condition*> m_parents;
+
+  /** the @a Message instances depending on this condition. */
+  vector<Message*> m_dependentMessages;
 };
 
 
@@ -979,9 +1298,6 @@ class SimpleCondition : public Condition {
   result_t resolve(void (*readMessageFunc)(Message* message), MessageMap* messages,
       ostringstream* errorMessage) override;
 
-  // @copydoc
-  bool isTrue() override;
-
   /**
    * Return whether the condition is based on a numeric value.
    * @return whether the condition is based on a numeric value.
@@ -998,6 +1314,9 @@ class SimpleCondition : public Condition {
    */
   virtual bool checkValue(const Message* message, const string& field) { return true; }
 
+  // @copydoc
+  bool evaluate() override;
+
   /** the value that matched in @a checkValue. */
   string m_matchedValue;
 
@@ -1147,8 +1466,10 @@ class CombinedCondition : public Condition {
   result_t resolve(void (*readMessageFunc)(Message* message), MessageMap* messages,
       ostringstream* errorMessage) override;
 
+
+ protected:
   // @copydoc
-  bool isTrue() override;
+  bool evaluate() override;
 
 
  private:
@@ -1160,7 +1481,7 @@ class CombinedCondition : public Condition {
 /**
  * An abstract instruction based on the value of one or more @a Message instances.
  */
-class Instruction {
+class Instruction : public ArenaObject {
  public:
   /**
    * Construct a new instance.
@@ -1345,6 +1666,9 @@ class AddAttributes {
 };
 
 
+/** the number of updates kept in the journal of @a MessageMap. */
+#define MESSAGE_JOURNAL_SIZE 4096
+
 /**
  * Holds a map of all known @a Message instances.
  */
@@ -1359,7 +1683,10 @@ class MessageMap : public MappedFileReader {
   explicit MessageMap(bool addAll = false, const string& preferLanguage = "", bool deleteData = true)
   : MappedFileReader::MappedFileReader(true, preferLanguage), m_resolver(nullptr),
     m_addAll(addAll), m_additionalScanMessages(false), m_maxIdLength(0), m_maxBroadcastIdLength(0),
-    m_messageCount(0), m_conditionalMessageCount(0), m_passiveMessageCount(0) {
+    m_messageCount(0), m_conditionalMessageCount(0), m_passiveMessageCount(0), m_firstUpdated(nullptr),
+    m_lastUpdated(nullptr), m_firstChanged(nullptr), m_lastChanged(nullptr), m_journal(MESSAGE_JOURNAL_SIZE),
+    m_lastSequence(0), m_arena(new Arena()), m_pollByPeriod(false), m_stalePollMessages(true), m_nextPollOrder(1),
+    m_lastCycleSlot(0), m_lastCyclePoll(0), m_suppressedPollCount(0) {
     m_scanMessage = Message::createScanMessage(false, deleteData);
     m_broadcastScanMessage = Message::createScanMessage(true, false);
   }
@@ -1377,6 +1704,7 @@ class MessageMap : public MappedFileReader {
       delete m_broadcastScanMessage;
       m_broadcastScanMessage = nullptr;
     }
+    m_arena->detach();
   }
 
   /**
@@ -1551,12 +1879,117 @@ class MessageMap : public MappedFileReader {
    * @param until the end time to which to add updates (exclusive, also removes messages with unset destination
    * address), or 0 to ignore.
    * @param changedSince true to use the last change time for the since/until range, false to use the last seen time.
-   * @param messages the @a deque to which to add the found @a Message instances.
+   * @param messages the @a deque to which to add the found @a Message instances (in order of the last seen/change
+   * time when since is set, in order of circuit and name otherwise).
    */
   void findAll(const string& circuit, const string& name, const string& levels,
     bool completeMatch, bool withRead, bool withWrite, bool withPassive, bool includeEmptyLevel, bool onlyAvailable,
     time_t since, time_t until, bool changedSince, deque<Message*>* messages) const;
 
+  /**
+   * Get the sequence number of the last update in the journal.
+   * @return the sequence number of the last update, or 0.
+   */
+  uint64_t getLastSequence() const;
+
+  /**
+   * @return the @a Arena owning the definitions loaded via @a readFromStream().
+   */
+  Arena* getArena() const { return m_arena; }
+
+  /**
+   * Find all @a Message instances updated or changed after the specified sequence number from the journal.
+   * Note: the caller may not free the returned instances.
+   * @param levels the access levels to match.
+   * @param sinceSequence the sequence number after which to add updates (exclusive).
+   * @param changedSince true to only add messages changed after the sequence number, false to add updated ones.
+   * @param lastSequence the variable in which to store the sequence number of the last update (to pass as
+   * @a sinceSequence on the next call).
+   * @param messages the @a deque to which to add the found @a Message instances (in order of the last update/change).
+   * @return true on success, false when the journal no longer contains all updates after the sequence number (in
+   * which case the caller has to fall back to @a findAll()).
+   */
+  bool findUpdated(const string& levels, uint64_t sinceSequence, bool changedSince, uint64_t* lastSequence,
+    deque<Message*>* messages) const {
+    return findUpdated("", "", levels, false, true, sinceSequence, changedSince, lastSequence, messages);
+  }
+
+  /**
+   * Find all @a Message instances matching the circuit and name updated or changed after the specified sequence
+   * number from the journal.
+   * Note: the caller may not free the returned instances.
+   * @param circuit the circuit name to match, or empty for any.
+   * @param name the message name to match, or empty for any.
+   * @param levels the access levels to match.
+   * @param completeMatch true for a complete match of circuit and name, false for a partial one.
+   * @param withWrite true to include write messages.
+   * @param sinceSequence the sequence number after which to add updates (exclusive).
+   * @param changedSince true to only add messages changed after the sequence number, false to add updated ones.
+   * @param lastSequence the variable in which to store the sequence number of the last update (to pass as
+   * @a sinceSequence on the next call).
+   * @param messages the @a deque to which to add the found @a Message instances (in order of the last update/change).
+   * @return true on success, false when the journal no longer contains all updates after the sequence number (in
+   * which case the caller has to fall back to @a findAll()).
+   */
+  bool findUpdated(const string& circuit, const string& name, const string& levels, bool completeMatch,
+    bool withWrite, uint64_t sinceSequence, bool changedSince, uint64_t* lastSequence,
+    deque<Message*>* messages) const;
+
+  /**
+   * Clear the entry of @a m_journal at the sequence number if it still refers to the @a Message and is neither its
+   * last update nor its last change (with @a m_updateMutex being locked).
+   * @param message the @a Message.
+   * @param sequence the previous sequence number of the @a Message, or 0.
+   */
+  void releaseJournalEntry(const Message* message, uint64_t sequence);
+
+  /**
+   * Remove the @a Message from a list in update or change order.
+   * @param message the @a Message to remove.
+   * @param prev the member with the previous @a Message in the list.
+   * @param next the member with the next @a Message in the list.
+   * @param first the variable with the first @a Message in the list.
+   * @param last the variable with the last @a Message in the list.
+   */
+  static void unlinkMessage(Message* message, Message* Message::*prev, Message* Message::*next, Message** first,
+      Message** last);
+
+  /**
+   * Move the @a Message to the end of a list in update or change order.
+   * @param message the @a Message to move.
+   * @param prev the member with the previous @a Message in the list.
+   * @param next the member with the next @a Message in the list.
+   * @param first the variable with the first @a Message in the list.
+   * @param last the variable with the last @a Message in the list.
+   */
+  static void appendMessage(Message* message, Message* Message::*prev, Message* Message::*next, Message** first,
+      Message** last);
+
+  /**
+   * Check whether the @a Message matches the filter of @a findAll().
+   * @param message the @a Message to check.
+   * @param lcircuit the lowercase circuit name to match, or empty for any.
+   * @param lname the lowercase message name to match, or empty for any.
+   * @param levels the access levels to match, or "*" for any.
+   * @param completeMatch true for a complete match of circuit and name, false for a partial one.
+   * @param withRead true to include read messages.
+   * @param withWrite true to include write messages.
+   * @param withPassive true to include passive messages.
+   * @param includeEmptyLevel true to also include messages with no access level.
+   * @param onlyAvailable true to include only available messages.
+   * @return true when the @a Message matches.
+   */
+  static bool matchesFilter(Message* message, const string& lcircuit, const string& lname,
+      const string& levels, bool completeMatch, bool withRead, bool withWrite, bool withPassive,
+      bool includeEmptyLevel, bool onlyAvailable);
+
+  /**
+   * Get the @a Message instances stored by name key and add an empty list if not yet present.
+   * @param nameKey the lowercase name key (see @a m_messagesByName).
+   * @return the @a Message instances stored by the name key.
+   */
+  vector<Message*>* getOrAddByName(const string& nameKey);
+
   /**
    * Get the first available @a Message from the first map iterator entry.
    * @param it the map iterator with list of @a Message instances to check.
@@ -1565,7 +1998,7 @@ class MessageMap : public MappedFileReader {
    * are currently not available (e.g. due to unresolved or false conditions).
    * @return the first available @a Message from the first map iterator entry.
    */
-  Message* getFirstAvailableFromIterator(const map<uint64_t, vector<Message*> >::const_iterator& it,
+  Message* getFirstAvailableFromIterator(const unordered_map<uint64_t, vector<Message*> >::const_iterator& it,
     const MasterSymbolString* sameIdExtAs, bool onlyAvailable) const;
 
   /**
@@ -1583,6 +2016,28 @@ class MessageMap : public MappedFileReader {
   Message* find(const MasterSymbolString& master, bool anyDestination = false, bool withRead = true,
       bool withWrite = true, bool withPassive = true, bool onlyAvailable = true) const;
 
+  /**
+   * Called by a @a Message stored in this instance when it was updated or changed.
+   * @param message the updated @a Message.
+   * @param updated whether the last update time was set.
+   * @param changed whether the last change time was set.
+   */
+  void messageUpdated(Message* message, bool updated, bool changed);
+
+  /**
+   * Called by a @a Condition when the availability of a @a Message stored in this instance changed.
+   * @param message the @a Message that became available or unavailable.
+   */
+  void messageAvailabilityChanged(Message* message);
+
+  /**
+   * Take all @a Message instances whose availability changed since the last call (each one only once).
+   * Note: the caller may not free the returned instances.
+   * @param messages the @a deque to which to add the @a Message instances (in order of the first change).
+   * @return true when at least one @a Message was added.
+   */
+  bool takeAvailabilityChanged(deque<Message*>* messages);
+
   /**
    * Invalidate cached data of the @a Message and all other instances with a matching name key.
    * @param message the @a Message to invalidate.
@@ -1642,14 +2097,35 @@ class MessageMap : public MappedFileReader {
    * Get the number of stored @a Message instances with a poll priority.
    * @return the the number of stored @a Message instances with a poll priority.
    */
-  size_t sizePoll() const { return m_pollMessages.size(); }
+  size_t sizePoll() const { return m_pollMessages.size() + m_cyclePollMessages.size(); }
 
   /**
-   * Get the next @a Message to poll.
+   * Set whether to poll every @a Message by its period (and within the bus budget) instead of cycling through the
+   * ones without "pollperiod" attribute at one poll per interval weighted by the poll priority.
+   * Note: has to be called before adding any @a Message.
+   * @param byPeriod true to poll every @a Message by its period.
+   */
+  void setPollByPeriod(bool byPeriod) { m_pollByPeriod = byPeriod; }
+
+  /**
+   * Get the next @a Message due for polling and schedule its next poll.
+   * A @a Message polled by period is due once its period passed. The other ones are cycled through by their poll
+   * priority with at most one poll per base interval.
+   * @param now the current system time.
+   * @param baseInterval the poll period in seconds for poll priority 1.
+   * @param overBudget true when the bus budget for polling is exhausted, i.e. only a @a Message with data older
+   * than its maximum staleness may be polled.
    * @return the next @a Message to poll, or nullptr.
    * Note: the caller may not free the returned instance.
    */
-  Message* getNextPoll();
+  Message* getNextPoll(time_t now, unsigned int baseInterval, bool overBudget = false);
+
+  /**
+   * Get the number of polls postponed or cycle slots skipped because of a fresh value seen passively for the
+   * same @a Message or a sibling with the same circuit and name.
+   * @return the number of suppressed polls.
+   */
+  size_t getSuppressedPollCount() const { return m_suppressedPollCount; }
 
   /**
    * Get the number of stored @a Condition instances.
@@ -1679,6 +2155,30 @@ class MessageMap : public MappedFileReader {
   size_t getMaxIdLength() const { return m_maxIdLength; }
 
  private:
+  /**
+   * Get the latest time the @a Message or a sibling with the same circuit and name was seen passively.
+   * @param message the @a Message to check.
+   * @return the latest time the @a Message or a sibling was seen passively, or 0 for never.
+   */
+  time_t getLastPassiveTime(const Message* message) const;
+
+  /**
+   * Get the next @a Message polled by period that is due (with @a lock() being held).
+   * @param now the current system time.
+   * @param baseInterval the poll period in seconds for poll priority 1.
+   * @param overBudget true when only a @a Message with data older than its maximum staleness may be polled.
+   * @return the next @a Message to poll, or nullptr.
+   */
+  Message* getNextPeriodPoll(time_t now, unsigned int baseInterval, bool overBudget);
+
+  /**
+   * Get the next @a Message to cycle through (with @a lock() being held).
+   * @param now the current system time.
+   * @param baseInterval the minimum interval in seconds between two polls.
+   * @return the next @a Message to poll, or nullptr.
+   */
+  Message* getNextCyclePoll(time_t now, unsigned int baseInterval);
+
   /** empty vector for @a getLoadedFiles(). */
   static vector<string> s_noFiles;
 
@@ -1721,11 +2221,74 @@ class MessageMap : public MappedFileReader {
   /** the known @a Message instances by lowercase circuit (optional), name, and type. */
   map<string, vector<Message*> > m_messagesByName;
 
+  /** the entries of @a m_messagesByName by case insensitive hash of the key (see @a getNameHash()). */
+  unordered_multimap<uint64_t, map<string, vector<Message*> >::iterator> m_messagesByNameHash;
+
+  /** the number of keys in @a m_messagesByName by lowercase circuit followed by @a FIELD_SEPARATOR. */
+  map<string, size_t> m_circuitKeys;
+
+  /** the @a Mutex for the update and change order lists. */
+  mutable Mutex m_updateMutex;
+
+  /** the least recently updated @a Message, or nullptr. */
+  Message* m_firstUpdated;
+
+  /** the most recently updated @a Message, or nullptr. */
+  Message* m_lastUpdated;
+
+  /** the least recently changed @a Message, or nullptr. */
+  Message* m_firstChanged;
+
+  /** the most recently changed @a Message, or nullptr. */
+  Message* m_lastChanged;
+
+  /**
+   * the ring of the last @a MESSAGE_JOURNAL_SIZE updated @a Message instances by sequence number modulo size
+   * (outdated when the sequence number of the @a Message differs, nullptr for removed ones).
+   */
+  vector<Message*> m_journal;
+
+  /** the sequence number of the last update in @a m_journal, 0 for none. */
+  uint64_t m_lastSequence;
+
+  /** the @a Message instances whose availability changed since the last @a takeAvailabilityChanged(). */
+  vector<Message*> m_availabilityChanged;
+
+  /** the @a Arena owning the definitions loaded via @a readFromStream() (released once all of them are freed). */
+  Arena* m_arena;
+
   /** the known @a Message instances by key. */
-  map<uint64_t, vector<Message*> > m_messagesByKey;
+  unordered_map<uint64_t, vector<Message*> > m_messagesByKey;
+
+  /**
+   * the decode index with the combinations of ID length and source kind present in @a m_messagesByKey by
+   * destination address, primary, and secondary command byte (may contain stale bits after removal).
+   */
+  unordered_map<uint32_t, uint32_t> m_decodeMasks;
+
+  /** whether to poll every @a Message by its period (instead of only those with "pollperiod" attribute). */
+  bool m_pollByPeriod;
+
+  /** the known @a Message instances to poll by period, by due time. */
+  PollScheduler m_pollMessages;
+
+  /** the @a Message instances of @a m_pollMessages polled before, by the time their data becomes stale. */
+  PollScheduler m_stalePollMessages;
+
+  /** the known @a Message instances to cycle through, by poll slot weighted with the poll priority. */
+  PollScheduler m_cyclePollMessages;
+
+  /** the order for the next @a Message added to @a m_pollMessages or @a m_cyclePollMessages. */
+  uint64_t m_nextPollOrder;
+
+  /** the poll slot of the @a Message last taken from @a m_cyclePollMessages. */
+  time_t m_lastCycleSlot;
+
+  /** the system time of the last poll taken from @a m_cyclePollMessages, or 0 for never. */
+  time_t m_lastCyclePoll;
 
-  /** the known @a Message instances to poll, by priority. */
-  MessagePriorityQueue m_pollMessages;
+  /** the number of polls postponed because of a fresh value seen passively. */
+  size_t m_suppressedPollCount;
 
   /** the @a Condition instances by filename and condition name. */
   map<string, Condition*> m_conditions;
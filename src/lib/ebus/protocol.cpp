@@ -25,6 +25,7 @@
 #include "lib/ebus/device_trans.h"
 #include "lib/ebus/protocol.h"
 #include "lib/ebus/protocol_direct.h"
+#include "lib/ebus/transport_sim.h"
 #include "lib/utils/log.h"
 
 namespace ebusd {
@@ -45,6 +46,17 @@ const char* getProtocolStateCode(ProtocolState state) {
   }
 }
 
+const char* getRequestClassCode(RequestClass requestClass) {
+  switch (requestClass) {
+    case rc_write:      return "write";
+    case rc_read:       return "read";
+    case rc_poll:       return "poll";
+    case rc_scan:       return "scan";
+    case rc_background: return "background";
+    default:            return "unknown";
+  }
+}
+
 bool ActiveBusRequest::notify(result_t result, const SlaveSymbolString& slave) {
   if (result == RESULT_OK) {
     string str = slave.getStr();
@@ -55,9 +67,177 @@ bool ActiveBusRequest::notify(result_t result, const SlaveSymbolString& slave) {
   return false;
 }
 
+void AirtimeCounter::add(unsigned int symbols, result_t result) {
+  m_symbols += symbols;
+  switch (result) {
+  case RESULT_OK:
+    m_telegrams++;
+    break;
+  case RESULT_ERR_CRC:
+    m_crcErrors++;
+    break;
+  case RESULT_ERR_NAK:
+    m_naks++;
+    break;
+  case RESULT_ERR_TIMEOUT:
+  case RESULT_ERR_SYN:
+    m_timeouts++;
+    break;
+  default:
+    m_errors++;
+    break;
+  }
+}
+
+void AirtimeCounter::reset() {
+  m_symbols = 0;
+  m_telegrams = m_crcErrors = m_naks = m_timeouts = m_errors = 0;
+}
+
+void AirtimeCounter::dump(uint64_t total, bool json, ostringstream* output) const {
+  uint64_t millis = m_symbols * AIRTIME_SYMBOL_MICROS / 1000;
+  unsigned int share = total == 0 ? 0 : static_cast<unsigned int>(m_symbols * 1000 / total);  // per mille
+  if (json) {
+    *output << "{\"symbols\":" << m_symbols << ",\"millis\":" << millis
+            << ",\"share\":" << (share / 10) << "." << (share % 10)
+            << ",\"telegrams\":" << m_telegrams << ",\"crc\":" << m_crcErrors << ",\"nak\":" << m_naks
+            << ",\"timeout\":" << m_timeouts << ",\"error\":" << m_errors << "}";
+    return;
+  }
+  *output << m_symbols << " symbols, " << millis << " ms, " << (share / 10) << "." << (share % 10) << "%, "
+          << m_telegrams << " telegrams, " << m_crcErrors << " CRC errors, " << m_naks << " NAKs, "
+          << m_timeouts << " timeouts, " << m_errors << " errors";
+}
+
+BusRequestQueue::BusRequestQueue(uint64_t (*getMicros)())
+  : m_getMicros(getMicros), m_next(nullptr) {
+  for (int cls = 0; cls < REQUEST_CLASS_COUNT; cls++) {
+    m_handled[cls] = 0;
+    m_waitTotal[cls] = 0;
+    m_waitMax[cls] = 0;
+  }
+}
+
+void BusRequestQueue::push(BusRequest* request) {
+  m_mutex.lock();
+  m_queues[request->getRequestClass()].push_back({request, m_getMicros()});
+  m_mutex.unlock();
+}
+
+BusRequest* BusRequestQueue::peek() {
+  m_mutex.lock();
+  BusRequest* request = selectNext();
+  m_mutex.unlock();
+  return request;
+}
+
+bool BusRequestQueue::remove(BusRequest* request) {
+  m_mutex.lock();
+  bool result = removeLocked(request);
+  m_mutex.unlock();
+  return result;
+}
+
+BusRequest* BusRequestQueue::pop() {
+  m_mutex.lock();
+  BusRequest* request = selectNext();
+  if (request) {
+    removeLocked(request);
+  }
+  m_mutex.unlock();
+  return request;
+}
+
+BusRequest* BusRequestQueue::selectNext() {
+  if (m_next) {
+    return m_next;
+  }
+  uint64_t now = m_getMicros();
+  int64_t bestRank = 0;
+  for (int cls = 0; cls < REQUEST_CLASS_COUNT; cls++) {
+    if (m_queues[cls].empty()) {
+      continue;
+    }
+    // the first one is the oldest in this class
+    const queued_request_t& first = m_queues[cls].front();
+    uint64_t waited = now > first.queued ? now - first.queued : 0;
+    int64_t rank = cls - static_cast<int64_t>(waited / 1000 / REQUEST_AGING_MILLIS);
+    if (!m_next || rank < bestRank) {
+      m_next = first.request;
+      bestRank = rank;
+    }
+  }
+  return m_next;
+}
+
+bool BusRequestQueue::removeLocked(BusRequest* request) {
+  list<queued_request_t>& queue = m_queues[request->getRequestClass()];
+  for (auto it = queue.begin(); it != queue.end(); it++) {
+    if (it->request != request) {
+      continue;
+    }
+    uint64_t now = m_getMicros();
+    uint64_t waited = now > it->queued ? now - it->queued : 0;
+    RequestClass cls = request->getRequestClass();
+    m_handled[cls]++;
+    m_waitTotal[cls] += waited;
+    if (waited > m_waitMax[cls]) {
+      m_waitMax[cls] = waited;
+    }
+    m_waits.add(waited);
+    queue.erase(it);
+    if (m_next == request) {
+      m_next = nullptr;
+    }
+    return true;
+  }
+  return false;
+}
+
+void BusRequestQueue::formatInfo(ostringstream* output) {
+  m_mutex.lock();
+  for (int cls = 0; cls < REQUEST_CLASS_COUNT; cls++) {
+    *output << "queue " << getRequestClassCode(static_cast<RequestClass>(cls)) << ": "
+            << m_queues[cls].size() << " pending, " << m_handled[cls] << " handled";
+    if (m_handled[cls] > 0) {
+      *output << ", wait avg " << (m_waitTotal[cls] / m_handled[cls] / 1000) << " ms, max "
+              << (m_waitMax[cls] / 1000) << " ms";
+    }
+    *output << "\n";
+  }
+  m_mutex.unlock();
+}
+
 ProtocolHandler* ProtocolHandler::create(const ebus_protocol_config_t config,
   ProtocolListener* listener) {
   const char* name = config.device;
+  if (strncmp(name, "replay", 6) == 0 && (name[6] == ':' || name[6] == '@')) {
+    // support replay:<path> and replay@<speed>:<path>
+    double speed = 1;
+    const char* pathpos = strchr(name, ':');
+    if (pathpos == nullptr || !pathpos[1]) {
+      return nullptr;
+    }
+    if (name[6] == '@') {
+      char* strEnd = nullptr;
+      speed = strtod(name + 7, &strEnd);
+      if (strEnd != pathpos || speed < 0) {
+        return nullptr;  // invalid speed
+      }
+    }
+    ebus_protocol_config_t replayConfig = config;
+    replayConfig.readOnly = true;
+    Transport* transport = new ReplayTransport(name, strdup(pathpos + 1), speed);
+    return new DirectProtocolHandler(replayConfig, new PlainDevice(transport), listener);
+  }
+  if (strncmp(name, "sim:", 4) == 0) {
+    // support sim:<path>
+    if (!name[4]) {
+      return nullptr;
+    }
+    Transport* transport = new SimulatorTransport(name, strdup(name + 4));
+    return new DirectProtocolHandler(config, new PlainDevice(transport), listener);
+  }
   bool enhanced = false;
   uint8_t speed = 0;
   if (name[0] == 'e' && name[1] && name[2] && name[3] == ':') {
@@ -202,20 +382,81 @@ result_t ProtocolHandler::addRequest(BusRequest* request, bool wait) {
   if (m_config.readOnly) {
     return RESULT_ERR_DEVICE;
   }
-  m_nextRequests.push(request);
-  if (!wait || m_finishedRequests.remove(request, true)) {
+  if (wait) {
+    request->m_completion.reset();
+  }
+  queueRequest(request);
+  if (!wait || request->m_completion.wait()) {
     return RESULT_OK;
   }
   return RESULT_ERR_TIMEOUT;
 }
 
-result_t ProtocolHandler::sendAndWait(const MasterSymbolString& master, SlaveSymbolString* slave) {
+void ProtocolHandler::queueRequest(BusRequest* request) {
+  const MasterSymbolString& master = request->getMaster();
+  if (request->isCoalescable() && master.size() > 1 && master[1] != BROADCAST && !isMaster(master[1])) {
+    m_coalesceMutex.lock();
+    for (const auto pending : m_coalescableRequests) {
+      if (pending->getMaster().compareTo(master) == 0) {
+        // share the transfer with the pending one
+        pending->m_coalesced.push_back(request);
+        m_coalescedCount++;
+        m_coalesceMutex.unlock();
+        logDebug(lf_bus, "coalesced request: %s", master.getStr().c_str());
+        return;
+      }
+    }
+    m_coalescableRequests.push_back(request);
+    m_coalesceMutex.unlock();
+  }
+  m_nextRequests.push(request);
+}
+
+void ProtocolHandler::notifyRequest(BusRequest* request, result_t result, const SlaveSymbolString& slave) {
+  list<BusRequest*> requests;
+  if (request->isCoalescable()) {
+    m_coalesceMutex.lock();
+    m_coalescableRequests.remove(request);
+    requests.swap(request->m_coalesced);
+    m_coalesceMutex.unlock();
+  }
+  requests.push_front(request);
+  for (const auto req : requests) {
+    if (req->notify(result, slave)) {
+      req->resetBusLostRetries();
+      queueRequest(req);
+    } else if (req->deleteOnFinish()) {
+      delete req;
+    } else {
+      req->m_completion.complete();
+    }
+  }
+}
+
+void ProtocolHandler::discardRequest(BusRequest* request) {
+  list<BusRequest*> requests;
+  if (request->isCoalescable()) {
+    m_coalesceMutex.lock();
+    m_coalescableRequests.remove(request);
+    requests.swap(request->m_coalesced);
+    m_coalesceMutex.unlock();
+  }
+  requests.push_front(request);
+  for (const auto req : requests) {
+    if (req->deleteOnFinish()) {
+      delete req;
+    }
+  }
+}
+
+result_t ProtocolHandler::sendAndWait(const MasterSymbolString& master, SlaveSymbolString* slave,
+    RequestClass requestClass) {
   if (!hasSignal()) {
     return RESULT_ERR_NO_SIGNAL;  // don't wait when there is no signal
   }
   result_t result = RESULT_ERR_NO_SIGNAL;
   slave->clear();
-  ActiveBusRequest request(master, slave);
+  ActiveBusRequest request(master, slave, requestClass);
   logInfo(lf_bus, "send message: %s", master.getStr().c_str());
 
   for (int sendRetries = m_config.failedSendRetries + 1; sendRetries > 0; sendRetries--) {
@@ -237,13 +478,31 @@ result_t ProtocolHandler::sendAndWait(const MasterSymbolString& master, SlaveSym
   return result;
 }
 
+void ProtocolHandler::formatLatencyInfo(ostringstream* output, bool json, bool reset) {
+  Histogram* histograms[] = {&m_symbolLatencies, &m_arbitrationDelays, m_nextRequests.getWaitHistogram(),
+    &m_transferTimes};
+  const char* names[] = {"symbol", "arbitration", "queue", "transfer"};
+  for (size_t idx = 0; idx < sizeof(names)/sizeof(names[0]); idx++) {
+    if (json) {
+      *output << (idx == 0 ? "" : ",") << "\"" << names[idx] << "\":";
+    } else {
+      *output << names[idx] << " latency micros: ";
+    }
+    histograms[idx]->format(output, json, reset);
+    if (!json) {
+      *output << "\n";
+    }
+  }
+}
+
 void ProtocolHandler::measureLatency(struct timespec* sentTime, struct timespec* recvTime) {
-  int64_t latencyLong = (recvTime->tv_sec*1000000000 + recvTime->tv_nsec
-      - sentTime->tv_sec*1000000000 - sentTime->tv_nsec)/1000000;
-  if (latencyLong < 0 || latencyLong > 1000) {
+  int64_t latencyMicros = (recvTime->tv_sec*1000000000 + recvTime->tv_nsec
+      - sentTime->tv_sec*1000000000 - sentTime->tv_nsec)/1000;
+  if (latencyMicros < 0 || latencyMicros > 1000000) {
     return;  // clock skew or out of reasonable range
   }
-  auto latency = static_cast<int>(latencyLong);
+  m_symbolLatencies.add(static_cast<uint64_t>(latencyMicros));
+  auto latency = static_cast<int>(latencyMicros/1000);
   logDebug(lf_bus, "send/receive symbol latency %d ms", latency);
   if (m_symbolLatencyMin >= 0 && (latency >= m_symbolLatencyMin && latency <= m_symbolLatencyMax)) {
     return;
@@ -19,15 +19,19 @@
 #ifndef LIB_EBUS_PROTOCOL_H_
 #define LIB_EBUS_PROTOCOL_H_
 
+#include <list>
 #include "lib/ebus/symbol.h"
 #include "lib/ebus/result.h"
 #include "lib/ebus/device.h"
-#include "lib/utils/queue.h"
+#include "lib/utils/clock.h"
+#include "lib/utils/histogram.h"
 #include "lib/utils/rotatefile.h"
 #include "lib/utils/thread.h"
 
 namespace ebusd {
 
+using std::list;
+
 /** @file lib/ebus/protocol.h
  * Classes, functions, and constants related to handling the eBUS protocol.
  */
@@ -102,6 +106,28 @@ enum ProtocolState {
  */
 const char* getProtocolStateCode(ProtocolState state);
 
+/** the scheduling classes of a @a BusRequest in the order of descending priority. */
+enum RequestClass {
+  rc_write,       //!< interactive write (or any other request potentially modifying something)
+  rc_read,        //!< interactive read
+  rc_poll,        //!< regular poll
+  rc_scan,        //!< scan
+  rc_background,  //!< background (e.g. initial instructions)
+};
+
+/** the number of @a RequestClass values. */
+#define REQUEST_CLASS_COUNT 5
+
+/** the time [ms] a queued @a BusRequest has to wait for being preferred like one of the next higher class. */
+#define REQUEST_AGING_MILLIS 2000
+
+/**
+ * Return the string corresponding to the @a RequestClass.
+ * @param requestClass the @a RequestClass.
+ * @return the string corresponding to the @a RequestClass.
+ */
+const char* getRequestClassCode(RequestClass requestClass);
+
 class ProtocolHandler;
 
 /**
@@ -115,10 +141,11 @@ class BusRequest {
    * Constructor.
    * @param master the master data @a MasterSymbolString to send.
    * @param deleteOnFinish whether to automatically delete this @a BusRequest when finished.
+   * @param requestClass the @a RequestClass for scheduling.
    */
-  BusRequest(const MasterSymbolString& master, bool deleteOnFinish)
+  BusRequest(const MasterSymbolString& master, bool deleteOnFinish, RequestClass requestClass = rc_write)
     : m_master(master), m_busLostRetries(0),
-      m_deleteOnFinish(deleteOnFinish) {}
+      m_deleteOnFinish(deleteOnFinish), m_requestClass(requestClass) {}
 
   /**
    * Destructor.
@@ -150,6 +177,17 @@ class BusRequest {
    */
   bool deleteOnFinish() const { return m_deleteOnFinish; }
 
+  /**
+   * @return the @a RequestClass for scheduling.
+   */
+  RequestClass getRequestClass() const { return m_requestClass; }
+
+  /**
+   * @return whether this @a BusRequest may share the transfer with another pending one having the same master data
+   * (i.e. it does not modify anything on the bus).
+   */
+  bool isCoalescable() const { return m_requestClass == rc_read || m_requestClass == rc_poll; }
+
   /**
    * Notify the request of the specified result.
    * @param result the result of the request.
@@ -168,6 +206,15 @@ class BusRequest {
 
   /** whether to automatically delete this @a BusRequest when finished. */
   const bool m_deleteOnFinish;
+
+  /** the @a RequestClass for scheduling. */
+  const RequestClass m_requestClass;
+
+  /** the @a BusRequest instances with the same master data waiting for the result of this one. */
+  list<BusRequest*> m_coalesced;
+
+  /** the @a Completion signalled when a request not deleted on finish is finished. */
+  Completion m_completion;
 };
 
 
@@ -182,9 +229,10 @@ class ActiveBusRequest : public BusRequest {
    * Constructor.
    * @param master the master data @a MasterSymbolString to send.
    * @param slave reference to @a SlaveSymbolString for filling in the received slave data.
+   * @param requestClass the @a RequestClass for scheduling.
    */
-  ActiveBusRequest(const MasterSymbolString& master, SlaveSymbolString* slave)
-    : BusRequest(master, false), m_result(RESULT_ERR_NO_SIGNAL), m_slave(slave) {}
+  ActiveBusRequest(const MasterSymbolString& master, SlaveSymbolString* slave, RequestClass requestClass = rc_write)
+    : BusRequest(master, false, requestClass), m_result(RESULT_ERR_NO_SIGNAL), m_slave(slave) {}
 
   /**
    * Destructor.
@@ -204,6 +252,73 @@ class ActiveBusRequest : public BusRequest {
 };
 
 
+/** the bus airtime of a single symbol in microseconds (10 bits at 2400 Baud). */
+#define AIRTIME_SYMBOL_MICROS (10*1000000/2400)
+
+/**
+ * The bus airtime and transfer results accounted to an address or message.
+ */
+class AirtimeCounter {
+ public:
+  /**
+   * Construct a new instance.
+   */
+  AirtimeCounter() { reset(); }
+
+  /**
+   * Add a transfer.
+   * @param symbols the number of symbols seen on the bus.
+   * @param result the result of the transfer.
+   */
+  void add(unsigned int symbols, result_t result);
+
+  /**
+   * Reset all counters.
+   */
+  void reset();
+
+  /**
+   * Get the number of symbols seen on the bus.
+   * @return the number of symbols seen on the bus.
+   */
+  uint64_t getSymbols() const { return m_symbols; }
+
+  /**
+   * Return whether anything was counted.
+   * @return whether anything was counted.
+   */
+  bool isEmpty() const { return m_symbols == 0 && m_telegrams == 0 && m_errors == 0; }
+
+  /**
+   * Dump the counters to the output.
+   * @param total the total number of symbols for calculating the share.
+   * @param json true for a JSON object, false for text.
+   * @param output the @a ostringstream to append the counters to.
+   */
+  void dump(uint64_t total, bool json, ostringstream* output) const;
+
+
+ private:
+  /** the number of symbols seen on the bus. */
+  uint64_t m_symbols;
+
+  /** the number of successfully completed telegrams. */
+  unsigned int m_telegrams;
+
+  /** the number of CRC errors. */
+  unsigned int m_crcErrors;
+
+  /** the number of NAKs. */
+  unsigned int m_naks;
+
+  /** the number of timeouts (including unexpected SYN). */
+  unsigned int m_timeouts;
+
+  /** the number of other errors. */
+  unsigned int m_errors;
+};
+
+
 /** the possible message directions. */
 enum MessageDirection {
   md_recv,    //!< message received from bus
@@ -243,10 +358,133 @@ class ProtocolListener {
    */
   virtual void notifyProtocolMessage(MessageDirection direction, const MasterSymbolString& master,
     const SlaveSymbolString& slave) = 0;  // abstract
+
+  /**
+   * Listener method that is called when a transfer on the bus was completed or failed for accounting the airtime.
+   * For a completed telegram, this is called right after @a notifyProtocolMessage().
+   * @param master the (potentially partial) @a MasterSymbolString of the transfer.
+   * @param symbols the number of symbols seen on the bus since the previous call (excluding SYN).
+   * @param result the result of the transfer, @a RESULT_OK on success or the error code (a transfer repeated after
+   * an error is notified once more).
+   */
+  virtual void notifyProtocolTransfer(const MasterSymbolString& master, unsigned int symbols,
+    result_t result) = 0;  // abstract
 };
 
 
 
+/**
+ * Thread safe queue of @a BusRequest instances ordered by @a RequestClass. A request waiting for a long time is
+ * preferred over newer ones of higher classes (aging), so that no class starves.
+ */
+class BusRequestQueue {
+ public:
+  /**
+   * Constructor.
+   * @param getMicros the function returning the current time in microseconds (replaceable for testing).
+   */
+  explicit BusRequestQueue(uint64_t (*getMicros)() = clockGetMicros);
+
+  /**
+   * Destructor.
+   */
+  ~BusRequestQueue() {}
+
+
+ private:
+  /**
+   * Hidden copy constructor.
+   * @param src the object to copy from.
+   */
+  BusRequestQueue(const BusRequestQueue& src);
+
+
+ public:
+  /**
+   * Add a @a BusRequest to the end of the queue of its class.
+   * @param request the @a BusRequest to add.
+   */
+  void push(BusRequest* request);
+
+  /**
+   * Return the next @a BusRequest to handle without removing it. The returned request stays the next one until it
+   * was removed.
+   * @return the next @a BusRequest to handle, or nullptr if the queue is empty.
+   */
+  BusRequest* peek();
+
+  /**
+   * Remove the specified @a BusRequest from the queue.
+   * @param request the @a BusRequest to remove.
+   * @return whether the request was removed.
+   */
+  bool remove(BusRequest* request);
+
+  /**
+   * Remove the next @a BusRequest to handle from the queue.
+   * @return the @a BusRequest, or nullptr if the queue is empty.
+   */
+  BusRequest* pop();
+
+  /**
+   * Format the queue depth and wait time of each @a RequestClass.
+   * @param output the @a ostringstream to append the infos to.
+   */
+  void formatInfo(ostringstream* output);
+
+  /**
+   * Get the @a Histogram of the time the removed requests were waiting in the queue.
+   * @return the @a Histogram of the wait time in microseconds.
+   */
+  Histogram* getWaitHistogram() { return &m_waits; }
+
+
+ private:
+  /** a queued @a BusRequest with the time it was added. */
+  typedef struct {
+    BusRequest* request;  //!< the @a BusRequest
+    uint64_t queued;      //!< the time [us] the request was added
+  } queued_request_t;
+
+  /**
+   * Determine the next @a BusRequest to handle (with @a m_mutex being locked).
+   * @return the next @a BusRequest to handle, or nullptr if the queue is empty.
+   */
+  BusRequest* selectNext();
+
+  /**
+   * Remove the @a BusRequest from the queue of the class and update the statistics (with @a m_mutex being locked).
+   * @param request the @a BusRequest to remove.
+   * @return whether the request was removed.
+   */
+  bool removeLocked(BusRequest* request);
+
+  /** the function returning the current time in microseconds. */
+  uint64_t (*const m_getMicros)();
+
+  /** the @a Mutex for all members. */
+  Mutex m_mutex;
+
+  /** the queued @a BusRequest instances by @a RequestClass. */
+  list<queued_request_t> m_queues[REQUEST_CLASS_COUNT];
+
+  /** the @a BusRequest determined to be handled next, or nullptr. */
+  BusRequest* m_next;
+
+  /** the number of requests removed from the queue by @a RequestClass. */
+  unsigned int m_handled[REQUEST_CLASS_COUNT];
+
+  /** the total time [us] the removed requests were waiting in the queue by @a RequestClass. */
+  uint64_t m_waitTotal[REQUEST_CLASS_COUNT];
+
+  /** the maximum time [us] a removed request was waiting in the queue by @a RequestClass. */
+  uint64_t m_waitMax[REQUEST_CLASS_COUNT];
+
+  /** the @a Histogram of the time [us] the removed requests were waiting in the queue. */
+  Histogram m_waits;
+};
+
+
 /**
  * Handles input from and output to eBUS with respect to the eBUS protocol.
  */
@@ -267,7 +505,7 @@ class ProtocolHandler : public WaitThread, public DeviceListener {
       m_masterCount(config.readOnly ? 0 : 1),
       m_symbolLatencyMin(-1), m_symbolLatencyMax(-1), m_arbitrationDelayMin(-1),
       m_arbitrationDelayMax(-1), m_lastReceive(0),
-      m_symPerSec(0), m_maxSymPerSec(0),
+      m_coalescedCount(0), m_symPerSec(0), m_maxSymPerSec(0),
       m_logRawFile(nullptr), m_logRawEnabled(false), m_logRawBytes(false),
       m_logRawLastSymbol(SYN), m_dumpFile(nullptr) {
     memset(m_seenAddresses, 0, sizeof(m_seenAddresses));
@@ -282,13 +520,8 @@ class ProtocolHandler : public WaitThread, public DeviceListener {
   virtual ~ProtocolHandler() {
     join();
     BusRequest* req;
-    while ((req = m_finishedRequests.pop()) != nullptr) {
-      delete req;
-    }
     while ((req = m_nextRequests.pop()) != nullptr) {
-      if (req->m_deleteOnFinish) {
-        delete req;
-      }
+      discardRequest(req);
     }
     if (m_dumpFile) {
       delete m_dumpFile;
@@ -337,6 +570,11 @@ class ProtocolHandler : public WaitThread, public DeviceListener {
    */
   bool isReadOnly() const { return m_config.readOnly; }
 
+  /**
+   * @return the number of times a failed send is repeated (other than lost arbitration).
+   */
+  unsigned int getFailedSendRetries() const { return m_config.failedSendRetries; }
+
   /**
    * @return the own master address.
    */
@@ -428,9 +666,12 @@ class ProtocolHandler : public WaitThread, public DeviceListener {
    * Send a message on the bus and wait for the answer.
    * @param master the @a MasterSymbolString with the master data to send.
    * @param slave the @a SlaveSymbolString that will be filled with retrieved slave data.
+   * @param requestClass the @a RequestClass for scheduling (reading classes share the transfer with another pending
+   * request having the same master data).
    * @return the result code.
    */
-  virtual result_t sendAndWait(const MasterSymbolString& master, SlaveSymbolString* slave);
+  virtual result_t sendAndWait(const MasterSymbolString& master, SlaveSymbolString* slave,
+      RequestClass requestClass = rc_write);
 
   /**
    * Main thread entry.
@@ -522,7 +763,49 @@ class ProtocolHandler : public WaitThread, public DeviceListener {
    */
   bool toggleLogRaw(bool bytes);
 
+  /**
+   * Format the queue depth and wait time of each @a RequestClass.
+   * @param output the @a ostringstream to append the infos to.
+   */
+  void formatQueueInfo(ostringstream* output) { m_nextRequests.formatInfo(output); }
+
+  /**
+   * Format the latency histograms of symbols, arbitration, queue wait, and transfer.
+   * @param output the @a ostringstream to append the infos to.
+   * @param json true for JSON object members, false for text lines.
+   * @param reset whether to reset the histograms afterwards.
+   */
+  void formatLatencyInfo(ostringstream* output, bool json, bool reset);
+
+  /**
+   * Return the number of requests that shared the transfer with another pending request.
+   * @return the number of requests that shared the transfer with another pending request.
+   */
+  unsigned int getCoalescedCount() const { return m_coalescedCount; }
+
  protected:
+  /**
+   * Put the @a BusRequest into the queue of pending requests, or attach it to a pending one with the same master
+   * data if both are coalescable.
+   * @param request the @a BusRequest to queue.
+   */
+  void queueRequest(BusRequest* request);
+
+  /**
+   * Notify the @a BusRequest and all the ones attached to it of the result and requeue, delete, or move them to
+   * the finished requests.
+   * @param request the @a BusRequest that was handled (no longer in the queue of pending requests).
+   * @param result the result of the request.
+   * @param slave the @a SlaveSymbolString received.
+   */
+  void notifyRequest(BusRequest* request, result_t result, const SlaveSymbolString& slave);
+
+  /**
+   * Discard the @a BusRequest and all the ones attached to it without notification (used during shutdown).
+   * @param request the @a BusRequest to discard (no longer in the queue of pending requests).
+   */
+  void discardRequest(BusRequest* request);
+
   /**
    * Called to measure the latency between send and receive of a symbol.
    * @param sentTime the time the symbol was sent.
@@ -582,14 +865,29 @@ class ProtocolHandler : public WaitThread, public DeviceListener {
    */
   int m_arbitrationDelayMax;
 
+  /** the @a Histogram of the latency [us] between send and receive of a symbol. */
+  Histogram m_symbolLatencies;
+
+  /** the @a Histogram of the delay [us] between received SYN and sent own master address. */
+  Histogram m_arbitrationDelays;
+
+  /** the @a Histogram of the time [us] from won arbitration to successful completion of a @a BusRequest. */
+  Histogram m_transferTimes;
+
   /** the time of the last received symbol, or 0 for never. */
   time_t m_lastReceive;
 
   /** the queue of @a BusRequests that shall be handled. */
-  Queue<BusRequest*> m_nextRequests;
+  BusRequestQueue m_nextRequests;
+
+  /** the @a Mutex for @a m_coalescableRequests. */
+  Mutex m_coalesceMutex;
+
+  /** the coalescable @a BusRequests that are queued or currently being sent. */
+  list<BusRequest*> m_coalescableRequests;
 
-  /** the queue of @a BusRequests that are already finished. */
-  Queue<BusRequest*> m_finishedRequests;
+  /** the number of requests that shared the transfer with another pending request. */
+  unsigned int m_coalescedCount;
 
   /** the number of received symbols in the last second. */
   unsigned int m_symPerSec;
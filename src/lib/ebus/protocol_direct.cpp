@@ -91,12 +91,16 @@ void DirectProtocolHandler::run() {
       result_t result = handleSend(&recvTimeout, &sentSymbol, &sentTime);
       bool sent = result == RESULT_CONTINUE;
       do {
-        if (result >= RESULT_OK) {
+        unsigned int count = 1;
+        if (result == RESULT_CONTINUE && !sent) {
+          // further symbols are already buffered: handle them at once
+          result = handleReceiveBuffered(&sentTime, &count);
+        } else if (result >= RESULT_OK) {
           result = handleReceive(recvTimeout, sent, sentSymbol, &sentTime);
         }
         time(&now);
         if (result != RESULT_ERR_TIMEOUT && now >= lastTime) {
-          symCount++;
+          symCount += count;
         }
         if (now > lastTime) {
           m_symPerSec = symCount / (unsigned int)(now-lastTime);
@@ -355,6 +359,7 @@ struct timespec* sentTime) {
         } else {
           logDebug(lf_bus, "arbitration won");
           m_currentRequest = startRequest;
+          m_transferStart = clockGetMicros();
           sentSymbol = m_currentRequest->getMaster()[0];
           sending = true;
         }
@@ -393,6 +398,33 @@ struct timespec* sentTime) {
   }
 
   m_lastReceive = now;
+  return handleSymbol(recvSymbol, result, sending, sentSymbol, sentTime, &recvTime);
+}
+
+result_t DirectProtocolHandler::handleReceiveBuffered(struct timespec* sentTime, unsigned int* count) {
+  const symbol_t* data = nullptr;
+  size_t len = 0;
+  if (!m_device->peekBuffered(&data, &len) || len == 0) {
+    *count = 1;
+    return handleReceive(0, false, ESC, sentTime);
+  }
+  time(&m_lastReceive);
+  result_t result = RESULT_CONTINUE;
+  size_t pos = 0;
+  while (pos < len && result == RESULT_CONTINUE) {
+    symbol_t recvSymbol = data[pos++];
+    result = handleSymbol(recvSymbol, pos < len ? RESULT_CONTINUE : RESULT_OK, false, ESC, sentTime, nullptr);
+  }
+  m_device->consumeBuffered(pos);
+  *count = static_cast<unsigned int>(pos);
+  return result;
+}
+
+result_t DirectProtocolHandler::handleSymbol(symbol_t recvSymbol, result_t result, bool sending,
+symbol_t sentSymbol, struct timespec* sentTime, struct timespec* recvTime) {
+  if (recvSymbol != SYN && m_state != bs_skip && m_state != bs_noSignal) {
+    m_transferSymbols++;
+  }
   if ((recvSymbol == SYN) && (m_state != bs_sendSyn)) {
     if (result == RESULT_CONTINUE) {
       if (m_remainLockCount == 0) {
@@ -413,7 +445,7 @@ struct timespec* sentTime) {
     if (recvSymbol != sentSymbol) {
       return setState(bs_skip, RESULT_ERR_SYMBOL);
     }
-    measureLatency(sentTime, &recvTime);
+    measureLatency(sentTime, recvTime);
   }
 
   switch (m_state) {
@@ -462,6 +494,7 @@ struct timespec* sentTime) {
         int64_t latencyLong = (sentTime->tv_sec*1000000000LL + sentTime->tv_nsec
         - m_lastSynReceiveTime.tv_sec*1000000000LL - m_lastSynReceiveTime.tv_nsec)/1000;
         if (latencyLong >= 0 && latencyLong <= 10000) {  // skip clock skew or out of reasonable range
+          m_arbitrationDelays.add(static_cast<uint64_t>(latencyLong));
           auto latency = static_cast<int>(latencyLong);
           logDebug(lf_bus, "arbitration delay %d micros", latency);
           if (m_arbitrationDelayMin < 0 || (latency < m_arbitrationDelayMin || latency > m_arbitrationDelayMax)) {
@@ -542,6 +575,7 @@ struct timespec* sentTime) {
     if (recvSymbol == NAK) {
       if (!m_repeat) {
         m_repeat = true;
+        notifyTransfer(RESULT_ERR_NAK);
         m_crc = 0;
         m_nextSendPos = 0;
         m_command.clear();
@@ -642,6 +676,7 @@ struct timespec* sentTime) {
     if (!m_crcValid) {
       if (!m_repeat) {
         m_repeat = true;
+        notifyTransfer(RESULT_ERR_NAK);
         m_crc = 0;
         m_command.clear();
         return setState(bs_recvCmd, RESULT_ERR_NAK, true);
@@ -685,6 +720,9 @@ struct timespec* sentTime) {
 }
 
 result_t DirectProtocolHandler::setState(BusState state, result_t result, bool firstRepetition) {
+  if (result < RESULT_OK && result != RESULT_ERR_BUS_LOST) {
+    notifyTransfer(result);
+  }
   if (m_currentRequest != nullptr) {
     if (result == RESULT_ERR_BUS_LOST && m_currentRequest->getBusLostRetries() < m_config.busLostRetries) {
       logDebug(lf_bus, "%s during %s, retry", getResultCode(result), getStateCode(m_state));
@@ -693,18 +731,14 @@ result_t DirectProtocolHandler::setState(BusState state, result_t result, bool f
       m_currentRequest = nullptr;
     } else if (state == bs_sendSyn || (result < RESULT_OK && !firstRepetition)) {
       logDebug(lf_bus, "notify request: %s", getResultCode(result));
-      bool restart = m_currentRequest->notify(
-        result == RESULT_ERR_SYN && (m_state == bs_recvCmdAck || m_state == bs_recvRes)
-        ? RESULT_ERR_TIMEOUT : result, m_response);
-      if (restart) {
-        m_currentRequest->resetBusLostRetries();
-        m_nextRequests.push(m_currentRequest);
-      } else if (m_currentRequest->deleteOnFinish()) {
-        delete m_currentRequest;
-      } else {
-        m_finishedRequests.push(m_currentRequest);
+      if (result == RESULT_OK && m_transferStart > 0) {
+        m_transferTimes.add(clockGetMicros() - m_transferStart);
       }
+      m_transferStart = 0;
+      BusRequest* request = m_currentRequest;
       m_currentRequest = nullptr;
+      notifyRequest(request, result == RESULT_ERR_SYN && (m_state == bs_recvCmdAck || m_state == bs_recvRes)
+        ? RESULT_ERR_TIMEOUT : result, m_response);
     }
     if (state == bs_skip) {
       m_device->startArbitration(SYN);  // reset arbitration state
@@ -713,13 +747,9 @@ result_t DirectProtocolHandler::setState(BusState state, result_t result, bool f
 
   if (state == bs_noSignal) {  // notify all requests
     m_response.clear();  // notify with empty response
-    while ((m_currentRequest = m_nextRequests.pop()) != nullptr) {
-      m_currentRequest->notify(RESULT_ERR_NO_SIGNAL, m_response);
-      if (m_currentRequest->deleteOnFinish()) {
-        delete m_currentRequest;
-      } else {
-        m_finishedRequests.push(m_currentRequest);
-      }
+    BusRequest* request;
+    while ((request = m_nextRequests.pop()) != nullptr) {
+      notifyRequest(request, RESULT_ERR_NO_SIGNAL, m_response);
     }
   }
 
@@ -789,6 +819,7 @@ void DirectProtocolHandler::messageCompleted() {
   const SlaveSymbolString response(m_response);
   symbol_t srcAddress = command[0], dstAddress = command[1];
   if (srcAddress == dstAddress) {
+    notifyTransfer(RESULT_OK);
     logError(lf_bus, "invalid self-addressed message from %2.2x", srcAddress);
     return;
   }
@@ -806,6 +837,16 @@ void DirectProtocolHandler::messageCompleted() {
     logInfo(lf_update, "%s MS cmd: %s / %s", prefix, command.getStr().c_str(), response.getStr().c_str());
   }
   m_listener->notifyProtocolMessage(direction, command, response);
+  notifyTransfer(RESULT_OK);  // after the message notification so that the listener can reuse the resolved message
+}
+
+void DirectProtocolHandler::notifyTransfer(result_t result) {
+  if (m_transferSymbols == 0) {
+    return;
+  }
+  m_listener->notifyProtocolTransfer(m_currentRequest ? m_currentRequest->getMaster() : m_command,
+    m_transferSymbols, result);
+  m_transferSymbols = 0;
 }
 
 uint64_t DirectProtocolHandler::createAnswerKey(symbol_t srcAddress, symbol_t dstAddress, symbol_t pb, symbol_t sb,
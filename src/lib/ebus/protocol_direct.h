@@ -71,7 +71,8 @@ class DirectProtocolHandler : public ProtocolHandler {
       m_lockCount(config.lockCount <= 3 ? 3 : config.lockCount),
       m_remainLockCount(config.lockCount == 0 ? 1 : 0),
       m_generateSynInterval(config.generateSyn ? 10*getMasterNumber(config.ownAddress)+SYN_TIMEOUT : 0),
-      m_currentRequest(nullptr), m_currentAnswering(false), m_nextSendPos(0),
+      m_currentRequest(nullptr), m_transferStart(0), m_transferSymbols(0),
+      m_currentAnswering(false), m_nextSendPos(0),
       m_state(bs_noSignal), m_escape(0), m_crc(0), m_crcValid(false), m_repeat(false) {
     m_lastSynReceiveTime.tv_sec = 0;
     m_lastSynReceiveTime.tv_nsec = 0;
@@ -83,7 +84,7 @@ class DirectProtocolHandler : public ProtocolHandler {
   virtual ~DirectProtocolHandler() {
     join();
     if (m_currentRequest != nullptr) {
-      delete m_currentRequest;
+      discardRequest(m_currentRequest);
       m_currentRequest = nullptr;
     }
   }
@@ -139,6 +140,28 @@ class DirectProtocolHandler : public ProtocolHandler {
    */
   result_t handleReceive(unsigned int timeout, bool sending, symbol_t sentSymbol, struct timespec* sentTime);
 
+  /**
+   * Handle all symbols already buffered by the @a Device at once without waiting, or the next single symbol if the
+   * @a Device does not offer buffered symbols.
+   * @param sentTime pointer to a variable with the system time when the last symbol was sent.
+   * @param count pointer to a variable in which to put the number of handled symbols.
+   * @return the result code, especially @a RESULT_CONTINUE if further symbols are buffered.
+   */
+  result_t handleReceiveBuffered(struct timespec* sentTime, unsigned int* count);
+
+  /**
+   * Feed a single received symbol through the protocol state machine.
+   * @param recvSymbol the received symbol.
+   * @param result the receive result, especially @a RESULT_CONTINUE if further symbols are buffered.
+   * @param sending whether a symbol was sent before entry.
+   * @param sentSymbol the sent symbol to verify (if sending).
+   * @param sentTime pointer to a variable with the system time when the symbol was sent.
+   * @param recvTime pointer to a variable with the system time when the symbol was received (if sending).
+   * @return the passed result on success, or an error code.
+   */
+  result_t handleSymbol(symbol_t recvSymbol, result_t result, bool sending, symbol_t sentSymbol,
+      struct timespec* sentTime, struct timespec* recvTime);
+
   /**
    * Set a new @a BusState and add a log message if necessary.
    * @param state the new @a BusState.
@@ -156,6 +179,12 @@ class DirectProtocolHandler : public ProtocolHandler {
    */
   void messageCompleted();
 
+  /**
+   * Notify the symbols seen on the bus since the last notification for the current transfer.
+   * @param result the result of the transfer.
+   */
+  void notifyTransfer(result_t result);
+
   /**
    * Create a key for storing an answer.
    * @param srcAddress the source address, or @a SYN for any.
@@ -190,6 +219,12 @@ class DirectProtocolHandler : public ProtocolHandler {
   /** the currently handled BusRequest, or nullptr. */
   BusRequest* m_currentRequest;
 
+  /** the time [us] the arbitration for @a m_currentRequest was won, or 0. */
+  uint64_t m_transferStart;
+
+  /** the number of symbols (excluding SYN) seen on the bus for the current transfer and not yet notified. */
+  unsigned int m_transferSymbols;
+
   /** the answers to give by key. */
   std::map<uint64_t, SlaveSymbolString > m_answerByKey;
 
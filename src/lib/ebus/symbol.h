@@ -24,6 +24,7 @@
 #include <sstream>
 #include <queue>
 #include <string>
+#include <utility>
 #include <vector>
 #include "lib/ebus/result.h"
 
@@ -116,6 +117,197 @@ unsigned int parseInt(const char* str, int base, unsigned int minValue, unsigned
 int parseSignedInt(const char* str, int base, int minValue, int maxValue,
     result_t* result, size_t* length = nullptr, bool allowIncomplete = false);
 
+/** the number of symbols a @a SymbolBuffer holds without allocating (covers a complete telegram part). */
+#define SYMBOL_INLINE_SIZE 32
+
+/**
+ * A sequence of symbols with inline storage for up to @a SYMBOL_INLINE_SIZE symbols that only falls back to the heap
+ * for longer sequences.
+ */
+class SymbolBuffer {
+ public:
+  /**
+   * Creates a new empty instance.
+   */
+  SymbolBuffer() : m_data(m_inline), m_size(0), m_capacity(SYMBOL_INLINE_SIZE) {}
+
+  /**
+   * Copy constructor.
+   * @param other the @a SymbolBuffer to copy from.
+   */
+  SymbolBuffer(const SymbolBuffer& other) : SymbolBuffer() { assign(other.m_data, other.m_size); }
+
+  /**
+   * Move constructor.
+   * @param other the @a SymbolBuffer to move from (empty afterwards).
+   */
+  SymbolBuffer(SymbolBuffer&& other) : SymbolBuffer() { moveFrom(&other); }
+
+  /**
+   * Destructor.
+   */
+  ~SymbolBuffer() {
+    if (m_data != m_inline) {
+      delete[] m_data;
+    }
+  }
+
+  /**
+   * Copy assignment.
+   * @param other the @a SymbolBuffer to copy from.
+   * @return this instance.
+   */
+  SymbolBuffer& operator=(const SymbolBuffer& other) {
+    if (this != &other) {
+      assign(other.m_data, other.m_size);
+    }
+    return *this;
+  }
+
+  /**
+   * Move assignment.
+   * @param other the @a SymbolBuffer to move from (empty afterwards).
+   * @return this instance.
+   */
+  SymbolBuffer& operator=(SymbolBuffer&& other) {
+    if (this != &other) {
+      moveFrom(&other);
+    }
+    return *this;
+  }
+
+  /**
+   * @return the number of symbols.
+   */
+  size_t size() const { return m_size; }
+
+  /**
+   * @return whether the buffer is heap allocated.
+   */
+  bool isAllocated() const { return m_data != m_inline; }
+
+  /**
+   * @return a pointer to the symbols.
+   */
+  const symbol_t* data() const { return m_data; }
+
+  /**
+   * @return a pointer to the symbols.
+   */
+  symbol_t* data() { return m_data; }
+
+  /**
+   * @return a pointer to the first symbol.
+   */
+  const symbol_t* begin() const { return m_data; }
+
+  /**
+   * @return a pointer behind the last symbol.
+   */
+  const symbol_t* end() const { return m_data + m_size; }
+
+  /**
+   * Return a reference to the symbol at the specified index (without range check).
+   * @param index the index of the symbol.
+   * @return the reference to the symbol.
+   */
+  symbol_t& operator[](size_t index) { return m_data[index]; }
+
+  /**
+   * Return the symbol at the specified index (without range check).
+   * @param index the index of the symbol.
+   * @return the symbol.
+   */
+  symbol_t operator[](size_t index) const { return m_data[index]; }
+
+  /**
+   * Append a symbol.
+   * @param value the symbol to append.
+   */
+  void push_back(symbol_t value) {
+    if (m_size == m_capacity) {
+      reserve(m_capacity * 2);
+    }
+    m_data[m_size++] = value;
+  }
+
+  /**
+   * Change the number of symbols.
+   * @param size the new number of symbols.
+   * @param value the symbol to fill added positions with.
+   */
+  void resize(size_t size, symbol_t value = 0) {
+    if (size > m_capacity) {
+      reserve(size > m_capacity * 2 ? size : m_capacity * 2);
+    }
+    if (size > m_size) {
+      memset(m_data + m_size, value, size - m_size);
+    }
+    m_size = size;
+  }
+
+  /**
+   * Make room for the specified number of symbols.
+   * @param capacity the minimum number of symbols to hold without reallocation.
+   */
+  void reserve(size_t capacity);
+
+  /**
+   * Remove all symbols (keeps the capacity).
+   */
+  void clear() { m_size = 0; }
+
+  /**
+   * Return whether this instance is equal to the other instance.
+   * @param other the other instance.
+   * @return true if this instance is equal to the other instance.
+   */
+  bool operator==(const SymbolBuffer& other) const {
+    return m_size == other.m_size && memcmp(m_data, other.m_data, m_size) == 0;
+  }
+
+  /**
+   * Return whether this instance is different from the other instance.
+   * @param other the other instance.
+   * @return true if this instance is different from the other instance.
+   */
+  bool operator!=(const SymbolBuffer& other) const { return !(*this == other); }
+
+
+ private:
+  /**
+   * Replace the symbols.
+   * @param data the symbols to copy.
+   * @param size the number of symbols.
+   */
+  void assign(const symbol_t* data, size_t size) {
+    if (size > m_capacity) {
+      reserve(size);
+    }
+    memcpy(m_data, data, size);
+    m_size = size;
+  }
+
+  /**
+   * Take over the symbols of the other instance.
+   * @param other the @a SymbolBuffer to move from (empty afterwards).
+   */
+  void moveFrom(SymbolBuffer* other);
+
+  /** the symbols, either @a m_inline or allocated on the heap. */
+  symbol_t* m_data;
+
+  /** the number of symbols. */
+  size_t m_size;
+
+  /** the number of symbols @a m_data can hold. */
+  size_t m_capacity;
+
+  /** the inline storage. */
+  symbol_t m_inline[SYMBOL_INLINE_SIZE];
+};
+
+
 /**
  * A string of unescaped bus symbols.
  */
@@ -135,6 +327,30 @@ class SymbolString {
    */
   static void updateCrc(symbol_t value, symbol_t* crc);
 
+  /**
+   * Update the CRC by adding several values at once.
+   * @param values the escaped values to add to the current CRC.
+   * @param len the number of values.
+   * @param crc the current CRC to update.
+   */
+  static void updateCrc(const symbol_t* values, size_t len, symbol_t* crc);
+
+  /**
+   * Update the CRC by adding several unescaped values at once (i.e. as if @a ESC and @a SYN were escaped).
+   * @param values the unescaped values to add to the current CRC.
+   * @param len the number of values.
+   * @param crc the current CRC to update.
+   */
+  static void updateCrcUnescaped(const symbol_t* values, size_t len, symbol_t* crc);
+
+  /**
+   * Unescape the values in place.
+   * @param values the escaped values to unescape.
+   * @param len the number of escaped values, updated to the number of unescaped values (up to an invalid sequence).
+   * @return @a RESULT_OK on success, or @a RESULT_ERR_ESC for an invalid escape sequence.
+   */
+  static result_t unescape(symbol_t* values, size_t* len);
+
   /**
    * Return whether this instance if for the master part.
    * @return whether this instance if for the master part.
@@ -234,7 +450,7 @@ class SymbolString {
     if (m_data.size() == 1) {
       return 2;
     }
-    if (equal(m_data.begin()+1, m_data.end(), other.m_data.begin()+1)) {
+    if (memcmp(m_data.data()+1, other.m_data.data()+1, m_data.size()-1) == 0) {
       return 2;
     }
     return 1;
@@ -362,8 +578,15 @@ class SymbolString {
   SymbolString(const SymbolString& str)
     : m_data(str.m_data), m_isMaster(str.m_isMaster) {}
 
+  /**
+   * Hidden move constructor.
+   * @param str the @a SymbolString to move from.
+   */
+  SymbolString(SymbolString&& str)
+    : m_data(std::move(str.m_data)), m_isMaster(str.m_isMaster) {}
+
   /** the string of unescaped symbols. */
-  vector<symbol_t> m_data;
+  SymbolBuffer m_data;
 
   /** whether this instance is for the master part. */
   bool m_isMaster;
@@ -386,12 +609,24 @@ class MasterSymbolString : public SymbolString {
    */
   MasterSymbolString(const MasterSymbolString& str) : SymbolString(str) {}
 
+  /**
+   * Move constructor.
+   * @param str the @a MasterSymbolString to move from.
+   */
+  MasterSymbolString(MasterSymbolString&& str) : SymbolString(std::move(str)) {}
+
   MasterSymbolString& operator=(const MasterSymbolString& other) {
     this->m_data = other.m_data;
     this->m_isMaster = true;
     return *this;
   }
 
+  MasterSymbolString& operator=(MasterSymbolString&& other) {
+    this->m_data = std::move(other.m_data);
+    this->m_isMaster = true;
+    return *this;
+  }
+
   MasterSymbolString& operator=(const MasterSymbolString* other) {
     this->m_data = other->m_data;
     this->m_isMaster = true;
@@ -416,12 +651,24 @@ class SlaveSymbolString : public SymbolString {
    */
   SlaveSymbolString(const SlaveSymbolString& str) : SymbolString(str) {}
 
+  /**
+   * Move constructor.
+   * @param str the @a SlaveSymbolString to move from.
+   */
+  SlaveSymbolString(SlaveSymbolString&& str) : SymbolString(std::move(str)) {}
+
   SlaveSymbolString& operator=(const SlaveSymbolString& other) {
     this->m_data = other.m_data;
     this->m_isMaster = false;
     return *this;
   }
 
+  SlaveSymbolString& operator=(SlaveSymbolString&& other) {
+    this->m_data = std::move(other.m_data);
+    this->m_isMaster = false;
+    return *this;
+  }
+
   SlaveSymbolString& operator=(const SlaveSymbolString* other) {
     this->m_data = other->m_data;
     this->m_isMaster = false;
@@ -612,6 +612,7 @@ int main() {
   vector<string> row;
   templates->readLineFromStream(&dummystr, __FILE__, false, &lineNo, &row, &errorDescription, false, nullptr, nullptr);
   const DataField* fields = nullptr;
+  size_t compiledCount = 0;
   for (unsigned int i = 0; i < sizeof(checks) / sizeof(checks[0]); i++) {
     string* check = checks[i];
     istringstream isstr(check[0]);
@@ -765,6 +766,36 @@ int main() {
         verify(failedReadMatch, "read", check[2] + " " + check[3], match, expectStr, output.str());
       }
     }
+    {
+      // compare the compiled decoder with the field hierarchy
+      DecodeProgram program;
+      if (program.compile(fields)) {
+        compiledCount++;
+      }
+      for (int part = 0; part < 2; part++) {
+        const SymbolString& data = part == 0 ? static_cast<const SymbolString&>(mstr) : sstr;
+        DataValueList expectValues, gotValues;
+        result_t expectResult = fields->readValues(data, 0, &expectValues);
+        result_t gotResult = program.isCompiled() ? program.execute(data, 0, &gotValues) : expectResult;
+        if (!program.isCompiled()) {
+          continue;
+        }
+        bool match = gotResult == expectResult && (gotResult < RESULT_OK || gotValues.size() == expectValues.size());
+        for (size_t idx = 0; match && gotResult >= RESULT_OK && idx < gotValues.size(); idx++) {
+          const field_value_t& got = gotValues[idx];
+          const field_value_t& expect = expectValues[idx];
+          match = got.field == expect.field && got.value.type == expect.value.type
+            && got.value.integer == expect.value.integer && got.value.number == expect.value.number
+            && got.value.text == expect.value.text;
+        }
+        if (!match) {
+          cout << "  compiled " << (part == 0 ? "master" : "slave") << " >" << check[2] << " " << check[3]
+               << "< error: got " << getResultCode(gotResult) << "/" << gotValues.size() << ", expected "
+               << getResultCode(expectResult) << "/" << expectValues.size() << endl;
+          error = true;
+        }
+      }
+    }
     if (testFields) {
       ssize_t cnt = static_cast<signed>(fields->getCount());
       bool numbered = flags.find('N') != string::npos;
@@ -848,6 +879,7 @@ int main() {
   }
 
   delete templates;
+  cout << "compiled " << compiledCount << " field definitions" << endl;
 
   const floatCheck_t floatChecks[] = {
     {0.0f, 0.0f, 0},
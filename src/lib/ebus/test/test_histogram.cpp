@@ -0,0 +1,72 @@
+/*
+ * ebusd - daemon for communication with eBUS heating systems.
+ * Copyright (C) 2014-2026 John Baier <ebusd@ebusd.eu>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <iostream>
+#include <sstream>
+#include <string>
+#include "lib/utils/histogram.h"
+
+using namespace std;
+using namespace ebusd;
+
+static bool error = false;
+
+void verify(string type, bool match, string expectStr, string gotStr) {
+  if (match) {
+    cout << "  " << type << " >" << gotStr << "< OK" << endl;
+  } else {
+    cout << "  " << type << " error: got >" << gotStr << "<, expected >" << expectStr << "<" << endl;
+    error = true;
+  }
+}
+
+int main() {
+  // buckets are exact for small values and cover each power of two with 8 sub buckets above
+  for (uint64_t value : {0ULL, 7ULL, 8ULL, 15ULL, 16ULL, 17ULL, 1000ULL, 4095ULL, 4096ULL, 123456789ULL}) {
+    size_t bucket = Histogram::getBucket(value);
+    uint64_t max = Histogram::getBucketMax(bucket);
+    uint64_t min = bucket == 0 ? 0 : Histogram::getBucketMax(bucket - 1) + 1;
+    verify("bucket " + to_string(value), min <= value && value <= max && max - min <= value / 8,
+           to_string(value), to_string(min) + "-" + to_string(max));
+  }
+  verify("bucket overflow", Histogram::getBucket(1ULL << 40) == HISTOGRAM_BUCKETS - 1,
+         to_string(HISTOGRAM_BUCKETS - 1), to_string(Histogram::getBucket(1ULL << 40)));
+
+  Histogram histogram;
+  ostringstream output;
+  histogram.format(&output, false);
+  verify("empty", output.str() == "0", "0", output.str());
+  for (uint64_t value = 1; value <= 1000; value++) {
+    histogram.add(value);
+  }
+  histogram_summary_t summary;
+  histogram.getSummary(&summary);
+  verify("count", summary.count == 1000, "1000", to_string(summary.count));
+  verify("p50", summary.p50 >= 500 && summary.p50 <= 500 + 500 / 8, "500", to_string(summary.p50));
+  verify("p90", summary.p90 >= 900 && summary.p90 <= 900 + 900 / 8, "900", to_string(summary.p90));
+  verify("p99", summary.p99 >= 990 && summary.p99 <= 1000, "990", to_string(summary.p99));
+  verify("max", summary.max == 1000, "1000", to_string(summary.max));
+  output.str("");
+  histogram.format(&output, true, true);
+  string expect = "{\"count\":1000,\"p50\":" + to_string(summary.p50) + ",\"p90\":" + to_string(summary.p90)
+    + ",\"p99\":" + to_string(summary.p99) + ",\"max\":1000}";
+  verify("json", output.str() == expect, expect, output.str());
+  histogram.getSummary(&summary);
+  verify("reset on read", summary.count == 0, "0", to_string(summary.count));
+
+  return error ? 1 : 0;
+}
@@ -0,0 +1,1107 @@
+/*
+ * ebusd - daemon for communication with eBUS heating systems.
+ * Copyright (C) 2014-2026 John Baier <ebusd@ebusd.eu>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <deque>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "lib/ebus/message.h"
+#include "lib/utils/clock.h"
+
+using namespace std;
+using namespace ebusd;
+
+static bool error = false;
+
+void verify(string type, bool match, string expectStr, string gotStr) {
+  if (match) {
+    cout << "  " << type << " >" << gotStr << "< OK" << endl;
+  } else {
+    cout << "  " << type << " error: got >" << gotStr << "<, expected >" << expectStr << "<" << endl;
+    error = true;
+  }
+}
+
+/** the number of heap allocations done so far. */
+static size_t allocationCount = 0;
+
+void* operator new(size_t size) {
+  allocationCount++;
+  void* ptr = malloc(size);
+  if (!ptr) {
+    throw bad_alloc();
+  }
+  return ptr;
+}
+
+void operator delete(void* ptr) noexcept {
+  free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+  free(ptr);
+}
+
+/** the number of random telegrams to compare and measure. */
+#define BENCH_COUNT 20000
+
+/** the number of rounds to measure. */
+#define BENCH_ROUNDS 20
+
+/** the number of definition reloads to benchmark. */
+#define BENCH_RELOADS 20
+
+/** the bit mask of the source master number in the message key (same as in message.cpp). */
+#define REF_ID_SOURCE_MASK (0x1fLL << (8 * 7))
+
+/** the bit mask for the ID length and combined ID bytes in the message key (same as in message.cpp). */
+#define REF_ID_LENGTH_AND_IDS_MASK ((7LL << (8 * 7 + 5)) | 0xffffffffLL)
+
+/** the bits for arbitrary source and active write message (same as in message.cpp). */
+#define REF_ID_SOURCE_ACTIVE_WRITE (0x1fLL << (8 * 7))
+
+/** the bits for arbitrary source and active read message (same as in message.cpp). */
+#define REF_ID_SOURCE_ACTIVE_READ (0x1eLL << (8 * 7))
+
+namespace ebusd {
+
+class TestResolver : public Resolver {
+ public:
+  virtual DataFieldTemplates* getTemplates(const string& filename) {
+    return &m_templates;
+  }
+
+  virtual result_t loadDefinitionsFromConfigPath(FileReader* reader, const string& filename,
+      map<string, string>* defaults, string* errorDescription, bool replace = false) {
+    return RESULT_ERR_NOTFOUND;
+  }
+
+ private:
+  DataFieldTemplates m_templates;
+};
+
+}  // namespace ebusd
+
+/**
+ * The previous lookup probing all ID lengths and source kinds for reference.
+ * @param messages the @a MessageMap.
+ * @param master the @a MasterSymbolString for identifying the @a Message.
+ * @return the @a Message instance, or nullptr.
+ */
+Message* referenceFind(const MessageMap* messages, const MasterSymbolString& master) {
+  size_t maxIdLength = messages->getMaxIdLength();
+  uint64_t baseKey = Message::createKey(master, maxIdLength);
+  if (baseKey == 0xffffffffffffffffLL) {
+    return nullptr;
+  }
+  for (size_t idLength = maxIdLength; true; idLength--) {
+    uint64_t key = baseKey;
+    if (idLength == maxIdLength) {
+      baseKey &= ~REF_ID_LENGTH_AND_IDS_MASK;
+    } else {
+      key |= (uint64_t)idLength << (8 * 7 + 5);
+      int exp = 3;
+      for (size_t i = 0; i < idLength; i++) {
+        key ^= (uint64_t)master.dataAt(i) << (8 * exp--);
+        if (exp < 0) {
+          exp = 3;
+        }
+      }
+    }
+    uint64_t keys[4];
+    size_t keyCount = 0;
+    keys[keyCount++] = key;
+    if ((key & REF_ID_SOURCE_MASK) != 0) {
+      key &= ~REF_ID_SOURCE_MASK;
+      keys[keyCount++] = key;
+    }
+    keys[keyCount++] = key | REF_ID_SOURCE_ACTIVE_READ;
+    keys[keyCount++] = key | REF_ID_SOURCE_ACTIVE_WRITE;
+    for (size_t i = 0; i < keyCount; i++) {
+      const vector<Message*>* candidates = messages->getByKey(keys[i]);
+      if (!candidates) {
+        continue;
+      }
+      for (auto message : *candidates) {
+        if (message->checkId(master, nullptr) && message->isAvailable()) {
+          return message;
+        }
+      }
+    }
+    if (idLength == 0) {
+      break;
+    }
+  }
+  return nullptr;
+}
+
+/**
+ * The previous name lookup building a lowercase key for reference.
+ * @param byName the @a Message instances by lowercase circuit, name, and type.
+ * @param circuit the circuit name.
+ * @param name the message name.
+ * @param isWrite whether to find a write message.
+ * @return the @a Message instance, or nullptr.
+ */
+Message* referenceFindByName(const map<string, vector<Message*> >& byName, const string& circuit, const string& name,
+    bool isWrite) {
+  string lcircuit = circuit;
+  FileReader::tolower(&lcircuit);
+  string lname = name;
+  FileReader::tolower(&lname);
+  string nameKey = lcircuit + FIELD_SEPARATOR + lname + (isWrite ? "W" : "R");
+  const auto it = byName.find(nameKey);
+  if (it == byName.end()) {
+    return nullptr;
+  }
+  for (auto message : it->second) {
+    if (message->isAvailable() && message->hasLevel("")) {
+      return message;
+    }
+  }
+  return nullptr;
+}
+
+/**
+ * The previous filter of findAll() lowercasing each circuit and name for reference.
+ * @param all all @a Message instances in order of circuit and name.
+ * @param circuit the circuit name to match, or empty for any.
+ * @param name the message name to match, or empty for any.
+ * @param completeMatch true for a complete match of circuit and name, false for a partial one.
+ * @param withRead true to include read messages.
+ * @param withWrite true to include write messages.
+ * @param withPassive true to include passive messages.
+ * @param since the start time from which to add updates (inclusive), or 0 to ignore.
+ * @param until the end time to which to add updates (exclusive), or 0 to ignore.
+ * @param changedSince true to use the last change time for the since/until range, false to use the last seen time.
+ * @param messages the @a deque to which to add the found @a Message instances.
+ */
+void referenceFindAll(const deque<Message*>& all, const string& circuit, const string& name, bool completeMatch,
+    bool withRead, bool withWrite, bool withPassive, time_t since, time_t until, bool changedSince,
+    deque<Message*>* messages) {
+  string lcircuit = circuit;
+  FileReader::tolower(&lcircuit);
+  string lname = name;
+  FileReader::tolower(&lname);
+  for (const auto message : all) {
+    if (!lcircuit.empty()) {
+      string check = message->getCircuit();
+      FileReader::tolower(&check);
+      if (completeMatch ? (check != lcircuit) : (check.find(lcircuit) == check.npos)) {
+        continue;
+      }
+    }
+    if (!lname.empty()) {
+      string check = message->getName();
+      FileReader::tolower(&check);
+      if (completeMatch ? (check != lname) : (check.find(lname) == check.npos)) {
+        continue;
+      }
+    }
+    if (!(message->isPassive() ? withPassive : message->isWrite() ? withWrite : withRead)) {
+      continue;
+    }
+    if (since != 0 || until != 0) {
+      if (message->getDstAddress() == SYN) {
+        continue;
+      }
+      time_t lastchg = changedSince ? message->getLastChangeTime() : message->getLastUpdateTime();
+      if ((since != 0 && lastchg < since) || (until != 0 && lastchg >= until)) {
+        continue;
+      }
+    }
+    if (message->isAvailable()) {
+      messages->push_back(message);
+    }
+  }
+}
+
+int main() {
+  // the shipped broadcast definitions plus a typical set of vendor specific circuits
+  ostringstream definitions;
+  definitions
+    << "# type (r[1-9];w;u),class,name,comment,QQ,ZZ,PBSB,ID,field,part (m/s),type / templates,divider / values,"
+       "unit,comment\n"
+       "*r,broadcast,,,,,,,,,\n"
+       "*b,broadcast,,,,FE,,,,,\n"
+       "*w,broadcast,,,,FE,,,,,\n"
+       "b,,datetime,date/time,,,0700,,outsidetemp,,D2B,,°C,,time,,BTI,,,,date,,BDA,,,\n"
+       "r;b,,id,identification,,,0704,,manufacturer,,UCH,,,,id,,STR:5,,,,software,,PIN,,,,hardware,,PIN,,,\n"
+       "w,,queryexistence,Inquiry of existence,,,07FE,,,,,\n"
+       "b,,signoflife,sign of life,,,07FF,,,,,\n"
+       "b,,error,error message,,,FE01,,error,,STR:10,,,\n"
+       "b,,netresetstate,reset network start,,,FF00,,,,,\n"
+       "b,,netresetcfg,reset network configuration,,,FF01,,,,,\n"
+       "b,,netloss,network loss,,,FF02,,,,,\n";
+  const char* circuits[] = {"bai", "ctl", "hmu"};
+  const char* addresses[] = {"08", "15", "76"};
+  for (size_t c = 0; c < 3; c++) {
+    for (unsigned int reg = 0; reg < 150; reg++) {
+      definitions << "r," << circuits[c] << ",reg" << reg << ",,," << addresses[c] << ",b509,0d"
+                  << hex << setw(2) << setfill('0') << reg << "00" << dec << ",,s,UIN\n";
+    }
+    for (unsigned int reg = 0; reg < 50; reg++) {
+      definitions << "w," << circuits[c] << ",reg" << reg << ",,," << addresses[c] << ",b509,0e"
+                  << hex << setw(2) << setfill('0') << reg << "00" << dec << ",,m,UIN\n";
+    }
+    for (unsigned int reg = 0; reg < 50; reg++) {
+      definitions << "r," << circuits[c] << ",par" << reg << ",,," << addresses[c] << ",b524,02000000"
+                  << hex << setw(2) << setfill('0') << reg << "00" << dec << ",,s,IGN:4,,s,UIN\n";
+    }
+    definitions << "u," << circuits[c] << ",status,,10," << addresses[c] << ",b511,01,,s,UCH\n";
+  }
+  definitions << "u,bai,ctlstatus,,10,08,b510,00,,m,UCH\n"
+                 "u,broadcast,vdatetime,,,fe,b516,00,,m,UCH\n";
+  MessageMap* messages = new MessageMap("");
+  messages->setResolver(new TestResolver());
+  istringstream stream(definitions.str());
+  string errorDescription;
+  result_t result = messages->readFromStream(&stream, "bench.csv", 0, false, nullptr, &errorDescription);
+  verify("read definitions", result == RESULT_OK, "OK", getResultCode(result));
+
+  // random telegrams, partly matching the definitions
+  static MasterSymbolString telegrams[BENCH_COUNT];
+  const char* headers[] = {
+    "1008b509030d", "1015b509030d", "1076b509030d", "1008b509030e", "1008b524060200000000",
+    "10feb5160800", "10fe07000900", "1008070400", "1008b51101", "1008b51001", "3108b5040100", "1052b5230100",
+  };
+  srand(1);
+  for (size_t i = 0; i < BENCH_COUNT; i++) {
+    string hexStr = headers[static_cast<size_t>(rand()) % (sizeof(headers) / sizeof(headers[0]))];
+    MasterSymbolString& master = telegrams[i];
+    master.parseHex(hexStr);
+    size_t len = master[4];
+    for (size_t pos = master.size() - 5; pos < len; pos++) {
+      master.push_back((symbol_t)(rand() % 4 == 0 ? rand() % 256 : (pos == 1 ? rand() % 160 : 0)));
+    }
+  }
+
+  // compare with the reference implementation
+  size_t diffs = 0, found = 0;
+  for (size_t i = 0; i < BENCH_COUNT; i++) {
+    Message* message = messages->find(telegrams[i]);
+    if (message != referenceFind(messages, telegrams[i])) {
+      diffs++;
+    }
+    if (message) {
+      found++;
+    }
+  }
+  verify("lookup diffs", diffs == 0, "0", to_string(diffs));
+  verify("lookup found", found > BENCH_COUNT / 4 && found < BENCH_COUNT, "some", to_string(found));
+
+  // measure
+  uint64_t start = clockGetMicros();
+  size_t sum = 0;
+  for (int round = 0; round < BENCH_ROUNDS; round++) {
+    for (size_t i = 0; i < BENCH_COUNT; i++) {
+      sum += referenceFind(messages, telegrams[i]) ? 1 : 0;
+    }
+  }
+  uint64_t referenceMicros = clockGetMicros() - start;
+  start = clockGetMicros();
+  for (int round = 0; round < BENCH_ROUNDS; round++) {
+    for (size_t i = 0; i < BENCH_COUNT; i++) {
+      sum += messages->find(telegrams[i]) ? 1 : 0;
+    }
+  }
+  uint64_t micros = clockGetMicros() - start;
+  size_t count = BENCH_COUNT*BENCH_ROUNDS;
+  cout << fixed << setprecision(3)
+       << "  bench " << count << " telegrams on " << messages->size() << " messages (found " << sum << "):" << endl
+       << "    lookup previous: " << (1000.0*static_cast<double>(referenceMicros)/static_cast<double>(count))
+       << " ns/telegram, now: " << (1000.0*static_cast<double>(micros)/static_cast<double>(count))
+       << " ns/telegram" << endl;
+
+  // compare the name lookup with the reference implementation
+  map<string, vector<Message*> > byName;
+  deque<Message*> all;
+  messages->findAll("", "", "*", false, true, true, false, true, true, 0, 0, false, &all);
+  for (auto message : all) {
+    string nameKey = message->getCircuit() + FIELD_SEPARATOR + message->getName() + (message->isWrite() ? "W" : "R");
+    FileReader::tolower(&nameKey);
+    nameKey[nameKey.length() - 1] = message->isWrite() ? 'W' : 'R';
+    byName[nameKey].push_back(message);
+  }
+  static string names[BENCH_COUNT][2];
+  static bool writes[BENCH_COUNT];
+  for (size_t i = 0; i < BENCH_COUNT; i++) {
+    string circuit = circuits[static_cast<size_t>(rand()) % 3];
+    string name = (rand() % 2 == 0 ? "reg" : "par") + to_string(rand() % 200);
+    if (rand() % 2 == 0) {
+      circuit[0] = static_cast<char>(::toupper(circuit[0]));
+      name[0] = static_cast<char>(::toupper(name[0]));
+    }
+    names[i][0] = circuit;
+    names[i][1] = name;
+    writes[i] = rand() % 4 == 0;
+  }
+  diffs = found = 0;
+  for (size_t i = 0; i < BENCH_COUNT; i++) {
+    Message* message = messages->find(names[i][0], names[i][1], "", writes[i], false);
+    if (message != referenceFindByName(byName, names[i][0], names[i][1], writes[i])) {
+      diffs++;
+    }
+    if (message) {
+      found++;
+    }
+  }
+  verify("name lookup diffs", diffs == 0, "0", to_string(diffs));
+  verify("name lookup found", found > BENCH_COUNT / 4 && found < BENCH_COUNT, "some", to_string(found));
+  Message* message = messages->find("", "REG1", "", false, false);
+  verify("name lookup without circuit", message && message->getCircuit() == "bai", "bai",
+      message ? message->getCircuit() : "-");
+
+  // measure
+  start = clockGetMicros();
+  for (int round = 0; round < BENCH_ROUNDS; round++) {
+    for (size_t i = 0; i < BENCH_COUNT; i++) {
+      sum += referenceFindByName(byName, names[i][0], names[i][1], writes[i]) ? 1 : 0;
+    }
+  }
+  referenceMicros = clockGetMicros() - start;
+  start = clockGetMicros();
+  for (int round = 0; round < BENCH_ROUNDS; round++) {
+    for (size_t i = 0; i < BENCH_COUNT; i++) {
+      sum += messages->find(names[i][0], names[i][1], "", writes[i], false) ? 1 : 0;
+    }
+  }
+  micros = clockGetMicros() - start;
+  cout << setprecision(0) << "  bench " << count << " name lookups (checksum " << sum % 1000 << "):" << endl
+       << "    lookups/sec previous: " << (static_cast<double>(count)*1000000.0/static_cast<double>(referenceMicros))
+       << ", now: " << (static_cast<double>(count)*1000000.0/static_cast<double>(micros)) << endl;
+
+  // compare the filtered lookup with the reference implementation
+  all.clear();
+  messages->findAll("", "", "*", false, true, true, true, true, true, 0, 0, false, &all);
+  time_t now;
+  time(&now);
+  for (size_t i = 0; i < all.size(); i += 7) {
+    Message* update = all[i];
+    MasterSymbolString master;
+    SlaveSymbolString slave;
+    istringstream input;
+    if (update->prepareMaster(0, 0x10, SYN, UI_FIELD_SEPARATOR, &input, &master) == RESULT_OK) {
+      slave.parseHex(i % 2 == 0 ? "020100" : "0100");
+      update->storeLastData(master, slave);
+    }
+  }
+  messages->invalidateCache(all[0]);
+  const char* filters[][2] = {
+    {"", ""}, {"bai", ""}, {"BAI", ""}, {"a", ""}, {"ct", "reg1"}, {"", "Reg12"}, {"hmu", "par49"}, {"x", ""},
+    {"broadcast", ""},
+  };
+  diffs = 0;
+  size_t total = 0;
+  for (size_t i = 0; i < sizeof(filters) / sizeof(filters[0]); i++) {
+    for (int variant = 0; variant < 16; variant++) {
+      bool completeMatch = (variant & 1) != 0;
+      bool withWrite = (variant & 2) != 0;
+      bool withPassive = (variant & 4) != 0;
+      time_t since = (variant & 8) != 0 ? now - 1 : 0;
+      for (int changed = 0; changed < (since ? 2 : 1); changed++) {
+        deque<Message*> got, expected;
+        messages->findAll(filters[i][0], filters[i][1], "*", completeMatch, true, withWrite, withPassive, true, true,
+            since, since ? now + 1 : 0, changed != 0, &got);
+        referenceFindAll(all, filters[i][0], filters[i][1], completeMatch, true, withWrite, withPassive, since,
+            since ? now + 1 : 0, changed != 0, &expected);
+        if (since) {
+          // in order of the last update
+          sort(got.begin(), got.end());
+          sort(expected.begin(), expected.end());
+        }
+        if (got != expected) {
+          cout << "  findAll " << filters[i][0] << "/" << filters[i][1] << " variant " << variant << " changed "
+               << changed << ": got " << got.size() << ", expected " << expected.size() << endl;
+          diffs++;
+        }
+        total += got.size();
+      }
+    }
+  }
+  verify("findAll diffs", diffs == 0, "0", to_string(diffs));
+  verify("findAll found", total > 0, "some", to_string(total));
+
+  // measure
+  start = clockGetMicros();
+  for (int round = 0; round < BENCH_ROUNDS * 10; round++) {
+    deque<Message*> found;
+    referenceFindAll(all, "", "", false, true, true, true, now, now + 1, false, &found);
+    referenceFindAll(all, "bai", "", true, true, true, true, 0, 0, false, &found);
+    sum += found.size();
+  }
+  referenceMicros = clockGetMicros() - start;
+  start = clockGetMicros();
+  for (int round = 0; round < BENCH_ROUNDS * 10; round++) {
+    deque<Message*> found;
+    messages->findAll("", "", "*", false, true, true, true, true, true, now, now + 1, false, &found);
+    messages->findAll("bai", "", "*", true, true, true, true, true, true, 0, 0, false, &found);
+    sum += found.size();
+  }
+  micros = clockGetMicros() - start;
+  count = BENCH_ROUNDS * 10;
+  cout << "  bench " << count << " updated+circuit queries (checksum " << sum % 1000 << "):" << endl
+       << "    queries/sec previous: " << (static_cast<double>(count)*1000000.0/static_cast<double>(referenceMicros))
+       << ", now: " << (static_cast<double>(count)*1000000.0/static_cast<double>(micros)) << endl;
+
+  // compare the sibling groups with the previous lookup of invalidateCache()
+  diffs = 0;
+  size_t siblings = 0;
+  for (const auto message : all) {
+    deque<Message*> expected;
+    referenceFindAll(all, message->getCircuit(), message->getName(), true, true, true, true, 0, 0, false, &expected);
+    vector<Message*> got;
+    Message* sibling = message;
+    do {
+      got.push_back(sibling);
+      sibling = sibling->getNextSibling();
+    } while (sibling != message && got.size() <= all.size());
+    sort(got.begin(), got.end());
+    sort(expected.begin(), expected.end());
+    if (got.size() != expected.size() || !equal(got.begin(), got.end(), expected.begin())) {
+      cout << "  siblings " << message->getCircuit() << " " << message->getName() << ": got " << got.size()
+           << ", expected " << expected.size() << endl;
+      diffs++;
+    }
+    siblings += got.size() - 1;
+  }
+  verify("sibling diffs", diffs == 0, "0", to_string(diffs));
+  verify("siblings found", siblings > 0, "some", to_string(siblings));
+
+  // measure
+  start = clockGetMicros();
+  for (int round = 0; round < BENCH_ROUNDS; round++) {
+    for (size_t i = 0; i < all.size(); i += 3) {
+      deque<Message*> found;
+      messages->findAll(all[i]->getCircuit(), all[i]->getName(), "*", true, true, true, true, true, true, 0, 0, false,
+          &found);
+      sum += found.size();
+    }
+  }
+  referenceMicros = clockGetMicros() - start;
+  count = 0;
+  start = clockGetMicros();
+  for (int round = 0; round < BENCH_ROUNDS; round++) {
+    for (size_t i = 0; i < all.size(); i += 3) {
+      messages->invalidateCache(all[i]);
+      count++;
+    }
+  }
+  micros = clockGetMicros() - start;
+  cout << "  bench " << count << " cache invalidations:" << endl
+       << "    invalidations/sec previous: "
+       << (static_cast<double>(count)*1000000.0/static_cast<double>(referenceMicros))
+       << ", now: " << (static_cast<double>(count)*1000000.0/static_cast<double>(micros)) << endl;
+
+  // check the journal for repeated updates within the same second
+  vector<Message*> journalMessages;
+  vector<MasterSymbolString> journalMasters;
+  for (size_t i = 1; i < all.size() && journalMessages.size() < 2; i++) {
+    MasterSymbolString master;
+    istringstream input;
+    if (!all[i]->isPassive() && all[i]->getDstAddress() != BROADCAST
+        && all[i]->prepareMaster(0, 0x10, SYN, UI_FIELD_SEPARATOR, &input, &master) == RESULT_OK) {
+      journalMessages.push_back(all[i]);
+      journalMasters.push_back(master);
+    }
+  }
+  SlaveSymbolString slave1, slave2;
+  slave1.parseHex("0101");
+  slave2.parseHex("0102");
+  uint64_t sequence = messages->getLastSequence(), lastSequence = 0;
+  journalMessages[0]->storeLastData(journalMasters[0], slave1);
+  journalMessages[1]->storeLastData(journalMasters[1], slave1);
+  journalMessages[0]->storeLastData(journalMasters[0], slave1);
+  deque<Message*> updated;
+  bool journalFound = messages->findUpdated("*", sequence, false, &lastSequence, &updated);
+  verify("journal updated", journalFound && updated.size() == 2 && updated[0] == journalMessages[1]
+      && updated[1] == journalMessages[0], "2", to_string(updated.size()));
+  updated.clear();
+  journalFound = messages->findUpdated("*", sequence, true, &lastSequence, &updated);
+  verify("journal changed", journalFound && updated.size() == 2 && updated[0] == journalMessages[0]
+      && updated[1] == journalMessages[1], "2", to_string(updated.size()));
+  sequence = lastSequence;
+  journalMessages[1]->storeLastData(journalMasters[1], slave2);
+  updated.clear();
+  journalFound = messages->findUpdated("*", sequence, true, &lastSequence, &updated);
+  verify("journal changed again", journalFound && updated.size() == 1 && updated[0] == journalMessages[1], "1",
+      to_string(updated.size()));
+  updated.clear();
+  journalFound = messages->findUpdated("*", lastSequence, false, &lastSequence, &updated);
+  verify("journal empty", journalFound && updated.empty(), "0", to_string(updated.size()));
+  for (size_t i = 0; i < MESSAGE_JOURNAL_SIZE; i++) {
+    journalMessages[i % 2]->storeLastData(journalMasters[i % 2], i % 4 < 2 ? slave1 : slave2);
+  }
+  updated.clear();
+  journalFound = messages->findUpdated("*", sequence, false, &lastSequence, &updated);
+  verify("journal overrun", !journalFound && updated.empty(), "overrun", journalFound ? "found" : "overrun");
+  sequence = lastSequence;
+  journalMessages[0]->storeLastData(journalMasters[0], slave1);
+  journalMessages[1]->storeLastData(journalMasters[1], slave1);
+  updated.clear();
+  journalFound = messages->findUpdated(journalMessages[1]->getCircuit(), journalMessages[1]->getName(), "*", true,
+      true, sequence, false, &lastSequence, &updated);
+  size_t expectFiltered = journalMessages[0]->getCircuit() == journalMessages[1]->getCircuit()
+      && journalMessages[0]->getName() == journalMessages[1]->getName() ? 2 : 1;
+  verify("journal filtered", journalFound && updated.size() == expectFiltered
+      && updated.back() == journalMessages[1], to_string(expectFiltered), to_string(updated.size()));
+
+  // keep finding newer changes behind a change stored without update right after invalidating the cache
+  time(&now);
+  journalMessages[1]->storeLastData(journalMasters[1], slave2);
+  messages->invalidateCache(journalMessages[0]);
+  journalMessages[0]->storeLastData(0, SlaveSymbolString());
+  deque<Message*> changes;
+  messages->findAll("", "", "*", false, true, true, true, true, false, now, 0, true, &changes);
+  bool changesFound = find(changes.begin(), changes.end(), journalMessages[0]) != changes.end()
+      && find(changes.begin(), changes.end(), journalMessages[1]) != changes.end();
+  verify("findAll changed without update", changesFound, "found", to_string(changes.size()));
+  journalMessages[0]->storeLastData(journalMasters[0], slave1);
+
+  // compare the cached decoding with the uncached one
+  const OutputFormat formats[] = {OF_NONE, OF_NAMES | OF_UNITS, OF_NUMERIC | OF_JSON, OF_RAWDATA | OF_VALUENAME};
+  diffs = 0;
+  for (size_t i = 0; i < 8; i++) {
+    Message* message = journalMessages[i % 2];
+    if (i == 4) {
+      message->storeLastData(journalMasters[i % 2], slave1);
+    }
+    for (const auto format : formats) {
+      for (int field = 0; field < 3; field++) {
+        const char* fieldName = field == 1 ? "" : nullptr;
+        ssize_t fieldIndex = field == 2 ? 0 : -1;
+        ostringstream got, expected;
+        result_t gotResult = message->decodeLastData(pt_any, i % 3 == 0, fieldName, fieldIndex, format, &got);
+        result_t expectedResult = message->decodeLastDataUncached(pt_any, i % 3 == 0, fieldName, fieldIndex, format,
+            &expected);
+        if (gotResult != expectedResult || got.str() != expected.str()) {
+          cout << "  decode " << message->getName() << " format " << format << " field " << field << ": got "
+               << got.str() << ", expected " << expected.str() << endl;
+          diffs++;
+        }
+      }
+    }
+  }
+  verify("decode cache diffs", diffs == 0, "0", to_string(diffs));
+
+  // measure with a message having several fields
+  Message* dateTime = messages->find("broadcast", "datetime", "", false, true);
+  verify("decode message", dateTime != nullptr, "found", dateTime ? "found" : "missing");
+  if (!dateTime) {
+    return 1;
+  }
+  MasterSymbolString dateTimeMaster;
+  dateTimeMaster.parseHex("10fe07000900101030121511022a");
+  dateTime->storeLastData(dateTimeMaster, SlaveSymbolString());
+  ostringstream output;
+  start = clockGetMicros();
+  for (int round = 0; round < BENCH_ROUNDS * 100; round++) {
+    output.str("");
+    dateTime->decodeLastDataUncached(pt_any, false, nullptr, -1, OF_NAMES | OF_UNITS | OF_JSON, &output);
+    sum += output.tellp();
+  }
+  referenceMicros = clockGetMicros() - start;
+  start = clockGetMicros();
+  for (int round = 0; round < BENCH_ROUNDS * 100; round++) {
+    output.str("");
+    dateTime->decodeLastData(pt_any, false, nullptr, -1, OF_NAMES | OF_UNITS | OF_JSON, &output);
+    sum += output.tellp();
+  }
+  micros = clockGetMicros() - start;
+  count = BENCH_ROUNDS * 100;
+  cout << "  bench " << count << " unchanged decodes (checksum " << sum % 1000 << "):" << endl
+       << "    decodes/sec previous: " << (static_cast<double>(count)*1000000.0/static_cast<double>(referenceMicros))
+       << ", now: " << (static_cast<double>(count)*1000000.0/static_cast<double>(micros)) << endl;
+
+  // compare the typed values with the formatted ones
+  DataValueList values;
+  dateTimeMaster.clear();
+  dateTimeMaster.parseHex("10fe070009001010301215110426");
+  dateTime->storeLastData(dateTimeMaster, SlaveSymbolString());
+  result = dateTime->decodeLastValues(&values);
+  verify("decode values", result == RESULT_OK && values.size() == 3, "3", to_string(values.size()));
+  diffs = 0;
+  for (size_t i = 0; i < values.size(); i++) {
+    const data_value_t& value = values[i].value;
+    output.str("");
+    dateTime->decodeLastDataUncached(pt_any, false, nullptr, static_cast<ssize_t>(i), OF_NONE, &output);
+    string expected = output.str();
+    bool match;
+    switch (value.type) {
+      case dvt_null:
+        match = expected == NULL_VALUE;
+        break;
+      case dvt_integer:
+        match = expected == to_string(value.integer);
+        break;
+      case dvt_number:
+        match = fabs(strtod(expected.c_str(), nullptr) - value.number) < 0.001;
+        break;
+      default:
+        match = expected == value.text;
+        break;
+    }
+    if (!match || values[i].field->getName(-1) != dateTime->getFieldName(static_cast<ssize_t>(i))) {
+      cout << "  value " << i << " type " << value.type << ": got " << value.number << "/" << value.text
+           << ", expected " << expected << endl;
+      diffs++;
+    }
+  }
+  verify("typed value diffs", diffs == 0, "0", to_string(diffs));
+  start = clockGetMicros();
+  for (int round = 0; round < BENCH_ROUNDS * 100; round++) {
+    output.str("");
+    journalMessages[0]->decodeLastDataUncached(pt_any, false, nullptr, -1, OF_NONE, &output);
+    sum += output.tellp();
+  }
+  referenceMicros = clockGetMicros() - start;
+  start = clockGetMicros();
+  for (int round = 0; round < BENCH_ROUNDS * 100; round++) {
+    journalMessages[0]->decodeLastValues(&values);
+    sum += values.size();
+  }
+  micros = clockGetMicros() - start;
+  cout << "  bench " << count << " typed numeric decodes (checksum " << sum % 1000 << "):" << endl
+       << "    decodes/sec formatted: " << (static_cast<double>(count)*1000000.0/static_cast<double>(referenceMicros))
+       << ", typed: " << (static_cast<double>(count)*1000000.0/static_cast<double>(micros)) << endl;
+
+  // measure the compiled decoder with a typical set of numeric fields
+  vector<const SingleDataField*> captureFields;
+  const char* captureTypes[] = {"D2C", "D2C", "UIN", "UCH", "SIN", "BCD", "PIN", "D1C"};
+  map<string, string> noAttributes;
+  for (const auto type : captureTypes) {
+    const DataType* dataType = DataTypeList::getInstance()->get(type);
+    captureFields.push_back(new SingleDataField(type, noAttributes, dataType, pt_slaveData,
+        dataType->getBitCount() / 8));
+  }
+  DataFieldSet captureSet("capture", captureFields);
+  DecodeProgram captureProgram;
+  bool compiled = captureProgram.compile(&captureSet);
+  verify("compile", compiled, "compiled", compiled ? "compiled" : "not compiled");
+  SlaveSymbolString captureSlave;
+  captureSlave.parseHex("0e5001a0ff34120708fe1906034012");
+  start = clockGetMicros();
+  for (int round = 0; round < BENCH_ROUNDS * 100; round++) {
+    values.clear();
+    captureSet.readValues(captureSlave, 0, &values);
+    sum += values.size();
+  }
+  referenceMicros = clockGetMicros() - start;
+  start = clockGetMicros();
+  for (int round = 0; round < BENCH_ROUNDS * 100; round++) {
+    values.clear();
+    captureProgram.execute(captureSlave, 0, &values);
+    sum += values.size();
+  }
+  micros = clockGetMicros() - start;
+  verify("compiled values", values.size() == captureFields.size(), to_string(captureFields.size()),
+      to_string(values.size()));
+  cout << "  bench " << count << " compiled decodes (checksum " << sum % 1000 << "):" << endl
+       << "    decodes/sec fields: " << (static_cast<double>(count)*1000000.0/static_cast<double>(referenceMicros))
+       << ", compiled: " << (static_cast<double>(count)*1000000.0/static_cast<double>(micros)) << endl;
+
+  // compare the column decoding with the compiled decoder for each telegram
+  vector<const SingleDataField*> columnFields;
+  const char* columnTypes[] = {"UCH", "SCH", "D1C", "BI3", "D2B", "D2C", "FLR", "UIR", "BCD:2", "HCD", "PIN", "EXP",
+                               "SLG"};
+  for (const auto type : columnTypes) {
+    const DataType* dataType = DataTypeList::getInstance()->get(type);
+    size_t length = (dataType->getBitCount() + 7) / 8;
+    columnFields.push_back(new SingleDataField(type, noAttributes, dataType, pt_slaveData, length));
+  }
+  map<unsigned int, string> columnList = {{0, "off"}, {1, "on"}, {0xff, "unknown"}};
+  columnFields.push_back(new ValueListDataField("list", noAttributes, DataTypeList::getInstance()->get("UCH"),
+      pt_slaveData, 1, columnList));
+  DataFieldSet columnSet("column", columnFields);
+  DecodeProgram columnProgram;
+  compiled = columnProgram.compile(&columnSet);
+  verify("compile column", compiled, "compiled", compiled ? "compiled" : "not compiled");
+  vector<SlaveSymbolString> columnSlaves(BENCH_COUNT);
+  vector<const SymbolString*> columnData;
+  size_t columnLength = columnSet.getLength(pt_slaveData, MAX_LEN);
+  for (auto& slave : columnSlaves) {
+    slave.push_back((symbol_t)columnLength);
+    for (size_t pos = 0; pos < columnLength; pos++) {
+      int kind = rand() % 8;
+      slave.push_back((symbol_t)(kind == 0 ? 0xff : kind == 1 ? 0x80 : kind == 2 ? 0 : kind == 3 ? 0x12 : rand() % 256));
+    }
+    slave.adjustHeader();
+    columnData.push_back(&slave);
+  }
+  vector<double> column(BENCH_COUNT);
+  diffs = 0;
+  for (const auto field : columnFields) {
+    columnProgram.decodeColumn(field, columnData.data(), columnData.size(), 0, column.data());
+    for (size_t row = 0; row < columnData.size(); row++) {
+      values.clear();
+      result = columnProgram.execute(*columnData[row], 0, &values);
+      double expected = NAN;
+      bool decoded = false;
+      for (size_t idx = 0; idx < values.size(); idx++) {
+        if (values[idx].field == field) {
+          decoded = true;
+          DataValueType type = values[idx].value.type;
+          if (type == dvt_number || type == dvt_integer || type == dvt_list) {
+            expected = values[idx].value.number;
+          }
+          break;
+        }
+      }
+      if (result != RESULT_OK && !decoded) {
+        continue;  // decoding stopped at an invalid field
+      }
+      if (isnan(column[row]) != isnan(expected) || (!isnan(expected) && column[row] != expected)) {
+        if (diffs++ < 5) {
+          cout << "  column " << field->getName(-1) << " row " << row << " " << columnData[row]->getStr() << ": got "
+               << column[row] << ", expected " << expected << endl;
+        }
+      }
+    }
+  }
+  verify("column diffs", diffs == 0, "0", to_string(diffs));
+
+  Message* columnMessage = messages->find("bai", "reg0", "", false, false);
+  SlaveSymbolString columnSlave;
+  columnSlave.parseHex("022a01");
+  vector<const SymbolString*> messageData = {&columnSlave};
+  result = columnMessage ? columnMessage->decodeColumn(0, messageData, &column) : RESULT_ERR_NOTFOUND;
+  verify("message column", result == RESULT_OK && column.size() == 1 && column[0] == 298, "298",
+      result == RESULT_OK ? to_string(column[0]) : getResultCode(result));
+  column.resize(BENCH_COUNT);
+
+  // measure the column decoding of a single field
+  const SingleDataField* columnField = columnFields[5];
+  start = clockGetMicros();
+  for (int round = 0; round < BENCH_ROUNDS; round++) {
+    for (size_t row = 0; row < columnData.size(); row++) {
+      values.clear();
+      columnProgram.execute(*columnData[row], 0, &values);
+      sum += values.size();
+    }
+  }
+  referenceMicros = clockGetMicros() - start;
+  start = clockGetMicros();
+  for (int round = 0; round < BENCH_ROUNDS; round++) {
+    columnProgram.decodeColumn(columnField, columnData.data(), columnData.size(), 0, column.data());
+    sum += isnan(column[0]) ? 0 : 1;
+  }
+  micros = clockGetMicros() - start;
+  count = BENCH_ROUNDS * columnData.size();
+  cout << "  bench " << count << " column values (checksum " << sum % 1000 << "):" << endl
+       << "    telegrams/sec compiled: "
+       << (static_cast<double>(count)*1000000.0/static_cast<double>(referenceMicros))
+       << ", column: " << (static_cast<double>(count)*1000000.0/static_cast<double>(micros)) << endl;
+
+  // count the allocations on the receive path: collect the symbols, copy the parts for notification, find the
+  // message, keep the grabbed data, and store the data in the message
+  vector<symbol_t> referenceCommand, referenceResponse, referenceGrabbedMaster, referenceGrabbedSlave;
+  MasterSymbolString command, grabbedMaster;
+  SlaveSymbolString response, grabbedSlave;
+  size_t referenceAllocations = 0, allocations = 0;
+  for (int round = 0; round < 2; round++) {
+    size_t before = allocationCount;
+    for (size_t i = 0; i < BENCH_COUNT; i++) {
+      const MasterSymbolString& telegram = telegrams[i];
+      referenceCommand.clear();
+      for (size_t pos = 0; pos < telegram.size(); pos++) {
+        referenceCommand.push_back(telegram[pos]);
+      }
+      referenceResponse.clear();
+      referenceResponse.push_back(2);
+      referenceResponse.push_back((symbol_t)i);
+      referenceResponse.push_back(0);
+      const vector<symbol_t> commandCopy(referenceCommand);
+      const vector<symbol_t> responseCopy(referenceResponse);
+      Message* message = messages->find(telegram);
+      referenceGrabbedMaster = commandCopy;
+      referenceGrabbedSlave = responseCopy;
+      sum += message ? commandCopy.size() : responseCopy.size();
+    }
+    referenceAllocations = allocationCount - before;
+    before = allocationCount;
+    for (size_t i = 0; i < BENCH_COUNT; i++) {
+      const MasterSymbolString& telegram = telegrams[i];
+      command.clear();
+      for (size_t pos = 0; pos < telegram.size(); pos++) {
+        command.push_back(telegram[pos]);
+      }
+      response.clear();
+      response.push_back(2);
+      response.push_back((symbol_t)i);
+      response.push_back(0);
+      const MasterSymbolString commandCopy(command);
+      const SlaveSymbolString responseCopy(response);
+      Message* message = messages->find(commandCopy);
+      grabbedMaster = commandCopy;
+      grabbedSlave = responseCopy;
+      if (message && !message->isPassive()) {
+        message->storeLastData(commandCopy, responseCopy);
+      }
+      sum += message ? commandCopy.size() : responseCopy.size();
+    }
+    allocations = allocationCount - before;
+  }
+  cout << "  bench " << BENCH_COUNT << " received telegrams (checksum " << sum % 1000 << "):" << endl
+       << "    allocations/telegram previous: "
+       << (static_cast<double>(referenceAllocations)/static_cast<double>(BENCH_COUNT))
+       << ", now: " << (static_cast<double>(allocations)/static_cast<double>(BENCH_COUNT)) << endl;
+  verify("receive allocations", allocations == 0, "0", to_string(allocations));
+
+  // reload the definitions with and without the arena
+  uint64_t reloadMicros[2] = {0, 0};
+  size_t reloadAllocations[2] = {0, 0};
+  for (int round = 0; round < 2*BENCH_RELOADS; round++) {
+    bool useArena = round % 2 == 1;
+    size_t before = allocationCount;
+    start = clockGetMicros();
+    messages->clear();
+    istringstream reloadStream(definitions.str());
+    if (useArena) {
+      result = messages->readFromStream(&reloadStream, "bench.csv", 0, false, nullptr, &errorDescription);
+    } else {
+      result = messages->MappedFileReader::readFromStream(&reloadStream, "bench.csv", 0, false, nullptr,
+                                                          &errorDescription);
+    }
+    reloadMicros[useArena ? 1 : 0] += clockGetMicros() - start;
+    reloadAllocations[useArena ? 1 : 0] = allocationCount - before;
+    if (result != RESULT_OK) {
+      verify("reload definitions", false, "OK", getResultCode(result));
+      break;
+    }
+  }
+  cout << "  bench " << BENCH_RELOADS << " reloads of " << messages->size() << " definitions:" << endl
+       << "    allocations/reload heap: " << reloadAllocations[0] << ", arena: " << reloadAllocations[1] << endl
+       << "    reloads/sec heap: "
+       << (static_cast<double>(BENCH_RELOADS)*1000000.0/static_cast<double>(reloadMicros[0]))
+       << ", arena: " << (static_cast<double>(BENCH_RELOADS)*1000000.0/static_cast<double>(reloadMicros[1])) << endl;
+  verify("arena in use", messages->getArena()->getChunkCount() > 0, "chunks",
+         to_string(messages->getArena()->getChunkCount()));
+
+  // check the sharing of equal attributes
+  intern_stats_t loadedStats, clearedStats;
+  AttributedItem::getAttributePool()->getStats(&loadedStats);
+  cout << "  shared attributes of " << messages->size() << " definitions:" << endl
+       << "    distinct: " << loadedStats.entries << ", references: " << loadedStats.references << endl
+       << "    bytes: " << loadedStats.bytes << ", unshared: " << (loadedStats.bytes + loadedStats.savedBytes) << endl;
+  verify("attributes shared", loadedStats.savedBytes > loadedStats.bytes, "saved",
+         to_string(loadedStats.savedBytes));
+  messages->clear();
+  AttributedItem::getAttributePool()->getStats(&clearedStats);
+  verify("attributes released", clearedStats.references < loadedStats.references, "released",
+         to_string(clearedStats.references));
+  verify("arena released", messages->getArena()->getLiveCount() == 0 && messages->getArena()->getChunkCount() == 0,
+         "0", to_string(messages->getArena()->getLiveCount()));
+
+  // schedule polls by their period over one simulated hour
+  MessageMap* pollMessages = new MessageMap(false, "", false);  // the scan message data is shared
+  pollMessages->setResolver(new TestResolver());
+  pollMessages->setPollByPeriod(true);
+  istringstream pollStream(
+    "type,circuit,name,comment,qq,zz,pbsb,id,pollperiod,*name,part,type\n"
+    "r1,bai,temp,,,08,b509,0d0100,30,,s,D2C\n"
+    "r1,bai,setting,,,08,b509,0d0200,3600,,s,UCH\n"
+    "r2,bai,pressure,,,08,b509,0d0300,,,s,D2C\n"
+    "r,bai,unpolled,,,08,b509,0d0400,,,s,D2C\n"
+    "w,bai,pressure,,,08,b509,0e0300,,,m,D2C\n");
+  result = pollMessages->readFromStream(&pollStream, "poll.csv", 0, false, nullptr, &errorDescription);
+  verify("read poll definitions", result == RESULT_OK && pollMessages->sizePoll() == 3, "OK 3",
+         string(getResultCode(result)) + " " + to_string(pollMessages->sizePoll()));
+  const char* pollNames[] = {"temp", "setting", "pressure", "unpolled"};
+  map<const Message*, size_t> pollCounts;
+  time_t pollStart = 1000000, pollNow = pollStart;
+  for (; pollNow < pollStart + 3600; pollNow++) {
+    for (Message* message = pollMessages->getNextPoll(pollNow, 5); message;
+         message = pollMessages->getNextPoll(pollNow, 5)) {
+      pollCounts[message]++;
+    }
+  }
+  size_t pollExpectMin[] = {110, 1, 330, 0}, pollExpectMax[] = {130, 2, 370, 0};
+  for (size_t i = 0; i < 4; i++) {
+    size_t count = pollCounts[pollMessages->find("bai", pollNames[i], "", false)];
+    verify(string("poll count ") + pollNames[i], count >= pollExpectMin[i] && count <= pollExpectMax[i],
+           to_string(pollExpectMin[i]) + ".." + to_string(pollExpectMax[i]), to_string(count));
+  }
+  Message* budgetMessage = pollMessages->getNextPoll(pollNow, 5, true);
+  verify("poll over budget fresh", budgetMessage == nullptr, "none", budgetMessage ? budgetMessage->getName() : "");
+  budgetMessage = pollMessages->getNextPoll(pollNow + 200, 5, true);
+  verify("poll over budget stale", budgetMessage != nullptr, "message", budgetMessage ? "message" : "none");
+
+  // postpone polls while another master keeps writing the same value
+  Message* pressureRead = pollMessages->find("bai", "pressure", "", false);
+  Message* pressureWrite = pollMessages->find("bai", "pressure", "", true);
+  size_t suppressed = pollMessages->getSuppressedPollCount();
+  pollCounts.clear();
+  pollNow += 300;  // after the over budget poll above
+  for (time_t end = pollNow + 120; pollNow < end; pollNow++) {
+    pressureWrite->setLastPassiveTime(pollNow);
+    for (Message* message = pollMessages->getNextPoll(pollNow, 5); message;
+         message = pollMessages->getNextPoll(pollNow, 5)) {
+      pollCounts[message]++;
+    }
+  }
+  suppressed = pollMessages->getSuppressedPollCount() - suppressed;
+  verify("poll passive count", pollCounts[pressureRead] == 0, "0", to_string(pollCounts[pressureRead]));
+  verify("poll passive other", pollCounts[pollMessages->find("bai", "temp", "", false)] >= 3, ">=3",
+         to_string(pollCounts[pollMessages->find("bai", "temp", "", false)]));
+  verify("poll suppressed", suppressed >= 10, ">=10", to_string(suppressed));
+  delete pollMessages;
+
+  // poll a stale message over budget even when a fresh one is due first
+  pollMessages = new MessageMap(false, "", false);  // the scan message data is shared
+  pollMessages->setResolver(new TestResolver());
+  pollMessages->setPollByPeriod(true);
+  istringstream staleStream(
+    "type,circuit,name,comment,qq,zz,pbsb,id,pollperiod,maxstale,*name,part,type\n"
+    "r1,bai,fresh,,,08,b509,0d0100,30,1000,,s,UCH\n"
+    "r1,bai,stale,,,08,b509,0d0200,40,45,,s,UCH\n");
+  result = pollMessages->readFromStream(&staleStream, "stale.csv", 0, false, nullptr, &errorDescription);
+  verify("read stale definitions", result == RESULT_OK, "OK", getResultCode(result));
+  while (pollMessages->getNextPoll(pollStart, 5)) {}
+  budgetMessage = pollMessages->getNextPoll(pollStart + 50, 5, true);
+  verify("poll over budget most stale", budgetMessage && budgetMessage->getName() == "stale", "stale",
+         budgetMessage ? budgetMessage->getName() : "none");
+  SlaveSymbolString staleData;
+  staleData.parseHex("0101");
+  pollMessages->find("bai", "stale", "", false)->storeLastData(0, staleData);
+  budgetMessage = pollMessages->getNextPoll(pollStart + 100, 5, true);
+  verify("poll over budget updated", budgetMessage == nullptr, "none", budgetMessage ? budgetMessage->getName() : "");
+  delete pollMessages;
+
+  // cycle through the messages without poll period at one poll per interval by default
+  pollMessages = new MessageMap(false, "", false);  // the scan message data is shared
+  pollMessages->setResolver(new TestResolver());
+  istringstream cycleStream(
+    "type,circuit,name,comment,qq,zz,pbsb,id,pollperiod,*name,part,type\n"
+    "r1,bai,temp,,,08,b509,0d0100,,,s,D2C\n"
+    "r2,bai,pressure,,,08,b509,0d0300,,,s,D2C\n"
+    "r1,bai,setting,,,08,b509,0d0200,60,,s,UCH\n"
+    "w,bai,pressure,,,08,b509,0e0300,,,m,D2C\n");
+  result = pollMessages->readFromStream(&cycleStream, "cycle.csv", 0, false, nullptr, &errorDescription);
+  verify("read cycle definitions", result == RESULT_OK && pollMessages->sizePoll() == 3, "OK 3",
+         string(getResultCode(result)) + " " + to_string(pollMessages->sizePoll()));
+  pollCounts.clear();
+  for (pollNow = pollStart; pollNow < pollStart + 600; pollNow++) {
+    for (Message* message = pollMessages->getNextPoll(pollNow, 5); message;
+         message = pollMessages->getNextPoll(pollNow, 5)) {
+      pollCounts[message]++;
+    }
+  }
+  const char* cycleNames[] = {"temp", "pressure", "setting"};
+  size_t cycleExpectMin[] = {64, 31, 9}, cycleExpectMax[] = {69, 35, 11};
+  for (size_t i = 0; i < 3; i++) {
+    size_t count = pollCounts[pollMessages->find("bai", cycleNames[i], "", false)];
+    verify(string("poll cycle count ") + cycleNames[i], count >= cycleExpectMin[i] && count <= cycleExpectMax[i],
+           to_string(cycleExpectMin[i]) + ".." + to_string(cycleExpectMax[i]), to_string(count));
+  }
+
+  // skip the cycle slots of a message while another master keeps writing the same value
+  pressureRead = pollMessages->find("bai", "pressure", "", false);
+  pressureWrite = pollMessages->find("bai", "pressure", "", true);
+  suppressed = pollMessages->getSuppressedPollCount();
+  pollCounts.clear();
+  for (time_t end = pollNow + 120; pollNow < end; pollNow++) {
+    pressureWrite->setLastPassiveTime(pollNow);
+    for (Message* message = pollMessages->getNextPoll(pollNow, 5); message;
+         message = pollMessages->getNextPoll(pollNow, 5)) {
+      pollCounts[message]++;
+    }
+  }
+  suppressed = pollMessages->getSuppressedPollCount() - suppressed;
+  verify("poll cycle passive count", pollCounts[pressureRead] == 0, "0", to_string(pollCounts[pressureRead]));
+  verify("poll cycle passive other", pollCounts[pollMessages->find("bai", "temp", "", false)] >= 10, ">=10",
+         to_string(pollCounts[pollMessages->find("bai", "temp", "", false)]));
+  verify("poll cycle suppressed", suppressed >= 3, ">=3", to_string(suppressed));
+  delete pollMessages;
+
+  // push availability changes from the referenced message to the conditional variants
+  MessageMap* condMessages = new MessageMap(false, "", false);  // the scan message data is shared
+  condMessages->setResolver(new TestResolver());
+  istringstream condStream(
+    "type,circuit,name,comment,qq,zz,pbsb,id,*name,part,type\n"
+    "r,bai,variant,,,08,b509,0d0500,,s,UCH\n"
+    "*[gas],bai,variant,,,,1\n"
+    "*[oil],bai,variant,,,,2\n"
+    "[gas]r,bai,burner,,,08,b509,0d0600,,s,UCH\n"
+    "[oil]r,bai,burner,,,08,b509,0d0700,,s,UCH\n");
+  result = condMessages->readFromStream(&condStream, "cond.csv", 0, false, nullptr, &errorDescription);
+  if (result == RESULT_OK) {
+    result = condMessages->resolveConditions(false, &errorDescription);
+  }
+  verify("read condition definitions", result == RESULT_OK, "OK", getResultCode(result));
+  Message* variant = condMessages->find("bai", "variant", "", false);
+  deque<Message*> availability;
+  Message* noBurner = condMessages->find("bai", "burner", "", false);
+  verify("availability initial", noBurner == nullptr && !condMessages->takeAvailabilityChanged(&availability),
+         "none", noBurner ? "burner" : "event");
+  MasterSymbolString condMaster;
+  SlaveSymbolString condSlave;
+  condMaster.parseHex("1008b509030d0500");
+  condSlave.parseHex("0101");
+  variant->storeLastData(condMaster, condSlave);
+  Message* gasBurner = condMessages->find("bai", "burner", "", false);
+  condMessages->takeAvailabilityChanged(&availability);
+  verify("availability gas", gasBurner && availability.size() == 1 && availability[0] == gasBurner, "1",
+         to_string(availability.size()));
+  condSlave.clear();
+  condSlave.parseHex("0102");  // within the same second
+  variant->storeLastData(condMaster, condSlave);
+  Message* oilBurner = condMessages->find("bai", "burner", "", false);
+  availability.clear();
+  condMessages->takeAvailabilityChanged(&availability);
+  verify("availability oil", oilBurner && oilBurner != gasBurner && !gasBurner->isAvailable()
+         && availability.size() == 2, "2", to_string(availability.size()));
+  delete condMessages;
+
+  // evaluate a combined condition when all of its parts were resolved and evaluated before
+  condMessages = new MessageMap(false, "", false);  // the scan message data is shared
+  condMessages->setResolver(new TestResolver());
+  istringstream combinedStream(
+    "type,circuit,name,comment,qq,zz,pbsb,id,*name,part,type\n"
+    "r,bai,variant,,,08,b509,0d0500,,s,UCH\n"
+    "r,bai,state,,,08,b509,0d0800,,s,UCH\n"
+    "*[gas],bai,variant,,,,1\n"
+    "*[ready],bai,state,,,,1\n"
+    "[ready][gas]r,bai,flame,,,08,b509,0d0900,,s,UCH\n");
+  result = condMessages->readFromStream(&combinedStream, "combined.csv", 0, false, nullptr, &errorDescription);
+  verify("read combined definitions", result == RESULT_OK, "OK", getResultCode(result));
+  condSlave.clear();
+  condSlave.parseHex("0101");
+  condMessages->find("bai", "variant", "", false)->storeLastData(condMaster, condSlave);
+  MasterSymbolString stateMaster;
+  stateMaster.parseHex("1008b509030d0800");
+  condMessages->find("bai", "state", "", false)->storeLastData(stateMaster, condSlave);
+  result = condMessages->resolveConditions(false, &errorDescription);
+  Message* flame = condMessages->find("bai", "flame", "", false);
+  verify("availability combined", result == RESULT_OK && flame != nullptr, "flame", flame ? "flame" : "none");
+  condSlave.clear();
+  condSlave.parseHex("0100");
+  condMessages->find("bai", "state", "", false)->storeLastData(stateMaster, condSlave);
+  verify("availability combined changed", condMessages->find("bai", "flame", "", false) == nullptr, "none",
+         "flame");
+  delete condMessages;
+
+  messages->clear();
+  delete messages;
+  return error ? 1 : 0;
+}
@@ -0,0 +1,145 @@
+/*
+ * ebusd - daemon for communication with eBUS heating systems.
+ * Copyright (C) 2014-2026 John Baier <ebusd@ebusd.eu>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include "lib/ebus/protocol.h"
+
+using namespace std;
+using namespace ebusd;
+
+static bool error = false;
+
+void verify(string type, bool match, string expectStr, string gotStr) {
+  if (match) {
+    cout << "  " << type << " >" << gotStr << "< OK" << endl;
+  } else {
+    cout << "  " << type << " error: got >" << gotStr << "<, expected >" << expectStr << "<" << endl;
+    error = true;
+  }
+}
+
+class TestRequest : public BusRequest {
+ public:
+  TestRequest(const string& name, RequestClass requestClass)
+    : BusRequest(m_master, false, requestClass), m_name(name) {}
+
+  bool notify(result_t result, const SlaveSymbolString& slave) override { return false; }
+
+  const string m_name;
+
+ private:
+  MasterSymbolString m_master;
+};
+
+string getName(BusRequest* request) {
+  return request ? dynamic_cast<TestRequest*>(request)->m_name : "-";
+}
+
+static uint64_t s_testMicros = 0;
+
+uint64_t getTestMicros() {
+  return s_testMicros;
+}
+
+int main() {
+  TestRequest scan("scan", rc_scan), poll("poll", rc_poll), read1("read1", rc_read), read2("read2", rc_read),
+      write("write", rc_write), background("background", rc_background);
+  BusRequestQueue queue;
+  verify("empty", queue.peek() == nullptr, "-", getName(queue.peek()));
+  queue.push(&scan);
+  queue.push(&poll);
+  queue.push(&read1);
+  verify("peek by class", queue.peek() == &read1, "read1", getName(queue.peek()));
+  queue.push(&write);
+  verify("peek kept", queue.peek() == &read1, "read1", getName(queue.peek()));
+  verify("remove", queue.remove(&read1), "read1", "read1");
+  verify("remove again", !queue.remove(&read1), "-", "-");
+  queue.push(&read2);
+  queue.push(&background);
+  string order, expectOrder = "write,read2,poll,scan,background,";
+  BusRequest* request;
+  while ((request = queue.pop()) != nullptr) {
+    order += getName(request) + ",";
+  }
+  verify("pop order", order == expectOrder, expectOrder, order);
+  ostringstream info;
+  queue.formatInfo(&info);
+  string line = info.str().substr(0, info.str().find('\n'));
+  verify("info", line.find("queue write: 0 pending, 1 handled") == 0, "queue write: 0 pending, 1 handled", line);
+
+  // low priority requests are aged to be handled eventually while high priority ones keep coming
+  BusRequestQueue agingQueue(getTestMicros);
+  TestRequest agingPoll("poll", rc_poll), agingBackground("background", rc_background);
+  agingQueue.push(&agingBackground);
+  agingQueue.push(&agingPoll);
+  vector<TestRequest*> writes;
+  uint64_t pollMillis = 0, backgroundMillis = 0;
+  for (uint64_t millis = 0; millis <= 20*REQUEST_AGING_MILLIS && !backgroundMillis; millis += 500) {
+    s_testMicros = millis*1000;
+    TestRequest* next = new TestRequest("write", rc_write);
+    writes.push_back(next);
+    agingQueue.push(next);
+    request = agingQueue.pop();
+    if (request == &agingPoll) {
+      pollMillis = millis;
+    } else if (request == &agingBackground) {
+      backgroundMillis = millis;
+    }
+  }
+  // a request is preferred over a fresh write once its rank (class minus aging steps) gets below zero
+  uint64_t expectMillis = (rc_poll+1)*REQUEST_AGING_MILLIS;
+  verify("aging poll", pollMillis == expectMillis, to_string(expectMillis), to_string(pollMillis));
+  expectMillis = (rc_background+1)*REQUEST_AGING_MILLIS;
+  verify("aging background", backgroundMillis == expectMillis, to_string(expectMillis), to_string(backgroundMillis));
+  while ((request = agingQueue.pop()) != nullptr) {
+    verify("aging rest", request->getRequestClass() == rc_write, "write", getName(request));
+  }
+  for (auto next : writes) {
+    delete next;
+  }
+
+  // the airtime accounting of symbols and transfer results
+  AirtimeCounter airtime;
+  verify("airtime empty", airtime.isEmpty() && airtime.getSymbols() == 0, "empty", to_string(airtime.getSymbols()));
+  airtime.add(24, RESULT_OK);
+  airtime.add(10, RESULT_ERR_CRC);
+  airtime.add(8, RESULT_ERR_NAK);
+  airtime.add(4, RESULT_ERR_TIMEOUT);
+  airtime.add(2, RESULT_ERR_SYN);
+  airtime.add(0, RESULT_ERR_BUS_LOST);
+  verify("airtime symbols", !airtime.isEmpty() && airtime.getSymbols() == 48, "48", to_string(airtime.getSymbols()));
+  ostringstream airtimeOut;
+  airtime.dump(96, true, &airtimeOut);
+  string expectAirtime = "{\"symbols\":48,\"millis\":199,\"share\":50.0,\"telegrams\":1,\"crc\":1,\"nak\":1,"
+      "\"timeout\":2,\"error\":1}";
+  verify("airtime json", airtimeOut.str() == expectAirtime, expectAirtime, airtimeOut.str());
+  airtimeOut.str("");
+  airtime.dump(0, false, &airtimeOut);
+  expectAirtime = "48 symbols, 199 ms, 0.0%, 1 telegrams, 1 CRC errors, 1 NAKs, 2 timeouts, 1 errors";
+  verify("airtime text", airtimeOut.str() == expectAirtime, expectAirtime, airtimeOut.str());
+  airtime.reset();
+  airtimeOut.str("");
+  airtime.dump(96, true, &airtimeOut);
+  expectAirtime = "{\"symbols\":0,\"millis\":0,\"share\":0.0,\"telegrams\":0,\"crc\":0,\"nak\":0,\"timeout\":0,"
+      "\"error\":0}";
+  verify("airtime reset", airtime.isEmpty() && airtimeOut.str() == expectAirtime, expectAirtime, airtimeOut.str());
+
+  return error ? 1 : 0;
+}
@@ -0,0 +1,144 @@
+/*
+ * ebusd - daemon for communication with eBUS heating systems.
+ * Copyright (C) 2014-2026 John Baier <ebusd@ebusd.eu>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <pthread.h>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include "lib/utils/clock.h"
+#include "lib/utils/queue.h"
+#include "lib/utils/thread.h"
+
+using namespace std;
+using namespace ebusd;
+
+static bool error = false;
+
+void verify(string type, bool match, string expectStr, string gotStr) {
+  if (match) {
+    cout << "  " << type << " >" << gotStr << "< OK" << endl;
+  } else {
+    cout << "  " << type << " error: got >" << gotStr << "<, expected >" << expectStr << "<" << endl;
+    error = true;
+  }
+}
+
+/** the number of threads handing over items concurrently. */
+#define BENCH_THREADS 8
+
+/** the number of items handed over per thread. */
+#define BENCH_ITEMS 2000
+
+/** a work item handed over to the consumer and back to the waiting producer. */
+struct item_t {
+  /** the @a Completion for the per item hand back. */
+  Completion completion;
+};
+
+/** the hand off to the consumer thread. */
+static Queue<item_t*> s_queue;
+
+/** the bounded hand off to the consumer thread. */
+static RingQueue<item_t*> s_ringQueue(BENCH_THREADS);
+
+/** the broadcasting hand back of finished items. */
+static Queue<item_t*> s_finished;
+
+void* consumeQueue(void* arg) {
+  for (int i = 0; i < BENCH_THREADS*BENCH_ITEMS; i++) {
+    item_t* item;
+    while ((item = s_queue.pop(1)) == nullptr) {}
+    s_finished.push(item);
+  }
+  return nullptr;
+}
+
+void* produceQueue(void* arg) {
+  item_t item;
+  for (int i = 0; i < BENCH_ITEMS; i++) {
+    s_queue.push(&item);
+    s_finished.remove(&item, true);
+  }
+  return nullptr;
+}
+
+void* consumeRing(void* arg) {
+  for (int i = 0; i < BENCH_THREADS*BENCH_ITEMS; i++) {
+    item_t* item;
+    while ((item = s_ringQueue.pop(1)) == nullptr) {}
+    item->completion.complete();
+  }
+  return nullptr;
+}
+
+void* produceRing(void* arg) {
+  item_t item;
+  for (int i = 0; i < BENCH_ITEMS; i++) {
+    item.completion.reset();
+    s_ringQueue.push(&item);
+    item.completion.wait();
+  }
+  return nullptr;
+}
+
+uint64_t runBench(void* (*consumer)(void*), void* (*producer)(void*)) {
+  pthread_t consumerThread, producerThreads[BENCH_THREADS];
+  uint64_t start = clockGetMillis();
+  pthread_create(&consumerThread, nullptr, consumer, nullptr);
+  for (int i = 0; i < BENCH_THREADS; i++) {
+    pthread_create(&producerThreads[i], nullptr, producer, nullptr);
+  }
+  for (int i = 0; i < BENCH_THREADS; i++) {
+    pthread_join(producerThreads[i], nullptr);
+  }
+  pthread_join(consumerThread, nullptr);
+  return clockGetMillis() - start;
+}
+
+int main() {
+  RingQueue<int*> ring(2);
+  int values[3] = {1, 2, 3};
+  ring.push(&values[0]);
+  ring.push(&values[1]);
+  verify("ring size", ring.size() == 2, "2", to_string(ring.size()));
+  int* value = ring.pop();
+  verify("ring pop", value == &values[0], "1", value ? to_string(*value) : "-");
+  ring.push(&values[2]);
+  value = ring.pop();
+  verify("ring pop", value == &values[1], "2", value ? to_string(*value) : "-");
+  value = ring.pop();
+  verify("ring wrap", value == &values[2], "3", value ? to_string(*value) : "-");
+  verify("ring empty", ring.pop() == nullptr, "-", "-");
+  Completion completion;
+  verify("completion timeout", !completion.wait(1), "false", "false");
+  completion.complete();
+  verify("completion", completion.wait(1), "true", "true");
+
+  uint64_t queueMillis = runBench(consumeQueue, produceQueue);
+  uint64_t ringMillis = runBench(consumeRing, produceRing);
+  size_t count = BENCH_THREADS*BENCH_ITEMS;
+  cout << fixed << setprecision(1)
+       << "  bench " << BENCH_THREADS << " threads, " << count << " items:" << endl
+       << "    queue+broadcast: " << (1000.0*static_cast<double>(queueMillis)/static_cast<double>(count))
+       << " us/item, up to " << (BENCH_THREADS+1) << " wakeups/item" << endl
+       << "    ring+completion: " << (1000.0*static_cast<double>(ringMillis)/static_cast<double>(count))
+       << " us/item, " << (static_cast<double>(s_ringQueue.getWakeups())/static_cast<double>(count) + 1)
+       << " wakeups/item" << endl;
+
+  return error ? 1 : 0;
+}
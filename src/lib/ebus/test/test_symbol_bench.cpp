@@ -0,0 +1,218 @@
+/*
+ * ebusd - daemon for communication with eBUS heating systems.
+ * Copyright (C) 2014-2026 John Baier <ebusd@ebusd.eu>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include "lib/ebus/symbol.h"
+#include "lib/utils/clock.h"
+
+using namespace std;
+using namespace ebusd;
+
+static bool error = false;
+
+void verify(string type, bool match, string expectStr, string gotStr) {
+  if (match) {
+    cout << "  " << type << " >" << gotStr << "< OK" << endl;
+  } else {
+    cout << "  " << type << " error: got >" << gotStr << "<, expected >" << expectStr << "<" << endl;
+    error = true;
+  }
+}
+
+/** the number of random telegrams to compare and measure. */
+#define BENCH_COUNT 20000
+
+/** the number of rounds to measure. */
+#define BENCH_ROUNDS 10
+
+/**
+ * The previous per symbol CRC calculation for reference.
+ * @param data the unescaped symbols.
+ * @param len the number of symbols.
+ * @return the calculated CRC.
+ */
+symbol_t referenceCalcCrc(const symbol_t* data, size_t len) {
+  symbol_t crc = 0;
+  for (size_t i = 0; i < len; i++) {
+    symbol_t value = data[i];
+    if (value == ESC) {
+      SymbolString::updateCrc(ESC, &crc);
+      SymbolString::updateCrc(0x00, &crc);
+    } else if (value == SYN) {
+      SymbolString::updateCrc(ESC, &crc);
+      SymbolString::updateCrc(0x01, &crc);
+    } else {
+      SymbolString::updateCrc(value, &crc);
+    }
+  }
+  return crc;
+}
+
+/**
+ * The previous hex parsing for reference.
+ * @param str the hex string.
+ * @param output the @a SlaveSymbolString to add the symbols to.
+ * @return the result code.
+ */
+result_t referenceParseHex(const string& str, SlaveSymbolString* output) {
+  result_t result;
+  for (size_t i = 0; i < str.size(); i += 2) {
+    symbol_t value = (symbol_t)parseInt(str.substr(i, 2).c_str(), 16, 0, 0xff, &result);
+    if (result != RESULT_OK) {
+      return result;
+    }
+    output->push_back(value);
+  }
+  return RESULT_OK;
+}
+
+/**
+ * The previous hex formatting for reference.
+ * @param input the @a SlaveSymbolString to format.
+ * @return the hex string.
+ */
+string referenceGetStr(const SlaveSymbolString& input) {
+  ostringstream sstr;
+  for (size_t i = 0; i < input.size(); i++) {
+    sstr << nouppercase << setw(2) << hex << setfill('0') << static_cast<unsigned>(input[i]);
+  }
+  return sstr.str();
+}
+
+int main() {
+  static string hexStrs[BENCH_COUNT];
+  srand(1);
+  for (size_t i = 0; i < BENCH_COUNT; i++) {
+    SlaveSymbolString input;
+    size_t len = 1 + static_cast<size_t>(rand()) % 32;
+    for (size_t pos = 0; pos < len; pos++) {
+      input.push_back((symbol_t)(rand() % 8 == 0 ? ESC + rand() % 2 : rand() % 256));
+    }
+    hexStrs[i] = referenceGetStr(input);
+  }
+
+  // compare with the reference implementation
+  size_t crcDiffs = 0, parseDiffs = 0, strDiffs = 0;
+  for (size_t i = 0; i < BENCH_COUNT; i++) {
+    SlaveSymbolString parsed, expected;
+    if (parsed.parseHex(hexStrs[i]) != RESULT_OK || referenceParseHex(hexStrs[i], &expected) != RESULT_OK
+        || parsed != expected) {
+      parseDiffs++;
+    }
+    if (parsed.getStr(0, 0, true) != hexStrs[i]) {
+      strDiffs++;
+    }
+    symbol_t crc = 0;
+    SymbolString::updateCrcUnescaped(parsed.data(), parsed.size(), &crc);
+    if (crc != referenceCalcCrc(parsed.data(), parsed.size())) {
+      crcDiffs++;
+    }
+  }
+  verify("parse diffs", parseDiffs == 0, "0", to_string(parseDiffs));
+  verify("format diffs", strDiffs == 0, "0", to_string(strDiffs));
+  verify("CRC diffs", crcDiffs == 0, "0", to_string(crcDiffs));
+
+  symbol_t escaped[] = {0x10, 0xa9, 0x00, 0x20, 0xa9, 0x01, 0x30};
+  size_t len = sizeof(escaped);
+  result_t result = SymbolString::unescape(escaped, &len);
+  verify("unescape", result == RESULT_OK && len == 5 && escaped[1] == ESC && escaped[3] == SYN, "OK 5",
+      string(getResultCode(result)) + " " + to_string(len));
+  symbol_t invalid[] = {0x10, 0xa9, 0x02};
+  len = sizeof(invalid);
+  result = SymbolString::unescape(invalid, &len);
+  verify("unescape invalid", result == RESULT_ERR_ESC && len == 1, string(getResultCode(RESULT_ERR_ESC)) + " 1",
+      string(getResultCode(result)) + " " + to_string(len));
+  SlaveSymbolString odd;
+  result = odd.parseHex("12a");
+  verify("parse odd", result == RESULT_OK && odd.getStr(0, 0, true) == "120a", "120a", odd.getStr(0, 0, true));
+  SlaveSymbolString bad;
+  result = bad.parseHex("12zz");
+  verify("parse invalid", result == RESULT_ERR_INVALID_NUM, getResultCode(RESULT_ERR_INVALID_NUM),
+      getResultCode(result));
+
+  // beyond the inline capacity
+  MasterSymbolString longStr;
+  longStr.parseHex(hexStrs[0] + hexStrs[1] + hexStrs[2] + "00112233445566778899aabbccddeeff00112233");
+  MasterSymbolString longCopy(longStr);
+  MasterSymbolString longMoved(std::move(longCopy));
+  MasterSymbolString longAssigned;
+  longAssigned.parseHex("10");
+  longAssigned = longMoved;
+  verify("long copy", longStr.size() > SYMBOL_INLINE_SIZE && longMoved == longStr && longAssigned == longStr
+      && longCopy.size() == 0, longStr.getStr(), longAssigned.getStr());
+  longAssigned = std::move(longMoved);
+  longMoved = longStr;
+  longMoved.push_back(0x42);
+  verify("long move", longAssigned == longStr && longMoved.size() == longStr.size() + 1
+      && longMoved[longStr.size()] == 0x42, longStr.getStr(), longAssigned.getStr());
+
+  // measure
+  uint64_t start = clockGetMillis();
+  size_t sum = 0;
+  for (int round = 0; round < BENCH_ROUNDS; round++) {
+    for (size_t i = 0; i < BENCH_COUNT; i++) {
+      SlaveSymbolString parsed;
+      referenceParseHex(hexStrs[i], &parsed);
+      sum += referenceCalcCrc(parsed.data(), parsed.size()) + referenceGetStr(parsed).size();
+    }
+  }
+  uint64_t referenceMillis = clockGetMillis() - start;
+  start = clockGetMillis();
+  for (int round = 0; round < BENCH_ROUNDS; round++) {
+    for (size_t i = 0; i < BENCH_COUNT; i++) {
+      SlaveSymbolString parsed;
+      parsed.parseHex(hexStrs[i]);
+      symbol_t crc = 0;
+      SymbolString::updateCrcUnescaped(parsed.data(), parsed.size(), &crc);
+      sum += crc + parsed.getStr(0, 0, true).size();
+    }
+  }
+  uint64_t millis = clockGetMillis() - start;
+  start = clockGetMillis();
+  for (int round = 0; round < BENCH_ROUNDS; round++) {
+    for (size_t i = 0; i < BENCH_COUNT; i++) {
+      const string& str = hexStrs[i];
+      sum += referenceCalcCrc(reinterpret_cast<const symbol_t*>(str.data()), str.size());
+    }
+  }
+  uint64_t referenceCrcMillis = clockGetMillis() - start;
+  start = clockGetMillis();
+  for (int round = 0; round < BENCH_ROUNDS; round++) {
+    for (size_t i = 0; i < BENCH_COUNT; i++) {
+      const string& str = hexStrs[i];
+      symbol_t crc = 0;
+      SymbolString::updateCrcUnescaped(reinterpret_cast<const symbol_t*>(str.data()), str.size(), &crc);
+      sum += crc;
+    }
+  }
+  uint64_t crcMillis = clockGetMillis() - start;
+  size_t count = BENCH_COUNT*BENCH_ROUNDS;
+  cout << fixed << setprecision(3)
+       << "  bench " << count << " telegrams (checksum " << sum % 1000 << "):" << endl
+       << "    parse+CRC+format previous: " << (1000.0*static_cast<double>(referenceMillis)/static_cast<double>(count))
+       << " us/telegram, now: " << (1000.0*static_cast<double>(millis)/static_cast<double>(count)) << " us/telegram"
+       << endl
+       << "    CRC previous: " << (1000.0*static_cast<double>(referenceCrcMillis)/static_cast<double>(count))
+       << " us/telegram, now: " << (1000.0*static_cast<double>(crcMillis)/static_cast<double>(count))
+       << " us/telegram" << endl;
+
+  return error ? 1 : 0;
+}
@@ -0,0 +1,180 @@
+/*
+ * ebusd - daemon for communication with eBUS heating systems.
+ * Copyright (C) 2026 John Baier <ebusd@ebusd.eu>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <unistd.h>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "lib/ebus/protocol.h"
+#include "lib/utils/clock.h"
+
+using namespace std;
+using namespace ebusd;
+
+static bool error = false;
+
+void verify(string type, bool match, string expectStr, string gotStr) {
+  if (match) {
+    cout << "  " << type << " >" << gotStr << "< OK" << endl;
+  } else {
+    cout << "  " << type << " error: got >" << gotStr << "<, expected >" << expectStr << "<" << endl;
+    error = true;
+  }
+}
+
+class TestListener : public ProtocolListener {
+ public:
+  void notifyProtocolStatus(ProtocolState state, result_t result) override {}
+
+  void notifyProtocolSeenAddress(symbol_t address) override {}
+
+  void notifyProtocolMessage(MessageDirection direction, const MasterSymbolString& master,
+      const SlaveSymbolString& slave) override {
+    m_mutex.lock();
+    m_messages.push_back(master.getStr() + "/" + slave.getStr());
+    m_mutex.unlock();
+  }
+
+  void notifyProtocolTransfer(const MasterSymbolString& master, unsigned int symbols, result_t result) override {
+    m_mutex.lock();
+    m_symbols += symbols;
+    m_mutex.unlock();
+  }
+
+  /**
+   * Get the notified messages.
+   * @return the notified messages as "master/slave" hex strings.
+   */
+  vector<string> getMessages() {
+    m_mutex.lock();
+    vector<string> messages = m_messages;
+    m_mutex.unlock();
+    return messages;
+  }
+
+  /** the number of symbols notified with transfers. */
+  unsigned int m_symbols = 0;
+
+ private:
+  Mutex m_mutex;
+
+  vector<string> m_messages;
+};
+
+/**
+ * Append the values followed by their CRC.
+ * @param hex the unescaped values as hex string.
+ * @param output the vector to append the values and CRC to.
+ */
+void appendWithCrc(const string& hex, vector<symbol_t>* output) {
+  symbol_t crc = 0;
+  for (size_t pos = 0; pos < hex.length(); pos += 2) {
+    symbol_t value = (symbol_t)strtoul(hex.substr(pos, 2).c_str(), nullptr, 16);
+    SymbolString::updateCrcUnescaped(&value, 1, &crc);
+    output->push_back(value);
+  }
+  output->push_back(crc);
+}
+
+/**
+ * Run a read-only protocol handler on the device until the expected number of messages was notified.
+ * @param device the device string.
+ * @param count the number of messages to wait for.
+ * @param listener the @a TestListener to notify.
+ * @return the notified messages.
+ */
+vector<string> runProtocol(const string& device, size_t count, TestListener* listener) {
+  ebus_protocol_config_t config = {};
+  config.device = device.c_str();
+  config.noDeviceCheck = true;
+  config.readOnly = true;
+  config.ownAddress = 0x31;
+  config.busLostRetries = 2;
+  config.failedSendRetries = 2;
+  config.busAcquireTimeout = 10;
+  config.slaveRecvTimeout = SLAVE_RECV_TIMEOUT;
+  ProtocolHandler* handler = ProtocolHandler::create(config, listener);
+  vector<string> messages;
+  if (!handler) {
+    return messages;
+  }
+  if (handler->open() == RESULT_OK && handler->start("test")) {
+    uint64_t until = clockGetMillis() + 5000;
+    while ((messages = listener->getMessages()).size() < count && clockGetMillis() < until) {
+      usleep(10000);
+    }
+    handler->stop();
+  }
+  delete handler;
+  return messages;
+}
+
+int main() {
+  // the recorded telegrams: an identification query with response and a broadcast
+  string query = "1015070400", response = "0ab5564149303001248901", broadcast = "10fe0716020005";
+  vector<symbol_t> dump = {SYN, SYN};
+  appendWithCrc(query, &dump);
+  dump.push_back(ACK);
+  appendWithCrc(response, &dump);
+  dump.push_back(ACK);
+  dump.push_back(SYN);
+  appendWithCrc(broadcast, &dump);
+  dump.push_back(SYN);
+  dump.push_back(SYN);
+  char dumpPath[] = "/tmp/ebusd_test_replay_XXXXXX";
+  int fd = mkstemp(dumpPath);
+  bool written = fd >= 0 && write(fd, dump.data(), dump.size()) == static_cast<ssize_t>(dump.size());
+  if (fd >= 0) {
+    close(fd);
+  }
+  verify("replay file", written, "written", written ? "written" : "not written");
+
+  // replay the recorded file at maximum speed
+  TestListener replayListener;
+  vector<string> messages = runProtocol(string("replay@0:") + dumpPath, 2, &replayListener);
+  unlink(dumpPath);
+  string expect = query + "/" + response + "," + broadcast + "/,";
+  string got;
+  for (const auto& message : messages) {
+    got += message + ",";
+  }
+  verify("replay messages", got == expect, expect, got);
+  verify("replay symbols", replayListener.m_symbols >= dump.size() - 5, ">=" + to_string(dump.size() - 5),
+      to_string(replayListener.m_symbols));
+
+  // let a virtual master query a virtual slave in the simulator
+  char profilePath[] = "/tmp/ebusd_test_sim_XXXXXX";
+  fd = mkstemp(profilePath);
+  string profile = "seed,1\nmaster,10,15070400,20\nslave,15\nanswer,15,070400," + response.substr(2) + "\n";
+  written = fd >= 0 && write(fd, profile.c_str(), profile.length()) == static_cast<ssize_t>(profile.length());
+  if (fd >= 0) {
+    close(fd);
+  }
+  verify("sim profile", written, "written", written ? "written" : "not written");
+  TestListener simListener;
+  messages = runProtocol(string("sim:") + profilePath, 2, &simListener);
+  unlink(profilePath);
+  expect = query + "/" + response;
+  got = messages.size() >= 2 ? messages[0] + "," + messages[1] : to_string(messages.size());
+  verify("sim messages", messages.size() >= 2 && messages[0] == expect && messages[1] == expect, expect + "," + expect,
+      got);
+
+  return error ? 1 : 0;
+}
@@ -24,6 +24,7 @@
 #include <fcntl.h>
 #include <sys/ioctl.h>
 #include <sys/file.h>
+#include <sys/stat.h>
 #ifdef HAVE_LINUX_SERIAL
 #  include <linux/serial.h>
 #endif
@@ -35,9 +36,6 @@
 #endif
 #include "lib/ebus/data.h"
 #include "lib/utils/tcpsocket.h"
-#ifdef DEBUG_RAW_TRAFFIC
-#  include "lib/utils/clock.h"
-#endif
 
 namespace ebusd {
 
@@ -205,7 +203,11 @@ result_t FileTransport::read(unsigned int timeout, const uint8_t** data, size_t*
     }
   }
   // fill up the buffer
-  ssize_t size = ::read(m_fd, m_buffer + m_bufLen, m_bufSize - m_bufLen);
+  size_t maxSize = limitRead(m_bufSize - m_bufLen);
+  if (maxSize == 0) {
+    return RESULT_ERR_TIMEOUT;
+  }
+  ssize_t size = ::read(m_fd, m_buffer + m_bufLen, maxSize);
   if (size <= 0) {
     return RESULT_ERR_TIMEOUT;
   }
@@ -357,4 +359,87 @@ void NetworkTransport::checkDevice() {
   }
 }
 
+
+
+string ReplayTransport::getTransportInfo() const {
+  if (m_speed <= 0) {
+    return "replay max speed";
+  }
+  if (m_speed == 1) {
+    return "replay";
+  }
+  ostringstream ostr;
+  ostr << "replay " << m_speed << "x speed";
+  return ostr.str();
+}
+
+result_t ReplayTransport::openInternal() {
+  m_fd = ::open(m_path, O_RDONLY | O_NOCTTY | O_CLOEXEC);
+  if (m_fd < 0) {
+    return RESULT_ERR_NOTFOUND;
+  }
+  m_startTime = clockGetMillis();
+  m_busMillis = 0;
+  m_lastSymbol = SYN;
+  m_finished = false;
+  return RESULT_OK;
+}
+
+result_t ReplayTransport::read(unsigned int timeout, const uint8_t** data, size_t* len) {
+  if (timeout == 0 || !isValid()) {
+    return FileTransport::read(timeout, data, len);
+  }
+  result_t result = FileTransport::read(0, data, len);
+  if (result == RESULT_OK) {
+    return result;  // still buffered
+  }
+  uint64_t until = clockGetMillis() + timeout;
+  while (true) {
+    symbol_t next;
+    if (pread(m_fd, &next, 1, lseek(m_fd, 0, SEEK_CUR)) <= 0) {
+      if (!m_finished) {
+        m_finished = true;
+        if (m_listener != nullptr) {
+          m_listener->notifyTransportMessage(false, "replay finished");
+        }
+      }
+      usleep(timeout * 1000);
+      return RESULT_ERR_TIMEOUT;
+    }
+    if (m_speed <= 0) {
+      break;
+    }
+    double waitMillis = (m_busMillis + getSymbolMillis(next, m_lastSymbol) - getElapsedBusMillis()) / m_speed;
+    if (waitMillis <= 0) {
+      break;
+    }
+    uint64_t now = clockGetMillis();
+    if (now >= until) {
+      return RESULT_ERR_TIMEOUT;
+    }
+    uint64_t wait = static_cast<uint64_t>(waitMillis) + 1;
+    usleep(static_cast<useconds_t>((wait < until - now ? wait : until - now) * 1000));
+  }
+  return FileTransport::read(timeout, data, len);
+}
+
+size_t ReplayTransport::limitRead(size_t size) {
+  if (m_speed <= 0) {
+    return size;
+  }
+  symbol_t next[256];
+  ssize_t got = pread(m_fd, next, size < sizeof(next) ? size : sizeof(next), lseek(m_fd, 0, SEEK_CUR));
+  double elapsed = getElapsedBusMillis();
+  size_t count = 0;
+  for (; count < static_cast<size_t>(got > 0 ? got : 0); count++) {
+    double millis = getSymbolMillis(next[count], m_lastSymbol);
+    if (m_busMillis + millis > elapsed) {
+      break;
+    }
+    m_busMillis += millis;
+    m_lastSymbol = next[count];
+  }
+  return count;
+}
+
 }  // namespace ebusd
@@ -25,6 +25,7 @@
 #include <string>
 #include "lib/ebus/result.h"
 #include "lib/ebus/symbol.h"
+#include "lib/utils/clock.h"
 
 namespace ebusd {
 
@@ -32,13 +33,19 @@ namespace ebusd {
  * Classes for low level transport to/from the eBUS device.
  *
  * A @a Transport is either a @a SerialTransport directly connected
- * to a local tty port or a remote @a NetworkTransport handled via a
- * socket.
+ * to a local tty port, a remote @a NetworkTransport handled via a
+ * socket, or a @a ReplayTransport playing a previously dumped file.
  */
 
 /** the transfer latency of the network device [ms]. */
 #define NETWORK_LATENCY_MS 30
 
+/** the nominal duration [ms] of a single symbol on the bus (2400 Baud with start and stop bit) for replaying. */
+#define REPLAY_SYMBOL_MILLIS (10*1000.0/2400)
+
+/** the idle time [ms] on the bus before an AUTO-SYN symbol following another SYN symbol for replaying. */
+#define REPLAY_AUTO_SYN_IDLE_MILLIS 40
+
 /** the latency of the host [ms]. */
 #if defined(__CYGWIN__) || defined(_WIN32)
 #define HOST_LATENCY_MS 20
@@ -216,6 +223,13 @@ class FileTransport : public Transport {
    */
   virtual void checkDevice() = 0;  // abstract
 
+  /**
+   * Limit the number of bytes to read from the file descriptor at once.
+   * @param size the number of bytes that fit into the receive buffer.
+   * @return the maximum number of bytes to read now, or 0 to read nothing.
+   */
+  virtual size_t limitRead(size_t size) { return size; }
+
   /** whether to regularly check the device availability. */
   const bool m_checkDevice;
 
@@ -330,6 +344,91 @@ class NetworkTransport : public FileTransport {
   const bool m_udp;
 };
 
+
+/**
+ * The @a Transport for replaying a file of received symbols previously dumped by @a ProtocolHandler (read only).
+ */
+class ReplayTransport : public FileTransport {
+ public:
+  /**
+   * Construct a new instance.
+   * @param name the device name (e.g. "replay:/tmp/ebus_dump.bin").
+   * @param path the path to the dump file.
+   * @param speed the factor for the nominal bus speed to replay with, or 0 for maximum speed.
+   */
+  ReplayTransport(const char* name, const char* path, double speed)
+    : FileTransport(name, 0, false), m_path(path), m_speed(speed), m_startTime(0), m_busMillis(0),
+    m_lastSymbol(SYN), m_finished(false) {}
+
+  /**
+   * Destructor.
+   */
+  ~ReplayTransport() override {
+    if (m_path) {
+      free(const_cast<char*>(m_path));
+      m_path = nullptr;
+    }
+  }
+
+  // @copydoc
+  string getTransportInfo() const override;
+
+  // @copydoc
+  result_t openInternal() override;
+
+  // @copydoc
+  result_t write(const uint8_t* data, size_t len) override { return RESULT_ERR_SEND; }
+
+  // @copydoc
+  result_t read(unsigned int timeout, const uint8_t** data, size_t* len) override;
+
+
+ protected:
+  // @copydoc
+  void checkDevice() override {}
+
+  // @copydoc
+  size_t limitRead(size_t size) override;
+
+
+ private:
+  /**
+   * Get the bus time needed for the symbol following the previously replayed one.
+   * @param symbol the symbol.
+   * @param previous the previously replayed symbol.
+   * @return the bus time in milliseconds.
+   */
+  static double getSymbolMillis(symbol_t symbol, symbol_t previous) {
+    return symbol == SYN && previous == SYN ? REPLAY_AUTO_SYN_IDLE_MILLIS + REPLAY_SYMBOL_MILLIS
+      : REPLAY_SYMBOL_MILLIS;
+  }
+
+  /**
+   * @return the bus time in milliseconds passed since the start of the replay (scaled by the speed).
+   */
+  double getElapsedBusMillis() const {
+    return static_cast<double>(clockGetMillis() - m_startTime) * m_speed;
+  }
+
+  /** the path to the dump file. */
+  const char* m_path;
+
+  /** the factor for the nominal bus speed to replay with, or 0 for maximum speed. */
+  const double m_speed;
+
+  /** the system time in milliseconds when the replay was started. */
+  uint64_t m_startTime;
+
+  /** the bus time in milliseconds of all symbols read from the dump file so far. */
+  double m_busMillis;
+
+  /** the last symbol read from the dump file. */
+  symbol_t m_lastSymbol;
+
+  /** whether the end of the dump file was reached. */
+  bool m_finished;
+};
+
 }  // namespace ebusd
 
 #endif  // LIB_EBUS_TRANSPORT_H_
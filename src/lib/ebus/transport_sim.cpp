@@ -0,0 +1,587 @@
+/*
+ * ebusd - daemon for communication with eBUS heating systems.
+ * Copyright (C) 2026 John Baier <ebusd@ebusd.eu>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include <config.h>
+#endif
+
+#include "lib/ebus/transport_sim.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include "lib/ebus/filereader.h"
+
+namespace ebusd {
+
+/** the maximum number of received symbols to keep for ebusd. */
+#define MAX_RECEIVED 256
+
+/**
+ * Parse a string of hex digits.
+ * @param str the string to parse.
+ * @param values the vector to append the parsed values to.
+ * @return the @a result_t code.
+ */
+static result_t parseHexValues(const string& str, vector<symbol_t>* values) {
+  if (str.length() % 2 != 0) {
+    return RESULT_ERR_INVALID_NUM;
+  }
+  for (size_t pos = 0; pos < str.length(); pos += 2) {
+    result_t result = RESULT_OK;
+    values->push_back((symbol_t)parseInt(str.substr(pos, 2).c_str(), 16, 0, 0xff, &result));
+    if (result != RESULT_OK) {
+      return result;
+    }
+  }
+  return RESULT_OK;
+}
+
+/**
+ * Append the unescaped values in escaped form followed by the escaped CRC.
+ * @param values the unescaped values.
+ * @param crcPrefix the unescaped value preceding the values to include in the CRC, or @a SYN for none.
+ * @param escaped the vector to append the escaped values to.
+ */
+static void appendEscaped(const vector<symbol_t>& values, symbol_t crcPrefix, vector<symbol_t>* escaped) {
+  symbol_t crc = 0;
+  if (crcPrefix != SYN) {
+    SymbolString::updateCrcUnescaped(&crcPrefix, 1, &crc);
+  }
+  SymbolString::updateCrcUnescaped(values.data(), values.size(), &crc);
+  for (size_t pos = 0; pos <= values.size(); pos++) {
+    symbol_t value = pos < values.size() ? values[pos] : crc;
+    if (value == ESC || value == SYN) {
+      escaped->push_back(ESC);
+      escaped->push_back(value == ESC ? 0x00 : 0x01);
+    } else {
+      escaped->push_back(value);
+    }
+  }
+}
+
+/**
+ * Determine whether the first symbol wins the bitwise arbitration against the second one.
+ * @param symbol the symbol to check.
+ * @param other the other symbol sent at the same time.
+ * @return true when @a symbol wins against @a other.
+ */
+static bool winsArbitration(symbol_t symbol, symbol_t other) {
+  // the bits are sent LSB first and the first 0 bit on the bus wins
+  symbol_t diff = (symbol_t)(symbol ^ other);
+  return diff != 0 && (symbol & (diff & -diff)) == 0;
+}
+
+string SimulatorTransport::getTransportInfo() const {
+  ostringstream ostr;
+  ostr << "simulator " << m_masters.size() << " masters, " << m_slaves.size() << " slaves";
+  if (m_slots > 0) {
+    char load[8];
+    snprintf(load, sizeof(load), "%.1f", static_cast<double>(m_busySlots) * 100.0 / static_cast<double>(m_slots));
+    ostr << ", load " << load << "%, " << m_telegrams << " telegrams, " << m_collisions << " collisions, "
+         << m_naks << " NAKs";
+  }
+  return ostr.str();
+}
+
+result_t SimulatorTransport::open() {
+  close();
+  result_t result = openInternal();
+  if (m_listener != nullptr && result == RESULT_OK) {
+    result = m_listener->notifyTransportStatus(true);
+  }
+  if (result != RESULT_OK) {
+    close();
+  }
+  return result;
+}
+
+void SimulatorTransport::close() {
+  if (!m_opened) {
+    return;
+  }
+  m_opened = false;
+  m_written.clear();
+  m_scheduled.clear();
+  m_received.clear();
+  if (m_listener != nullptr) {
+    m_listener->notifyTransportStatus(false);
+  }
+}
+
+result_t SimulatorTransport::openInternal() {
+  string errorDescription;
+  result_t result = readProfile(&errorDescription);
+  if (result != RESULT_OK) {
+    if (m_listener != nullptr) {
+      m_listener->notifyTransportMessage(true, errorDescription.c_str());
+    }
+    return result;
+  }
+  clockGettime(&m_startTime);
+  m_busMillis = m_idleMillis = 0;
+  m_nextStatsMillis = SIMULATOR_STATS_MILLIS;
+  m_state = ss_idle;
+  m_firstSlot = m_escape = m_repeat = false;
+  m_sender = -1;
+  m_slots = m_busySlots = 0;
+  m_collisions = m_telegrams = m_naks = 0;
+  for (auto& master : m_masters) {
+    master.due = -log(1 - getRandom()) * master.interval;
+  }
+  m_opened = true;
+  return RESULT_OK;
+}
+
+result_t SimulatorTransport::readProfile(string* errorDescription) {
+  istream* stream = FileReader::openFile(m_path, errorDescription);
+  if (!stream) {
+    return RESULT_ERR_NOTFOUND;
+  }
+  m_masters.clear();
+  m_slaves.clear();
+  m_nakPercent = 0;
+  m_seed = 1;
+  vector<string> row;
+  unsigned int lineNo = 0;
+  result_t result = RESULT_OK;
+  string error;
+  while (result == RESULT_OK && FileReader::splitFields(stream, &row, &lineNo)) {
+    if (row.empty()) {
+      continue;
+    }
+    const string& type = row[0];
+    symbol_t address = SYN;
+    if (row.size() > 1 && type != "nak" && type != "seed") {
+      address = (symbol_t)parseInt(row[1].c_str(), 16, 0, 0xff, &result);
+      if (result == RESULT_OK && !isValidAddress(address, false)) {
+        result = RESULT_ERR_INVALID_ADDR;
+      }
+      if (result != RESULT_OK) {
+        error = "invalid address";
+        break;
+      }
+    }
+    if (type == "master" && row.size() == 4) {
+      vector<symbol_t> command;
+      result = parseHexValues(row[2], &command);
+      if (result != RESULT_OK || command.size() < 4 || command.size() != 4u + command[3]
+          || !isMaster(address) || !isValidAddress(command[0])) {
+        result = RESULT_ERR_INVALID_ARG;
+        error = "invalid command";
+        break;
+      }
+      double rate = strtod(row[3].c_str(), nullptr);
+      if (rate <= 0) {
+        result = RESULT_ERR_INVALID_NUM;
+        error = "invalid rate";
+        break;
+      }
+      SimMaster master;
+      master.address = address;
+      appendEscaped(command, address, &master.command);
+      master.interval = 1000.0 / rate;
+      master.due = 0;
+      m_masters.push_back(master);
+    } else if (type == "slave" && (row.size() == 2 || row.size() == 3)) {
+      unsigned int len = row.size() == 3 ? parseInt(row[2].c_str(), 10, 0, 16, &result) : 0;
+      if (result != RESULT_OK || isMaster(address)) {
+        result = RESULT_ERR_INVALID_ARG;
+        error = "invalid slave";
+        break;
+      }
+      vector<symbol_t> response(1+len, 0);
+      response[0] = (symbol_t)len;
+      SimSlave& slave = m_slaves[address];
+      slave.response.clear();
+      appendEscaped(response, SYN, &slave.response);
+    } else if (type == "answer" && row.size() == 4) {
+      vector<symbol_t> prefix, response;
+      response.push_back(0);
+      result = parseHexValues(row[2], &prefix);
+      if (result == RESULT_OK) {
+        result = parseHexValues(row[3], &response);
+      }
+      auto it = m_slaves.find(address);
+      if (result != RESULT_OK || it == m_slaves.end() || response.size() > 17) {
+        result = RESULT_ERR_INVALID_ARG;
+        error = "invalid answer";
+        break;
+      }
+      response[0] = (symbol_t)(response.size() - 1);
+      vector<symbol_t> escaped;
+      appendEscaped(response, SYN, &escaped);
+      it->second.answers.push_back(std::make_pair(prefix, escaped));
+    } else if (type == "nak" && row.size() == 2) {
+      m_nakPercent = parseInt(row[1].c_str(), 10, 0, 100, &result);
+      if (result != RESULT_OK) {
+        error = "invalid percentage";
+      }
+    } else if (type == "seed" && row.size() == 2) {
+      m_seed = parseInt(row[1].c_str(), 10, 0, 0xffffffff, &result);
+      if (result != RESULT_OK) {
+        error = "invalid seed";
+      }
+    } else {
+      result = RESULT_ERR_INVALID_ARG;
+      error = "invalid line";
+    }
+  }
+  delete stream;
+  if (result != RESULT_OK) {
+    return FileReader::formatError(m_path, lineNo, result, error, errorDescription);
+  }
+  return RESULT_OK;
+}
+
+double SimulatorTransport::getElapsedBusMillis() const {
+  struct timespec now;
+  clockGettime(&now);
+  return static_cast<double>(now.tv_sec - m_startTime.tv_sec) * 1000.0
+    + static_cast<double>(now.tv_nsec - m_startTime.tv_nsec) / 1000000.0;
+}
+
+double SimulatorTransport::getRandom() {
+  return static_cast<double>(rand_r(&m_seed)) / (static_cast<double>(RAND_MAX) + 1.0);
+}
+
+bool SimulatorTransport::isNak(bool crcValid) {
+  return !crcValid || (m_nakPercent > 0 && getRandom() * 100 < m_nakPercent);
+}
+
+result_t SimulatorTransport::write(const uint8_t* data, size_t len) {
+  if (!m_opened) {
+    return RESULT_ERR_DEVICE;
+  }
+  m_written.insert(m_written.end(), data, data + len);
+  return RESULT_OK;
+}
+
+result_t SimulatorTransport::read(unsigned int timeout, const uint8_t** data, size_t* len) {
+  if (!m_opened) {
+    return RESULT_ERR_DEVICE;
+  }
+  if (m_received.empty() && timeout > 0) {
+    double until = getElapsedBusMillis() + timeout;
+    while (true) {
+      simulate();
+      if (!m_received.empty()) {
+        break;
+      }
+      double elapsed = getElapsedBusMillis();
+      if (elapsed >= until) {
+        break;
+      }
+      double wait = m_busMillis + REPLAY_SYMBOL_MILLIS - elapsed;
+      if (wait > until - elapsed) {
+        wait = until - elapsed;
+      }
+      usleep(static_cast<useconds_t>(wait * 1000) + 1);
+    }
+  }
+  if (m_received.empty()) {
+    return RESULT_ERR_TIMEOUT;
+  }
+  *data = m_received.data();
+  *len = m_received.size();
+  return RESULT_OK;
+}
+
+void SimulatorTransport::readConsumed(size_t len) {
+  if (len >= m_received.size()) {
+    m_received.clear();
+  } else if (len > 0) {
+    m_received.erase(m_received.begin(), m_received.begin() + static_cast<ssize_t>(len));
+  }
+}
+
+void SimulatorTransport::simulate() {
+  double elapsed = getElapsedBusMillis();
+  while (m_busMillis + REPLAY_SYMBOL_MILLIS <= elapsed) {
+    simulateSlot();
+  }
+  if (m_received.size() > MAX_RECEIVED) {
+    // ebusd is too slow
+    m_received.clear();
+    if (m_listener != nullptr) {
+      m_listener->notifyTransportMessage(true, "buffer overflow");
+    }
+  }
+  if (m_busMillis >= m_nextStatsMillis) {
+    m_nextStatsMillis += SIMULATOR_STATS_MILLIS;
+    if (m_listener != nullptr) {
+      m_listener->notifyTransportMessage(false, getTransportInfo().c_str());
+    }
+  }
+}
+
+void SimulatorTransport::simulateSlot() {
+  m_slots++;
+  bool found = !m_written.empty();
+  symbol_t value = SYN;
+  if (found) {
+    value = m_written.front();
+    m_written.pop_front();
+  }
+  if (m_state == ss_ready && m_firstSlot) {
+    // arbitration of all due masters
+    size_t participants = found ? 1 : 0;
+    int winner = -1;
+    for (size_t idx = 0; idx < m_masters.size(); idx++) {
+      const SimMaster& master = m_masters[idx];
+      if (master.due > m_busMillis) {
+        continue;
+      }
+      participants++;
+      if (!found || winsArbitration(master.address, value)) {
+        value = master.address;
+        winner = static_cast<int>(idx);
+        found = true;
+      }
+    }
+    if (participants > 1) {
+      m_collisions++;
+    }
+    if (winner >= 0) {
+      SimMaster& master = m_masters[winner];
+      m_scheduled.insert(m_scheduled.end(), master.command.begin(), master.command.end());
+      master.due = m_busMillis - log(1 - getRandom()) * master.interval;
+      m_sender = winner;
+    }
+  } else if (!m_scheduled.empty()) {
+    symbol_t scheduled = m_scheduled.front();
+    m_scheduled.pop_front();
+    if (found) {
+      // wired AND of both senders, the virtual participant stops on a mismatch
+      m_collisions++;
+      value &= scheduled;
+      if (value != scheduled) {
+        m_scheduled.clear();
+      }
+    } else {
+      value = scheduled;
+      found = true;
+    }
+  }
+  bool autoSyn = false;
+  if (!found && m_idleMillis + REPLAY_SYMBOL_MILLIS >= REPLAY_AUTO_SYN_IDLE_MILLIS) {
+    value = SYN;
+    found = autoSyn = true;
+  }
+  m_busMillis += REPLAY_SYMBOL_MILLIS;
+  m_firstSlot = false;
+  if (!found) {
+    m_idleMillis += REPLAY_SYMBOL_MILLIS;
+    return;
+  }
+  m_idleMillis = 0;
+  if (!autoSyn) {
+    m_busySlots++;
+  }
+  m_received.push_back(value);
+  track(value);
+}
+
+void SimulatorTransport::track(symbol_t symbol) {
+  if (symbol == SYN) {
+    m_state = ss_ready;
+    m_firstSlot = true;
+    m_escape = false;
+    m_crc = 0;
+    m_part.clear();
+    m_scheduled.clear();
+    m_sender = -1;
+    return;
+  }
+  switch (m_state) {
+  case ss_ready:
+  case ss_command:
+  case ss_response:
+    SymbolString::updateCrc(symbol, &m_crc);
+    break;
+  default:
+    break;
+  }
+  switch (m_state) {
+  case ss_ready:
+  case ss_command:
+  case ss_commandCrc:
+  case ss_response:
+  case ss_responseCrc:
+    if (m_escape) {
+      m_escape = false;
+      if (symbol > 0x01) {
+        m_state = ss_idle;
+        return;
+      }
+      symbol = symbol == 0x00 ? ESC : SYN;
+    } else if (symbol == ESC) {
+      m_escape = true;
+      return;
+    }
+    break;
+  default:
+    break;
+  }
+
+  switch (m_state) {
+  case ss_idle:
+    return;
+
+  case ss_ready:
+    m_part.push_back(symbol);
+    m_repeat = false;
+    m_state = ss_command;
+    return;
+
+  case ss_command:
+    m_part.push_back(symbol);
+    if (m_part.size() < 5 || m_part.size() < 5u + m_part[4]) {
+      return;
+    }
+    m_state = ss_commandCrc;
+    m_targetVirtual = false;
+    m_targetResponse.clear();
+    if (isMaster(m_part[1])) {
+      for (const auto& master : m_masters) {
+        if (master.address == m_part[1]) {
+          m_targetVirtual = true;
+          break;
+        }
+      }
+    } else {
+      const auto it = m_slaves.find(m_part[1]);
+      if (it != m_slaves.end()) {
+        m_targetVirtual = true;
+        m_targetResponse = it->second.response;
+        for (const auto& answer : it->second.answers) {
+          const vector<symbol_t>& prefix = answer.first;
+          if (prefix.size() <= m_part.size() - 2 && equal(prefix.begin(), prefix.end(), m_part.begin() + 2)) {
+            m_targetResponse = answer.second;
+            break;
+          }
+        }
+      }
+    }
+    return;
+
+  case ss_commandCrc:
+    m_crcValid = symbol == m_crc;
+    if (m_part[1] == BROADCAST) {
+      if (m_crcValid) {
+        m_telegrams++;
+      }
+      m_state = ss_syn;
+      if (m_sender >= 0) {
+        m_scheduled.push_back(SYN);
+      }
+      return;
+    }
+    m_state = ss_commandAck;
+    if (m_targetVirtual) {
+      m_scheduled.push_back(isNak(m_crcValid) ? NAK : ACK);
+    }
+    return;
+
+  case ss_commandAck:
+    if (symbol == ACK) {
+      if (isMaster(m_part[1])) {
+        m_telegrams++;
+        m_state = ss_syn;
+        if (m_sender >= 0) {
+          m_scheduled.push_back(SYN);
+        }
+        return;
+      }
+      m_part.clear();
+      m_crc = 0;
+      m_repeat = false;
+      m_state = ss_response;
+      if (m_targetVirtual) {
+        m_scheduled.insert(m_scheduled.end(), m_targetResponse.begin(), m_targetResponse.end());
+      }
+      return;
+    }
+    if (symbol == NAK) {
+      m_naks++;
+      if (!m_repeat) {
+        // the sending master repeats the command once
+        m_repeat = true;
+        m_part.clear();
+        m_crc = 0;
+        m_state = ss_command;
+        if (m_sender >= 0) {
+          const SimMaster& master = m_masters[m_sender];
+          m_scheduled.push_back(master.address);
+          m_scheduled.insert(m_scheduled.end(), master.command.begin(), master.command.end());
+        }
+        return;
+      }
+    }
+    m_state = ss_idle;
+    return;
+
+  case ss_response:
+    m_part.push_back(symbol);
+    if (m_part.size() >= 1u + m_part[0]) {
+      m_state = ss_responseCrc;
+    }
+    return;
+
+  case ss_responseCrc:
+    m_crcValid = symbol == m_crc;
+    m_state = ss_responseAck;
+    if (m_sender >= 0) {
+      bool nak = isNak(m_crcValid);
+      m_scheduled.push_back(nak ? NAK : ACK);
+      if (!nak || m_repeat) {
+        m_scheduled.push_back(SYN);
+      }
+    }
+    return;
+
+  case ss_responseAck:
+    if (symbol == ACK) {
+      m_telegrams++;
+      m_state = ss_syn;
+      return;
+    }
+    if (symbol == NAK) {
+      m_naks++;
+      if (!m_repeat) {
+        // the answering slave repeats the response once
+        m_repeat = true;
+        m_part.clear();
+        m_crc = 0;
+        m_state = ss_response;
+        if (m_targetVirtual) {
+          m_scheduled.insert(m_scheduled.end(), m_targetResponse.begin(), m_targetResponse.end());
+        }
+        return;
+      }
+    }
+    m_state = ss_idle;
+    return;
+
+  case ss_syn:
+    m_state = ss_idle;
+    return;
+  }
+}
+
+}  // namespace ebusd
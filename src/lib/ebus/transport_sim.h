@@ -0,0 +1,287 @@
+/*
+ * ebusd - daemon for communication with eBUS heating systems.
+ * Copyright (C) 2026 John Baier <ebusd@ebusd.eu>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_EBUS_TRANSPORT_SIM_H_
+#define LIB_EBUS_TRANSPORT_SIM_H_
+
+#include <deque>
+#include <map>
+#include <string>
+#include <vector>
+#include "lib/ebus/transport.h"
+
+namespace ebusd {
+
+using std::deque;
+using std::map;
+
+/** @file lib/ebus/transport_sim.h
+ * A @a Transport simulating an eBUS with virtual masters and slaves.
+ *
+ * The @a SimulatorTransport emulates the bus in real time one symbol slot
+ * after the other. Symbols written by ebusd and by the virtual participants
+ * in the same slot collide (wired AND, or bitwise arbitration in the first
+ * slot after SYN), the result is echoed back to ebusd. An AUTO-SYN is
+ * generated whenever the bus stays idle.
+ *
+ * The participants are defined in a profile file with one entry per line:
+ * - "master,QQ,ZZPBSBNNDD,RATE" for a virtual master QQ sending the command
+ *   ZZPBSBNNDD (hex) in random intervals RATE times per second on average,
+ * - "slave,ZZ[,LEN]" for a virtual slave ZZ answering with LEN zero data
+ *   bytes by default (0 if omitted),
+ * - "answer,ZZ,PBSBNNDD,DD" for the response data bytes (hex) of virtual
+ *   slave ZZ to commands starting with PBSBNNDD (hex),
+ * - "nak,PERCENT" for the percentage of ACKs replaced by a NAK by the
+ *   virtual participants,
+ * - "seed,N" for the seed of the random generator.
+ */
+
+/** the interval [ms] of bus time for reporting the simulator statistics. */
+#define SIMULATOR_STATS_MILLIS (60*1000)
+
+/**
+ * The @a Transport simulating an eBUS with virtual masters and slaves.
+ */
+class SimulatorTransport : public Transport {
+ public:
+  /**
+   * Construct a new instance.
+   * @param name the device name (e.g. "sim:/etc/ebusd/sim.csv").
+   * @param path the path to the profile file.
+   */
+  SimulatorTransport(const char* name, const char* path)
+    : Transport(name, HOST_LATENCY_MS), m_path(path), m_nakPercent(0), m_seed(1), m_opened(false),
+    m_busMillis(0), m_idleMillis(0), m_nextStatsMillis(0), m_state(ss_idle), m_firstSlot(false),
+    m_escape(false), m_repeat(false), m_crc(0), m_crcValid(false), m_sender(-1), m_targetVirtual(false),
+    m_slots(0), m_busySlots(0), m_collisions(0), m_telegrams(0), m_naks(0) {
+    m_startTime.tv_sec = 0;
+    m_startTime.tv_nsec = 0;
+  }
+
+  /**
+   * Destructor.
+   */
+  ~SimulatorTransport() override {
+    close();
+    if (m_path) {
+      free(const_cast<char*>(m_path));
+      m_path = nullptr;
+    }
+  }
+
+  // @copydoc
+  string getTransportInfo() const override;
+
+  // @copydoc
+  result_t open() override;
+
+  // @copydoc
+  void close() override;
+
+  // @copydoc
+  bool isValid() override { return m_opened; }
+
+  // @copydoc
+  result_t write(const uint8_t* data, size_t len) override;
+
+  // @copydoc
+  result_t read(unsigned int timeout, const uint8_t** data, size_t* len) override;
+
+  // @copydoc
+  void readConsumed(size_t len) override;
+
+
+ protected:
+  // @copydoc
+  result_t openInternal() override;
+
+
+ private:
+  /**
+   * The simulation state of the telegram currently on the bus.
+   */
+  enum SimState {
+    ss_idle,         //!< skipping until next SYN
+    ss_ready,        //!< SYN seen, ready for arbitration
+    ss_command,      //!< receiving the command
+    ss_commandCrc,   //!< receiving the command CRC
+    ss_commandAck,   //!< receiving the command ACK/NAK
+    ss_response,     //!< receiving the response
+    ss_responseCrc,  //!< receiving the response CRC
+    ss_responseAck,  //!< receiving the response ACK/NAK
+    ss_syn,          //!< waiting for the final SYN
+  };
+
+  /**
+   * A virtual master sending a command repeatedly.
+   */
+  struct SimMaster {
+    /** the master address. */
+    symbol_t address;
+
+    /** the escaped command to send after the master address including the CRC. */
+    vector<symbol_t> command;
+
+    /** the mean interval between two commands in milliseconds. */
+    double interval;
+
+    /** the bus time in milliseconds when the next command is due. */
+    double due;
+  };
+
+  /**
+   * A virtual slave answering commands.
+   */
+  struct SimSlave {
+    /** the escaped default response including the CRC. */
+    vector<symbol_t> response;
+
+    /** the command prefixes (starting with PB) and the escaped responses including the CRC. */
+    vector<std::pair<vector<symbol_t>, vector<symbol_t>>> answers;
+  };
+
+  /**
+   * Read the profile file.
+   * @param errorDescription a string in which to store the error description in case of error.
+   * @return the @a result_t code.
+   */
+  result_t readProfile(string* errorDescription);
+
+  /**
+   * Get the elapsed bus time since opening.
+   * @return the elapsed bus time in milliseconds.
+   */
+  double getElapsedBusMillis() const;
+
+  /**
+   * Get a random number.
+   * @return a random number between 0 (inclusive) and 1 (exclusive).
+   */
+  double getRandom();
+
+  /**
+   * Determine whether the virtual participant shall reply with a NAK.
+   * @param crcValid whether the CRC of the received part was valid.
+   * @return true for NAK, false for ACK.
+   */
+  bool isNak(bool crcValid);
+
+  /**
+   * Simulate all symbol slots passed until now.
+   */
+  void simulate();
+
+  /**
+   * Simulate a single symbol slot.
+   */
+  void simulateSlot();
+
+  /**
+   * Track a symbol seen on the bus and schedule the reply of the virtual participants.
+   * @param symbol the (escaped) symbol seen on the bus.
+   */
+  void track(symbol_t symbol);
+
+  /** the path to the profile file. */
+  const char* m_path;
+
+  /** the virtual masters. */
+  vector<SimMaster> m_masters;
+
+  /** the virtual slaves by address. */
+  map<symbol_t, SimSlave> m_slaves;
+
+  /** the percentage of ACKs replaced by a NAK. */
+  unsigned int m_nakPercent;
+
+  /** the state of the random generator. */
+  unsigned int m_seed;
+
+  /** whether the transport is opened. */
+  bool m_opened;
+
+  /** the system time when the simulation was started. */
+  struct timespec m_startTime;
+
+  /** the bus time in milliseconds of all simulated slots. */
+  double m_busMillis;
+
+  /** the bus time in milliseconds since the last symbol on the bus. */
+  double m_idleMillis;
+
+  /** the bus time in milliseconds for reporting the next statistics. */
+  double m_nextStatsMillis;
+
+  /** the symbols written by ebusd still to put on the bus. */
+  deque<symbol_t> m_written;
+
+  /** the symbols scheduled by the virtual participants to put on the bus. */
+  deque<symbol_t> m_scheduled;
+
+  /** the symbols seen on the bus not yet consumed by ebusd. */
+  vector<symbol_t> m_received;
+
+  /** the simulation state of the telegram currently on the bus. */
+  SimState m_state;
+
+  /** whether the next slot is the first one after SYN. */
+  bool m_firstSlot;
+
+  /** whether the previous symbol was the escape symbol. */
+  bool m_escape;
+
+  /** whether the current part is a repetition. */
+  bool m_repeat;
+
+  /** the CRC calculated of the current part. */
+  symbol_t m_crc;
+
+  /** whether the CRC of the last part was valid. */
+  bool m_crcValid;
+
+  /** the unescaped command or response currently on the bus. */
+  vector<symbol_t> m_part;
+
+  /** the index of the virtual master sending the current telegram, or -1. */
+  int m_sender;
+
+  /** whether the current telegram is sent to a virtual participant. */
+  bool m_targetVirtual;
+
+  /** the escaped response of the virtual slave to the current telegram including the CRC. */
+  vector<symbol_t> m_targetResponse;
+
+  /** the number of simulated slots. */
+  uint64_t m_slots;
+
+  /** the number of simulated slots carrying a symbol other than AUTO-SYN. */
+  uint64_t m_busySlots;
+
+  /** the number of collisions. */
+  unsigned int m_collisions;
+
+  /** the number of completed telegrams. */
+  unsigned int m_telegrams;
+
+  /** the number of NAKs seen. */
+  unsigned int m_naks;
+};
+
+}  // namespace ebusd
+
+#endif  // LIB_EBUS_TRANSPORT_SIM_H_
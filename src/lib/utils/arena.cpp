@@ -0,0 +1,118 @@
+/*
+ * ebusd - daemon for communication with eBUS heating systems.
+ * Copyright (C) 2026 John Baier <ebusd@ebusd.eu>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include <config.h>
+#endif
+
+#include "lib/utils/arena.h"
+#include <new>
+
+namespace ebusd {
+
+/** objects larger than this are always allocated from the heap. */
+#define ARENA_MAX_OBJECT_SIZE (ARENA_CHUNK_SIZE/8)
+
+/** the offset of the first object in a chunk. */
+#define ARENA_CHUNK_HEADER ((sizeof(arena_chunk_t) + ARENA_ALIGNMENT - 1) & ~static_cast<size_t>(ARENA_ALIGNMENT - 1))
+
+thread_local Arena* Arena::s_current = nullptr;
+
+void Arena::close() {
+  arena_chunk_t* chunk = m_chunk;
+  m_chunk = nullptr;
+  m_chunkPos = nullptr;
+  m_chunkFree = 0;
+  if (chunk) {
+    releaseChunk(chunk);
+  }
+}
+
+void Arena::detach() {
+  close();
+  release();
+}
+
+void* Arena::allocate(size_t size) {
+  size = (size + ARENA_ALIGNMENT - 1) & ~static_cast<size_t>(ARENA_ALIGNMENT - 1);
+  Arena* arena = s_current;
+  char* mem;
+  arena_chunk_t* chunk = nullptr;
+  if (arena && size <= ARENA_MAX_OBJECT_SIZE) {
+    mem = arena->allocateChunked(ARENA_ALIGNMENT + size);
+    chunk = arena->m_chunk;
+  } else {
+    mem = static_cast<char*>(::operator new(ARENA_ALIGNMENT + size));
+  }
+  *reinterpret_cast<arena_chunk_t**>(mem) = chunk;
+  return mem + ARENA_ALIGNMENT;
+}
+
+void Arena::deallocate(void* ptr) {
+  if (!ptr) {
+    return;
+  }
+  char* mem = static_cast<char*>(ptr) - ARENA_ALIGNMENT;
+  arena_chunk_t* chunk = *reinterpret_cast<arena_chunk_t**>(mem);
+  if (chunk) {
+    chunk->arena->m_liveCount--;  // still referenced by the chunk
+    releaseChunk(chunk);
+  } else {
+    ::operator delete(mem);
+  }
+}
+
+char* Arena::allocateChunked(size_t size) {
+  if (size > m_chunkFree) {
+    char* data = static_cast<char*>(::operator new(ARENA_CHUNK_SIZE));
+    close();
+    arena_chunk_t* chunk = new (data) arena_chunk_t();
+    chunk->arena = this;
+    chunk->references = 1;  // while being filled
+    m_references++;
+    m_chunkCount++;
+    m_chunk = chunk;
+    m_chunkPos = data + ARENA_CHUNK_HEADER;
+    m_chunkFree = ARENA_CHUNK_SIZE - ARENA_CHUNK_HEADER;
+  }
+  char* mem = m_chunkPos;
+  m_chunkPos += size;
+  m_chunkFree -= size;
+  m_chunk->references++;
+  m_liveCount++;
+  return mem;
+}
+
+void Arena::releaseChunk(arena_chunk_t* chunk) {
+  if (--chunk->references != 0) {
+    return;
+  }
+  Arena* arena = chunk->arena;
+  chunk->~arena_chunk_t();
+  ::operator delete(chunk);
+  arena->m_chunkCount--;
+  arena->release();
+}
+
+void Arena::release() {
+  if (--m_references == 0) {
+    delete this;
+  }
+}
+
+}  // namespace ebusd
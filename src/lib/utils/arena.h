@@ -0,0 +1,200 @@
+/*
+ * ebusd - daemon for communication with eBUS heating systems.
+ * Copyright (C) 2026 John Baier <ebusd@ebusd.eu>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_UTILS_ARENA_H_
+#define LIB_UTILS_ARENA_H_
+
+#include <atomic>
+#include <cstddef>
+
+namespace ebusd {
+
+/** \file lib/utils/arena.h */
+
+using std::atomic;
+
+/** the size of each chunk allocated by an @a Arena. */
+#define ARENA_CHUNK_SIZE (64*1024)
+
+/** the alignment of objects allocated by an @a Arena (also the size of the header in front of each object). */
+#define ARENA_ALIGNMENT 16
+
+class Arena;
+
+/**
+ * The header at the start of each chunk allocated by an @a Arena.
+ */
+typedef struct arena_chunk {
+  Arena* arena;                //!< the owning @a Arena
+  atomic<size_t> references;   //!< the number of objects allocated from the chunk plus one while being filled
+} arena_chunk_t;
+
+/**
+ * A lock free bump allocator for objects living about equally long (like the definitions loaded from a file).
+ * Objects are allocated from large chunks while the @a Arena is active for the current thread (see @a ArenaScope).
+ * Only a single thread may allocate from an @a Arena at a time, while the objects may be freed by any thread. Each
+ * chunk is released as a whole as soon as it is no longer filled (see @a close()) and the last object allocated
+ * from it was deleted.
+ */
+class Arena {
+ public:
+  /**
+   * Constructor.
+   */
+  Arena() : m_references(1), m_liveCount(0), m_chunkCount(0), m_chunk(nullptr), m_chunkPos(nullptr),
+    m_chunkFree(0) {}
+
+
+ private:
+  /**
+   * Destructor (see @a detach()).
+   */
+  ~Arena() {}
+
+  /**
+   * Hidden copy constructor.
+   * @param src the object to copy from.
+   */
+  Arena(const Arena& src);
+
+
+ public:
+  /**
+   * Stop filling the current chunk, so that it is released together with the last object allocated from it.
+   * This is meant to be called once all objects of a load were freed and no allocation is in progress.
+   */
+  void close();
+
+  /**
+   * Detach the owner from this instance (closing it). It is deleted as soon as no more objects are allocated
+   * from it.
+   */
+  void detach();
+
+  /**
+   * Allocate memory for an object from the @a Arena active for the current thread, or from the heap if none is
+   * active.
+   * @param size the size of the object.
+   * @return the allocated memory.
+   */
+  static void* allocate(size_t size);
+
+  /**
+   * Free the memory of an object allocated by @a allocate().
+   * @param ptr the memory returned by @a allocate().
+   */
+  static void deallocate(void* ptr);
+
+  /**
+   * @return the number of objects currently allocated from this instance.
+   */
+  size_t getLiveCount() const { return m_liveCount.load(); }
+
+  /**
+   * @return the number of chunks currently allocated by this instance.
+   */
+  size_t getChunkCount() const { return m_chunkCount.load(); }
+
+
+ private:
+  friend class ArenaScope;
+
+  /**
+   * Allocate memory for an object including the header.
+   * @param size the size of the object including the header.
+   * @return the allocated memory.
+   */
+  char* allocateChunked(size_t size);
+
+  /**
+   * Remove a reference from a chunk and free it when it is no longer referenced.
+   * @param chunk the @a arena_chunk_t to release.
+   */
+  static void releaseChunk(arena_chunk_t* chunk);
+
+  /**
+   * Remove a reference from this instance and delete it when it is no longer referenced.
+   */
+  void release();
+
+  /** the @a Arena active for the current thread, or nullptr. */
+  static thread_local Arena* s_current;
+
+  /** the number of references to this instance by the owner and the allocated chunks. */
+  atomic<size_t> m_references;
+
+  /** the number of objects currently allocated. */
+  atomic<size_t> m_liveCount;
+
+  /** the number of chunks currently allocated. */
+  atomic<size_t> m_chunkCount;
+
+  /** the chunk currently being filled, or nullptr (only used by the allocating thread). */
+  arena_chunk_t* m_chunk;
+
+  /** the next free position in @a m_chunk. */
+  char* m_chunkPos;
+
+  /** the number of free bytes in @a m_chunk. */
+  size_t m_chunkFree;
+};
+
+/**
+ * Activates an @a Arena for the current thread during its lifetime.
+ */
+class ArenaScope {
+ public:
+  /**
+   * Constructor.
+   * @param arena the @a Arena to activate, or nullptr to allocate from the heap.
+   */
+  explicit ArenaScope(Arena* arena) : m_previous(Arena::s_current) { Arena::s_current = arena; }
+
+  /**
+   * Destructor.
+   */
+  ~ArenaScope() { Arena::s_current = m_previous; }
+
+
+ private:
+  /** the previously active @a Arena. */
+  Arena* m_previous;
+};
+
+/**
+ * Base class for objects to be allocated from the active @a Arena.
+ */
+class ArenaObject {
+ public:
+  /**
+   * Allocate memory for an instance.
+   * @param size the size of the instance.
+   * @return the allocated memory.
+   */
+  static void* operator new(size_t size) { return Arena::allocate(size); }
+
+  /**
+   * Free the memory of an instance.
+   * @param ptr the memory of the instance.
+   */
+  static void operator delete(void* ptr) { Arena::deallocate(ptr); }
+};
+
+}  // namespace ebusd
+
+#endif  // LIB_UTILS_ARENA_H_
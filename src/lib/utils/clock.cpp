@@ -50,4 +50,10 @@ uint64_t clockGetMillis() {
   return t.tv_sec*1000LL + t.tv_nsec / 1000000;
 }
 
+uint64_t clockGetMicros() {
+  struct timespec t;
+  clockGettime(&t);
+  return t.tv_sec*1000000LL + t.tv_nsec / 1000;
+}
+
 }  // namespace ebusd
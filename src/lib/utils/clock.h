@@ -37,6 +37,11 @@ void clockGettime(struct timespec* t);
  */
 uint64_t clockGetMillis();
 
+/**
+ * Get the current system time in microseconds since the Epoch.
+ */
+uint64_t clockGetMicros();
+
 }  // namespace ebusd
 
 #endif  // LIB_UTILS_CLOCK_H_
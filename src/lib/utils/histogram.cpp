@@ -0,0 +1,111 @@
+/*
+ * ebusd - daemon for communication with eBUS heating systems.
+ * Copyright (C) 2026 John Baier <ebusd@ebusd.eu>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include <config.h>
+#endif
+
+#include "lib/utils/histogram.h"
+#include <cstring>
+
+namespace ebusd {
+
+size_t Histogram::getBucket(uint64_t value) {
+  if (value < HISTOGRAM_SUB_COUNT) {
+    return static_cast<size_t>(value);  // exact
+  }
+  unsigned int msb = 63 - static_cast<unsigned int>(__builtin_clzll(value));
+  unsigned int shift = msb - HISTOGRAM_SUB_BITS;
+  size_t bucket = ((shift + 1) << HISTOGRAM_SUB_BITS) + ((value >> shift) & (HISTOGRAM_SUB_COUNT - 1));
+  return bucket < HISTOGRAM_BUCKETS ? bucket : HISTOGRAM_BUCKETS - 1;
+}
+
+uint64_t Histogram::getBucketMax(size_t bucket) {
+  if (bucket < HISTOGRAM_SUB_COUNT) {
+    return bucket;
+  }
+  size_t shift = (bucket >> HISTOGRAM_SUB_BITS) - 1;
+  uint64_t lower = static_cast<uint64_t>(HISTOGRAM_SUB_COUNT + (bucket & (HISTOGRAM_SUB_COUNT - 1))) << shift;
+  return lower + (1ULL << shift) - 1;
+}
+
+void Histogram::add(uint64_t value) {
+  size_t bucket = getBucket(value);
+  m_mutex.lock();
+  m_buckets[bucket]++;
+  m_count++;
+  if (value > m_max) {
+    m_max = value;
+  }
+  m_mutex.unlock();
+}
+
+void Histogram::reset() {
+  m_mutex.lock();
+  memset(m_buckets, 0, sizeof(m_buckets));
+  m_count = 0;
+  m_max = 0;
+  m_mutex.unlock();
+}
+
+uint64_t Histogram::getPercentile(unsigned int percent) const {
+  uint64_t rank = (m_count * percent + 99) / 100;  // nearest rank
+  uint64_t seen = 0;
+  for (size_t bucket = 0; bucket < HISTOGRAM_BUCKETS; bucket++) {
+    seen += m_buckets[bucket];
+    if (seen >= rank) {
+      uint64_t value = getBucketMax(bucket);
+      return value < m_max ? value : m_max;
+    }
+  }
+  return m_max;
+}
+
+void Histogram::getSummary(histogram_summary_t* summary, bool reset) {
+  m_mutex.lock();
+  summary->count = m_count;
+  if (m_count == 0) {
+    summary->p50 = summary->p90 = summary->p99 = summary->max = 0;
+  } else {
+    summary->p50 = getPercentile(50);
+    summary->p90 = getPercentile(90);
+    summary->p99 = getPercentile(99);
+    summary->max = m_max;
+  }
+  if (reset) {
+    this->reset();
+  }
+  m_mutex.unlock();
+}
+
+void Histogram::format(ostringstream* output, bool json, bool reset) {
+  histogram_summary_t summary;
+  getSummary(&summary, reset);
+  if (json) {
+    *output << "{\"count\":" << summary.count << ",\"p50\":" << summary.p50 << ",\"p90\":" << summary.p90
+            << ",\"p99\":" << summary.p99 << ",\"max\":" << summary.max << "}";
+    return;
+  }
+  *output << summary.count;
+  if (summary.count > 0) {
+    *output << ", p50 " << summary.p50 << ", p90 " << summary.p90 << ", p99 " << summary.p99
+            << ", max " << summary.max;
+  }
+}
+
+}  // namespace ebusd
@@ -0,0 +1,141 @@
+/*
+ * ebusd - daemon for communication with eBUS heating systems.
+ * Copyright (C) 2026 John Baier <ebusd@ebusd.eu>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_UTILS_HISTOGRAM_H_
+#define LIB_UTILS_HISTOGRAM_H_
+
+#include <stdint.h>
+#include <sstream>
+#include "lib/utils/thread.h"
+
+namespace ebusd {
+
+/** \file lib/utils/histogram.h */
+
+using std::ostringstream;
+
+/** the number of bits for the sub buckets within each power of two (i.e. a precision of 1/8). */
+#define HISTOGRAM_SUB_BITS 3
+
+/** the number of sub buckets within each power of two. */
+#define HISTOGRAM_SUB_COUNT (1 << HISTOGRAM_SUB_BITS)
+
+/** the number of buckets for covering values up to 2^32 (larger ones are counted in the last bucket). */
+#define HISTOGRAM_BUCKETS ((32 - HISTOGRAM_SUB_BITS + 1) * HISTOGRAM_SUB_COUNT)
+
+/**
+ * The summary of a @a Histogram.
+ */
+typedef struct histogram_summary {
+  uint64_t count;  //!< the number of values
+  uint64_t p50;    //!< the 50th percentile
+  uint64_t p90;    //!< the 90th percentile
+  uint64_t p99;    //!< the 99th percentile
+  uint64_t max;    //!< the maximum value
+} histogram_summary_t;
+
+/**
+ * A thread safe histogram of values with logarithmic buckets (HDR style), i.e. with constant relative precision.
+ */
+class Histogram {
+ public:
+  /**
+   * Constructor.
+   */
+  Histogram() { reset(); }
+
+  /**
+   * Destructor.
+   */
+  ~Histogram() {}
+
+
+ private:
+  /**
+   * Hidden copy constructor.
+   * @param src the object to copy from.
+   */
+  Histogram(const Histogram& src);
+
+
+ public:
+  /**
+   * Add a value.
+   * @param value the value to add.
+   */
+  void add(uint64_t value);
+
+  /**
+   * Remove all values.
+   */
+  void reset();
+
+  /**
+   * Get the summary of the values.
+   * @param summary the @a histogram_summary_t to fill.
+   * @param reset whether to remove all values afterwards.
+   */
+  void getSummary(histogram_summary_t* summary, bool reset = false);
+
+  /**
+   * Format the summary of the values.
+   * @param output the @a ostringstream to append the summary to.
+   * @param json true for a JSON object, false for text.
+   * @param reset whether to remove all values afterwards.
+   */
+  void format(ostringstream* output, bool json, bool reset = false);
+
+  /**
+   * Get the bucket index for the value.
+   * @param value the value.
+   * @return the bucket index.
+   */
+  static size_t getBucket(uint64_t value);
+
+  /**
+   * Get the highest value counted in the bucket.
+   * @param bucket the bucket index.
+   * @return the highest value counted in the bucket.
+   */
+  static uint64_t getBucketMax(size_t bucket);
+
+
+ private:
+  /**
+   * Get the value at the percentile (with @a m_mutex being locked).
+   * @param percent the percentile.
+   * @return the value at the percentile.
+   */
+  uint64_t getPercentile(unsigned int percent) const;
+
+  /** the @a Mutex for all members. */
+  Mutex m_mutex;
+
+  /** the number of values in each bucket. */
+  uint32_t m_buckets[HISTOGRAM_BUCKETS];
+
+  /** the number of values. */
+  uint64_t m_count;
+
+  /** the maximum value. */
+  uint64_t m_max;
+};
+
+}  // namespace ebusd
+
+#endif  // LIB_UTILS_HISTOGRAM_H_
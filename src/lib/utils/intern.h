@@ -0,0 +1,204 @@
+/*
+ * ebusd - daemon for communication with eBUS heating systems.
+ * Copyright (C) 2026 John Baier <ebusd@ebusd.eu>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIB_UTILS_INTERN_H_
+#define LIB_UTILS_INTERN_H_
+
+#include <atomic>
+#include <map>
+#include "lib/utils/thread.h"
+
+namespace ebusd {
+
+/** \file lib/utils/intern.h */
+
+using std::atomic;
+using std::map;
+
+/**
+ * The statistics of an @a InternPool.
+ */
+typedef struct intern_stats {
+  size_t entries;     //!< the number of distinct values
+  size_t references;  //!< the number of references to the values
+  size_t bytes;       //!< the estimated number of bytes used by the distinct values
+  size_t savedBytes;  //!< the estimated number of bytes saved by sharing the values
+} intern_stats_t;
+
+/**
+ * Thread safe template class for sharing equal immutable values (flyweights) with reference counting.
+ * The returned entries carry their own reference count, so that adding and removing a reference does not need to
+ * look up the value again. The empty value is shared as fixed entry without any locking or reference counting.
+ * @param T the value type (needs to be less-than comparable, copy constructible, and have an empty() method).
+ */
+template <typename T>
+class InternPool {
+ public:
+  /** the shared value together with the number of references to it. */
+  struct entry_t;
+
+  /** compares the values behind the pointers. */
+  struct less_value_t {
+    bool operator()(const T* a, const T* b) const { return *a < *b; }
+  };
+
+  /** the shared values by pointer to the value in the @a entry_t. */
+  typedef map<const T*, entry_t*, less_value_t> entries_t;
+
+  struct entry_t {
+    /**
+     * Constructor.
+     * @param value the value to share.
+     */
+    explicit entry_t(const T& value) : value(value), references(0) {}
+
+    /** the shared value. */
+    const T value;
+
+    /** the number of references to the value. */
+    atomic<size_t> references;
+
+    /** the position in @a m_entries for removing the entry without looking it up again. */
+    typename entries_t::iterator position;
+  };
+
+  /**
+   * Constructor.
+   * @param getSize the function for estimating the number of bytes used by a value.
+   */
+  explicit InternPool(size_t (*getSize)(const T& value)) : m_empty(T()), m_getSize(getSize) {}
+
+  /**
+   * Destructor.
+   */
+  ~InternPool() {
+    for (const auto& it : m_entries) {
+      delete it.second;
+    }
+  }
+
+
+ private:
+  /**
+   * Hidden copy constructor.
+   * @param src the object to copy from.
+   */
+  InternPool(const InternPool& src);
+
+
+ public:
+  /**
+   * Get the shared entry equal to the value and add a reference to it.
+   * @param value the value to share.
+   * @return the shared entry (to be released via @a release()).
+   */
+  entry_t* acquire(const T& value) {
+    if (value.empty()) {
+      return &m_empty;
+    }
+    m_mutex.lock();
+    entry_t* entry;
+    auto it = m_entries.find(&value);
+    if (it == m_entries.end()) {
+      entry = new entry_t(value);
+      entry->position = m_entries.emplace(&entry->value, entry).first;
+    } else {
+      entry = it->second;
+    }
+    entry->references++;
+    m_mutex.unlock();
+    return entry;
+  }
+
+  /**
+   * Get the shared entry of the empty value (without the need for releasing it).
+   * @return the shared entry of the empty value.
+   */
+  entry_t* getEmpty() { return &m_empty; }
+
+  /**
+   * Add a reference to an already shared entry.
+   * @param entry the shared entry returned by @a acquire().
+   * @return the same shared entry (to be released via @a release()).
+   */
+  entry_t* acquire(entry_t* entry) {
+    if (entry != &m_empty) {
+      entry->references++;  // can not be freed in the meantime as the caller holds a reference
+    }
+    return entry;
+  }
+
+  /**
+   * Remove a reference to a shared entry and free it when it is no longer referenced.
+   * @param entry the shared entry returned by @a acquire().
+   */
+  void release(entry_t* entry) {
+    if (entry == &m_empty) {
+      return;
+    }
+    size_t references = entry->references.load();
+    while (references > 1) {
+      if (entry->references.compare_exchange_weak(references, references - 1)) {
+        return;  // not the last reference
+      }
+    }
+    // possibly the last reference: decide under the lock as acquire() might add one in the meantime
+    m_mutex.lock();
+    if (--entry->references == 0) {
+      m_entries.erase(entry->position);
+      delete entry;
+    }
+    m_mutex.unlock();
+  }
+
+  /**
+   * Get the statistics (not including the empty value).
+   * @param stats the @a intern_stats_t to fill.
+   */
+  void getStats(intern_stats_t* stats) {
+    stats->entries = stats->references = stats->bytes = stats->savedBytes = 0;
+    m_mutex.lock();
+    for (const auto& it : m_entries) {
+      size_t size = m_getSize(*it.first);
+      size_t references = it.second->references.load();
+      stats->entries++;
+      stats->references += references;
+      stats->bytes += size;
+      stats->savedBytes += (references - 1) * size;
+    }
+    m_mutex.unlock();
+  }
+
+
+ private:
+  /** the @a Mutex for @a m_entries and the last reference of each entry. */
+  Mutex m_mutex;
+
+  /** the shared empty value. */
+  entry_t m_empty;
+
+  /** the shared values. */
+  entries_t m_entries;
+
+  /** the function for estimating the number of bytes used by a value. */
+  size_t (*m_getSize)(const T& value);
+};
+
+}  // namespace ebusd
+
+#endif  // LIB_UTILS_INTERN_H_
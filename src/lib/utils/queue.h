@@ -161,6 +161,159 @@ class Queue {
   pthread_cond_t m_cond;
 };
 
+
+/**
+ * Thread safe bounded ring buffer for handing over items from multiple producers to a single consumer.
+ * In contrast to @a Queue, a waiting thread is only woken up when there is something for it to do: the consumer
+ * when an item was added, and a single producer when a slot was freed up.
+ * @param T the item type.
+ */
+template <typename T>
+class RingQueue {
+ public:
+  /**
+   * Constructor.
+   * @param capacity the maximum number of queued items.
+   */
+  explicit RingQueue(size_t capacity)
+    : m_items(new T[capacity > 0 ? capacity : 1]), m_capacity(capacity > 0 ? capacity : 1), m_head(0), m_size(0),
+      m_waitingConsumers(0), m_waitingProducers(0), m_wakeups(0) {
+    pthread_mutex_init(&m_mutex, nullptr);
+    pthread_cond_init(&m_notEmpty, nullptr);
+    pthread_cond_init(&m_notFull, nullptr);
+  }
+
+  /**
+   * Destructor.
+   */
+  ~RingQueue() {
+    pthread_mutex_destroy(&m_mutex);
+    pthread_cond_destroy(&m_notEmpty);
+    pthread_cond_destroy(&m_notFull);
+    delete[] m_items;
+  }
+
+
+ private:
+  /**
+   * Hidden copy constructor.
+   * @param src the object to copy from.
+   */
+  RingQueue(const RingQueue& src);
+
+
+ public:
+  /**
+   * Add an item to the end of queue waiting for a free slot if the queue is full.
+   * @param item the item to add, or nullptr for notifying the consumer only.
+   */
+  void push(T item) {
+    pthread_mutex_lock(&m_mutex);
+    if (item) {
+      while (m_size == m_capacity) {
+        m_waitingProducers++;
+        pthread_cond_wait(&m_notFull, &m_mutex);
+        m_waitingProducers--;
+      }
+      m_items[(m_head + m_size) % m_capacity] = item;
+      m_size++;
+    }
+    if (m_waitingConsumers > 0) {
+      m_wakeups++;
+      pthread_cond_signal(&m_notEmpty);
+    }
+    pthread_mutex_unlock(&m_mutex);
+  }
+
+  /**
+   * Remove the first item from the queue optionally waiting for the queue being non-empty.
+   * @param timeout the maximum time in seconds to wait for the queue being filled, or 0 for no wait.
+   * @return the item, or nullptr if no item is available within the specified time.
+   */
+  T pop(int timeout = 0) {
+    T item;
+    pthread_mutex_lock(&m_mutex);
+    if (timeout > 0 && m_size == 0) {
+      struct timespec t;
+      clockGettime(&t);
+      t.tv_sec += timeout;
+      m_waitingConsumers++;
+      pthread_cond_timedwait(&m_notEmpty, &m_mutex, &t);
+      m_waitingConsumers--;
+    }
+    if (m_size == 0) {
+      item = nullptr;
+    } else {
+      item = m_items[m_head];
+      m_head = (m_head + 1) % m_capacity;
+      m_size--;
+      if (m_waitingProducers > 0) {
+        m_wakeups++;
+        pthread_cond_signal(&m_notFull);
+      }
+    }
+    pthread_mutex_unlock(&m_mutex);
+    return item;
+  }
+
+  /**
+   * @return the number of queued items.
+   */
+  size_t size() {
+    pthread_mutex_lock(&m_mutex);
+    size_t size = m_size;
+    pthread_mutex_unlock(&m_mutex);
+    return size;
+  }
+
+  /**
+   * @return the maximum number of queued items.
+   */
+  size_t getCapacity() const { return m_capacity; }
+
+  /**
+   * @return the number of times a waiting thread was woken up.
+   */
+  size_t getWakeups() {
+    pthread_mutex_lock(&m_mutex);
+    size_t wakeups = m_wakeups;
+    pthread_mutex_unlock(&m_mutex);
+    return wakeups;
+  }
+
+
+ private:
+  /** the ring buffer of queued items. */
+  T* m_items;
+
+  /** the maximum number of queued items. */
+  const size_t m_capacity;
+
+  /** the index of the first queued item. */
+  size_t m_head;
+
+  /** the number of queued items. */
+  size_t m_size;
+
+  /** the number of consumers waiting for an item. */
+  unsigned int m_waitingConsumers;
+
+  /** the number of producers waiting for a free slot. */
+  unsigned int m_waitingProducers;
+
+  /** the number of times a waiting thread was woken up. */
+  size_t m_wakeups;
+
+  /** mutex variable for exclusive lock */
+  pthread_mutex_t m_mutex;
+
+  /** condition variable for waiting for an item. */
+  pthread_cond_t m_notEmpty;
+
+  /** condition variable for waiting for a free slot. */
+  pthread_cond_t m_notFull;
+};
+
 }  // namespace ebusd
 
 #endif  // LIB_UTILS_QUEUE_H_
@@ -147,4 +147,52 @@ bool NotifiableThread::waitNotified(int millis) {
   return notified;
 }
 
+
+Completion::Completion()
+  : m_completed(false) {
+  pthread_mutex_init(&m_mutex, nullptr);
+  pthread_cond_init(&m_cond, nullptr);
+}
+
+Completion::~Completion() {
+  pthread_mutex_destroy(&m_mutex);
+  pthread_cond_destroy(&m_cond);
+}
+
+void Completion::reset() {
+  pthread_mutex_lock(&m_mutex);
+  m_completed = false;
+  pthread_mutex_unlock(&m_mutex);
+}
+
+void Completion::complete() {
+  pthread_mutex_lock(&m_mutex);
+  m_completed = true;
+  pthread_cond_signal(&m_cond);
+  pthread_mutex_unlock(&m_mutex);
+}
+
+bool Completion::wait(int millis) {
+  pthread_mutex_lock(&m_mutex);
+  struct timespec t;
+  if (millis > 0) {
+    clockGettime(&t);
+    t.tv_sec += millis / 1000;
+    t.tv_nsec += (millis % 1000) * 1000000;
+    if (t.tv_nsec >= 1000000000) {
+      t.tv_sec += t.tv_nsec / 1000000000;
+      t.tv_nsec %= 1000000000;
+    }
+  }
+  while (!m_completed) {
+    int ret = millis > 0 ? pthread_cond_timedwait(&m_cond, &m_mutex, &t) : pthread_cond_wait(&m_cond, &m_mutex);
+    if (ret != 0) {
+      break;
+    }
+  }
+  bool completed = m_completed;
+  pthread_mutex_unlock(&m_mutex);
+  return completed;
+}
+
 }  // namespace ebusd
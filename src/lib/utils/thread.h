@@ -173,6 +173,57 @@ class NotifiableThread : public WaitThread {
 };
 
 
+/**
+ * A one-shot completion signal handed from the finishing thread to the single thread waiting for it.
+ */
+class Completion {
+ public:
+  /**
+   * Constructor.
+   */
+  Completion();
+
+  /**
+   * Destructor.
+   */
+  ~Completion();
+
+  /**
+   * Reset to not completed before handing over the item to be completed.
+   */
+  void reset();
+
+  /**
+   * Mark as completed and wake up the waiting thread (if any).
+   */
+  void complete();
+
+  /**
+   * Wait for getting completed.
+   * @param millis the maximum number of milliseconds to wait, or 0 for waiting without limit.
+   * @return true if completed, false on timeout.
+   */
+  bool wait(int millis = 0);
+
+
+ private:
+  /**
+   * Hidden copy constructor.
+   * @param src the object to copy from.
+   */
+  Completion(const Completion& src);
+
+  /** the mutex for waiting. */
+  pthread_mutex_t m_mutex;
+
+  /** the condition for waiting. */
+  pthread_cond_t m_cond;
+
+  /** whether @a complete() was called since the last @a reset(). */
+  bool m_completed;
+};
+
+
 /**
  * A simple mutex.
  */